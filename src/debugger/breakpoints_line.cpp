@@ -31,7 +31,7 @@ void LineBreakpoints::DeleteAll()
     m_breakpointsMutex.unlock();
 }
 
-HRESULT LineBreakpoints::CheckBreakpointHit(ICorDebugThread *pThread, ICorDebugBreakpoint *pBreakpoint, Breakpoint &breakpoint)
+HRESULT LineBreakpoints::CheckBreakpointHit(ICorDebugThread *pThread, ICorDebugBreakpoint *pBreakpoint, Breakpoint &breakpoint, SnapshotOptions &snapshot)
 {
     HRESULT Status;
     ToRelease<ICorDebugFunctionBreakpoint> pFunctionBreakpoint;
@@ -79,6 +79,7 @@ HRESULT LineBreakpoints::CheckBreakpointHit(ICorDebugThread *pThread, ICorDebugB
 
             ++b.times;
             b.ToBreakpoint(breakpoint, sp.document);
+            snapshot = b.snapshot;
             return S_OK;
         }
     }
@@ -231,6 +232,7 @@ HRESULT LineBreakpoints::ManagedCallbackLoadModule(ICorDebugModule *pModule, std
             bp.linenum = initialBreakpoint.breakpoint.line;
             bp.endLine = initialBreakpoint.breakpoint.line;
             bp.condition = initialBreakpoint.breakpoint.condition;
+            bp.snapshot = initialBreakpoint.breakpoint.snapshot;
             unsigned resolved_fullname_index = 0;
             std::vector<ModulesSources::resolved_bp_t> resolvedPoints;
 
@@ -353,6 +355,7 @@ HRESULT LineBreakpoints::SetLineBreakpoints(bool haveProcess, const std::string&
             bp.linenum = line;
             bp.endLine = line;
             bp.condition = initialBreakpoint.breakpoint.condition;
+            bp.snapshot = initialBreakpoint.breakpoint.snapshot;
             unsigned resolved_fullname_index = 0;
             std::vector<ModulesSources::resolved_bp_t> resolvedPoints;
 
@@ -383,6 +386,7 @@ HRESULT LineBreakpoints::SetLineBreakpoints(bool haveProcess, const std::string&
         {
             ManagedLineBreakpointMapping &initialBreakpoint = *b->second;
             initialBreakpoint.breakpoint.condition = sb.condition;
+            initialBreakpoint.breakpoint.snapshot = sb.snapshot;
 
             if (initialBreakpoint.resolved_linenum)
             {
@@ -401,6 +405,7 @@ HRESULT LineBreakpoints::SetLineBreakpoints(bool haveProcess, const std::string&
 
                     // Existing breakpoint
                     bp.condition = initialBreakpoint.breakpoint.condition;
+                    bp.snapshot = initialBreakpoint.breakpoint.snapshot;
                     std::string resolved_fullname;
                     m_sharedModules->GetSourceFullPathByIndex(initialBreakpoint.resolved_fullname_index, resolved_fullname);
                     bp.ToBreakpoint(breakpoint, resolved_fullname);
@@ -416,6 +421,7 @@ HRESULT LineBreakpoints::SetLineBreakpoints(bool haveProcess, const std::string&
                 bp.linenum = line;
                 bp.endLine = line;
                 bp.condition = initialBreakpoint.breakpoint.condition;
+                bp.snapshot = initialBreakpoint.breakpoint.snapshot;
                 bp.ToBreakpoint(breakpoint, filename);
                 if (!haveProcess)
                     breakpoint.message = "The breakpoint is pending and will be resolved when debugging starts.";
@@ -478,6 +484,7 @@ HRESULT LineBreakpoints::UpdateBreakpointsOnHotReload(ICorDebugModule *pModule,
             bp.linenum = initialBreakpoint.breakpoint.line;
             bp.endLine = initialBreakpoint.breakpoint.line;
             bp.condition = initialBreakpoint.breakpoint.condition;
+            bp.snapshot = initialBreakpoint.breakpoint.snapshot;
             unsigned resolved_fullname_index = 0;
             Breakpoint breakpoint;
             std::vector<ModulesSources::resolved_bp_t> resolvedPoints;
@@ -84,7 +84,7 @@ HRESULT IsEnableByCondition(const std::string &condition, Variables *pVariables,
 
         Variable variable;
         std::string output;
-        IfFailRet(pVariables->Evaluate(iCorProcess, frameId, condition, variable, output));
+        IfFailRet(pVariables->Evaluate(iCorProcess, frameId, condition, variable, output, false, true));
 
         if (variable.type != "bool" || variable.value != "true")
             return E_FAIL;
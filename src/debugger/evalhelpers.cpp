@@ -4,6 +4,7 @@
 
 #include <vector>
 #include <algorithm>
+#include <cstdlib>
 #include "debugger/evalhelpers.h"
 #include "debugger/evalwaiter.h"
 #include "debugger/evalutils.h"
@@ -11,10 +12,18 @@
 #include "metadata/modules.h"
 #include "metadata/typeprinter.h"
 #include "valueprint.h"
+#include "utils/logger.h"
 
 namespace netcoredbg
 {
 
+EvalHelpers::EvalHelpers(std::shared_ptr<Modules> &sharedModules,
+                         std::shared_ptr<EvalWaiter> &sharedEvalWaiter) :
+    m_sharedModules(sharedModules),
+    m_sharedEvalWaiter(sharedEvalWaiter),
+    m_typeObjectCacheCapacity(m_typeObjectCacheDefaultCapacity)
+{}
+
 void EvalHelpers::Cleanup()
 {
     m_pSuppressFinalizeMutex.lock();
@@ -23,8 +32,167 @@ void EvalHelpers::Cleanup()
     m_pSuppressFinalizeMutex.unlock();
 
     m_typeObjectCacheMutex.lock();
+    LOGI("Type object cache stats: hits %llu, misses %llu, evictions %llu",
+         (unsigned long long)m_typeObjectCacheStats.hits,
+         (unsigned long long)m_typeObjectCacheStats.misses,
+         (unsigned long long)m_typeObjectCacheStats.evictions);
+    m_typeObjectCacheIndex.clear();
     m_typeObjectCache.clear();
+    m_typeObjectCacheStats = TypeObjectCacheStats();
     m_typeObjectCacheMutex.unlock();
+
+    InvalidateTypeMembersCache();
+    InvalidateTypeLayoutCache();
+}
+
+std::shared_ptr<EvalHelpers::TypeMembers> EvalHelpers::GetTypeMembersFromCache(CORDB_ADDRESS modAddress, mdTypeDef typeDef)
+{
+    std::lock_guard<std::mutex> lock(m_typeMembersCacheMutex);
+    auto find = m_typeMembersCache.find(std::make_pair(modAddress, typeDef));
+    return find == m_typeMembersCache.end() ? nullptr : find->second;
+}
+
+void EvalHelpers::AddTypeMembersToCache(CORDB_ADDRESS modAddress, mdTypeDef typeDef, std::shared_ptr<TypeMembers> &typeMembers)
+{
+    std::lock_guard<std::mutex> lock(m_typeMembersCacheMutex);
+    m_typeMembersCache[std::make_pair(modAddress, typeDef)] = typeMembers;
+}
+
+void EvalHelpers::InvalidateTypeMembersCache()
+{
+    m_typeMembersCacheMutex.lock();
+    m_typeMembersCache.clear();
+    m_typeMembersCacheMutex.unlock();
+
+    m_membersCountCacheMutex.lock();
+    m_membersCountCache.clear();
+    m_membersCountCacheMutex.unlock();
+}
+
+bool EvalHelpers::GetMembersCountFromCache(const COR_TYPEID &typeID, int &numStatic, int &numInstance)
+{
+    std::lock_guard<std::mutex> lock(m_membersCountCacheMutex);
+    auto find = m_membersCountCache.find(typeID);
+    if (find == m_membersCountCache.end())
+        return false;
+
+    numStatic = find->second.first;
+    numInstance = find->second.second;
+    return true;
+}
+
+void EvalHelpers::AddMembersCountToCache(const COR_TYPEID &typeID, int numStatic, int numInstance)
+{
+    std::lock_guard<std::mutex> lock(m_membersCountCacheMutex);
+    m_membersCountCache[typeID] = std::make_pair(numStatic, numInstance);
+}
+
+void EvalHelpers::InvalidateTypeLayoutCache()
+{
+    std::lock_guard<std::mutex> lock(m_typeLayoutCacheMutex);
+    m_typeLayoutCache.clear();
+}
+
+static bool IsPrimitiveFieldType(CorElementType elemType)
+{
+    switch (elemType)
+    {
+    case ELEMENT_TYPE_BOOLEAN:
+    case ELEMENT_TYPE_CHAR:
+    case ELEMENT_TYPE_I1:
+    case ELEMENT_TYPE_U1:
+    case ELEMENT_TYPE_I2:
+    case ELEMENT_TYPE_U2:
+    case ELEMENT_TYPE_I4:
+    case ELEMENT_TYPE_U4:
+    case ELEMENT_TYPE_I8:
+    case ELEMENT_TYPE_U8:
+    case ELEMENT_TYPE_R4:
+    case ELEMENT_TYPE_R8:
+    case ELEMENT_TYPE_I:
+    case ELEMENT_TYPE_U:
+        return true;
+    default:
+        return false;
+    }
+}
+
+static HRESULT BuildTypeLayout(ICorDebugProcess5 *pProcess5, ICorDebugType *pType, const COR_TYPEID &typeID, EvalHelpers::TypeLayout &typeLayout)
+{
+    HRESULT Status;
+    COR_TYPE_LAYOUT layout;
+    IfFailRet(pProcess5->GetTypeLayout(typeID, &layout));
+    typeLayout.boxOffset = layout.boxOffset;
+    if (layout.numFields == 0)
+        return S_OK;
+
+    std::vector<COR_FIELD> fields(layout.numFields);
+    ULONG32 fetched = 0;
+    IfFailRet(pProcess5->GetTypeFields(typeID, (ULONG32)fields.size(), fields.data(), &fetched));
+    fields.resize(std::min(fetched, (ULONG32)fields.size()));
+
+    ToRelease<ICorDebugClass> pClass;
+    IfFailRet(pType->GetClass(&pClass));
+    ToRelease<ICorDebugModule> pModule;
+    IfFailRet(pClass->GetModule(&pModule));
+    ToRelease<IUnknown> pMDUnknown;
+    IfFailRet(pModule->GetMetaDataInterface(IID_IMetaDataImport, &pMDUnknown));
+    ToRelease<IMetaDataImport> pMD;
+    IfFailRet(pMDUnknown->QueryInterface(IID_IMetaDataImport, (LPVOID*) &pMD));
+
+    for (const auto &field : fields)
+    {
+        // Note, generic type's fields could have ELEMENT_TYPE_VAR/ELEMENT_TYPE_MVAR type here, in this case COM path should be used.
+        if (!IsPrimitiveFieldType(field.fieldType))
+            continue;
+
+        ULONG nameLen = 0;
+        WCHAR mdName[mdNameLen] = {0};
+        if (FAILED(pMD->GetFieldProps(field.token, nullptr, mdName, _countof(mdName), &nameLen, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr)))
+            continue;
+
+        ToRelease<ICorDebugType> pFieldType;
+        EvalHelpers::FieldLayout fieldLayout;
+        if (FAILED(pProcess5->GetTypeForTypeID(field.id, &pFieldType)) ||
+            FAILED(TypePrinter::GetTypeOfValue(pFieldType, fieldLayout.typeName)))
+            continue;
+
+        fieldLayout.name = to_utf8(mdName);
+        fieldLayout.offset = field.offset;
+        fieldLayout.elemType = field.fieldType;
+        typeLayout.fields.emplace_back(std::move(fieldLayout));
+    }
+
+    return S_OK;
+}
+
+HRESULT EvalHelpers::GetTypeLayout(ICorDebugProcess5 *pProcess5, ICorDebugType *pType, std::shared_ptr<TypeLayout> &typeLayout)
+{
+    HRESULT Status;
+    ToRelease<ICorDebugType2> iCorType2;
+    IfFailRet(pType->QueryInterface(IID_ICorDebugType2, (LPVOID*) &iCorType2));
+    COR_TYPEID typeID;
+    IfFailRet(iCorType2->GetTypeID(&typeID));
+
+    {
+        std::lock_guard<std::mutex> lock(m_typeLayoutCacheMutex);
+        auto find = m_typeLayoutCache.find(typeID);
+        if (find != m_typeLayoutCache.end())
+        {
+            typeLayout = find->second;
+            return S_OK;
+        }
+    }
+
+    // Note, in case of fail we cache empty layout, so, all fields will be read by COM path without new attempts.
+    std::shared_ptr<TypeLayout> newTypeLayout = std::make_shared<TypeLayout>();
+    if (FAILED(BuildTypeLayout(pProcess5, pType, typeID, *newTypeLayout)))
+        newTypeLayout->fields.clear();
+
+    std::lock_guard<std::mutex> lock(m_typeLayoutCacheMutex);
+    m_typeLayoutCache[typeID] = newTypeLayout;
+    typeLayout = newTypeLayout;
+    return S_OK;
 }
 
 HRESULT EvalHelpers::CreateString(ICorDebugThread *pThread, const std::string &value, ICorDebugValue **ppNewString)
@@ -204,6 +372,42 @@ static bool TypeHaveStaticMembers(ICorDebugType *pType)
     return false;
 }
 
+HRESULT EvalHelpers::SetTypeObjectCacheCapacity(size_t capacity)
+{
+    if (capacity > TypeObjectCacheStats::MaxCapacity)
+    {
+        LOGE("Type objects cache capacity %zu is out of range, max capacity is %u", capacity, TypeObjectCacheStats::MaxCapacity);
+        return E_INVALIDARG;
+    }
+
+    std::lock_guard<std::mutex> lock(m_typeObjectCacheMutex);
+
+    m_typeObjectCacheCapacity = capacity;
+    EvictTypeObjectsFromCache(m_typeObjectCacheCapacity);
+    return S_OK;
+}
+
+void EvalHelpers::GetTypeObjectCacheStats(TypeObjectCacheStats &stats, bool reset)
+{
+    std::lock_guard<std::mutex> lock(m_typeObjectCacheMutex);
+    stats = m_typeObjectCacheStats;
+    stats.size = (unsigned)m_typeObjectCache.size();
+    stats.capacity = (unsigned)m_typeObjectCacheCapacity;
+    if (reset)
+        m_typeObjectCacheStats = TypeObjectCacheStats();
+}
+
+// Note, m_typeObjectCacheMutex must be locked by caller.
+void EvalHelpers::EvictTypeObjectsFromCache(size_t capacity)
+{
+    while (m_typeObjectCache.size() > capacity)
+    {
+        m_typeObjectCacheIndex.erase(m_typeObjectCache.back().id);
+        m_typeObjectCache.pop_back();
+        m_typeObjectCacheStats.evictions++;
+    }
+}
+
 HRESULT EvalHelpers::TryReuseTypeObjectFromCache(ICorDebugType *pType, ICorDebugValue **ppTypeObjectResult)
 {
     std::lock_guard<std::mutex> lock(m_typeObjectCacheMutex);
@@ -215,10 +419,14 @@ HRESULT EvalHelpers::TryReuseTypeObjectFromCache(ICorDebugType *pType, ICorDebug
     COR_TYPEID typeID;
     IfFailRet(iCorType2->GetTypeID(&typeID));
 
-    auto is_same = [&typeID](type_object_t &typeObject){ return typeObject.id.token1 == typeID.token1 && typeObject.id.token2 == typeID.token2; };
-    auto it = std::find_if(m_typeObjectCache.begin(), m_typeObjectCache.end(), is_same);
-    if (it == m_typeObjectCache.end())
+    auto find = m_typeObjectCacheIndex.find(typeID);
+    if (find == m_typeObjectCacheIndex.end())
+    {
+        m_typeObjectCacheStats.misses++;
         return E_FAIL;
+    }
+    m_typeObjectCacheStats.hits++;
+    auto it = find->second;
 
     // Move data to begin, so, last used will be on front.
     if (it != m_typeObjectCache.begin())
@@ -246,9 +454,7 @@ HRESULT EvalHelpers::AddTypeObjectToCache(ICorDebugType *pType, ICorDebugValue *
     COR_TYPEID typeID;
     IfFailRet(iCorType2->GetTypeID(&typeID));
 
-    auto is_same = [&typeID](type_object_t &typeObject){ return typeObject.id.token1 == typeID.token1 && typeObject.id.token2 == typeID.token2; };
-    auto it = std::find_if(m_typeObjectCache.begin(), m_typeObjectCache.end(), is_same);
-    if (it != m_typeObjectCache.end())
+    if (m_typeObjectCacheCapacity == 0 || m_typeObjectCacheIndex.find(typeID) != m_typeObjectCacheIndex.end())
         return S_OK;
 
     ToRelease<ICorDebugHandleValue> iCorHandleValue;
@@ -259,17 +465,10 @@ HRESULT EvalHelpers::AddTypeObjectToCache(ICorDebugType *pType, ICorDebugValue *
         handleType != HANDLE_STRONG)
         return E_FAIL;
 
-    if (m_typeObjectCache.size() == m_typeObjectCacheSize)
-    {
-        // Re-use last list entry.
-        m_typeObjectCache.back().id = typeID;
-        m_typeObjectCache.back().typeObject.Free();
-        m_typeObjectCache.back().typeObject = iCorHandleValue.Detach();
-        assert(m_typeObjectCacheSize >= 2);
-        m_typeObjectCache.splice(m_typeObjectCache.begin(), m_typeObjectCache, std::prev(m_typeObjectCache.end()));
-    }
-    else
-        m_typeObjectCache.emplace_front(type_object_t{typeID, iCorHandleValue.Detach()});
+    // Displace least recently used entries, so, cache will not exceed capacity after new entry added.
+    EvictTypeObjectsFromCache(m_typeObjectCacheCapacity - 1);
+    m_typeObjectCache.emplace_front(type_object_t{typeID, iCorHandleValue.Detach()});
+    m_typeObjectCacheIndex[typeID] = m_typeObjectCache.begin();
 
     return S_OK;
 }
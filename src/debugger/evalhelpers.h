@@ -9,6 +9,9 @@
 
 #include <string>
 #include <list>
+#include <map>
+#include <unordered_map>
+#include <vector>
 #include <mutex>
 #include <memory>
 #include "utils/torelease.h"
@@ -26,10 +29,7 @@ class EvalHelpers
 public:
 
     EvalHelpers(std::shared_ptr<Modules> &sharedModules,
-                std::shared_ptr<EvalWaiter> &sharedEvalWaiter) :
-        m_sharedModules(sharedModules),
-        m_sharedEvalWaiter(sharedEvalWaiter)
-    {}
+                std::shared_ptr<EvalWaiter> &sharedEvalWaiter);
 
     HRESULT CreatTypeObjectStaticConstructor(
         ICorDebugThread *pThread,
@@ -61,6 +61,74 @@ public:
 
     HRESULT FindMethodInModule(const std::string &moduleName, const WCHAR className[], const WCHAR methodName[], ICorDebugFunction **ppFunction);
 
+    // Decoded metadata of type's field or property, that could be shown to user.
+    struct MemberInfo
+    {
+        bool isProperty;
+        bool isStatic;
+        std::string name;
+        // Field related data (mdFieldDef token). Note, signature and literal value point to module's metadata.
+        mdFieldDef fieldDef;
+        DWORD fieldAttr;
+        PCCOR_SIGNATURE pSignatureBlob;
+        ULONG sigBlobLength;
+        UVCP_CONSTANT pRawValue;
+        ULONG rawValueLength;
+        // Property related data.
+        mdMethodDef mdGetter;
+        mdMethodDef mdSetter;
+    };
+
+    enum class BaseTypeKind
+    {
+        None,   // no base type or base type members should be ignored (System.Object, System.ValueType)
+        Enum,   // System.Enum
+        Walk    // base type members should be walked too
+    };
+
+    struct TypeMembers
+    {
+        // Hold metadata interface, since MemberInfo's signature and literal value point to metadata memory.
+        ToRelease<IMetaDataImport> metaData;
+        bool skipMembers = false; // for types with custom walk logic, for example, decimal
+        BaseTypeKind baseType = BaseTypeKind::None;
+        std::vector<MemberInfo> members; // fields first, properties after, in metadata order
+    };
+
+    std::shared_ptr<TypeMembers> GetTypeMembersFromCache(CORDB_ADDRESS modAddress, mdTypeDef typeDef);
+    void AddTypeMembersToCache(CORDB_ADDRESS modAddress, mdTypeDef typeDef, std::shared_ptr<TypeMembers> &typeMembers);
+    // Must be called at module unload and Hot Reload, since types could be changed.
+    // Note, members count cache also invalidated, since it calculated from members data.
+    void InvalidateTypeMembersCache();
+
+    // Static and instance members count of exact type (include base types members), same for all not null objects of this type.
+    bool GetMembersCountFromCache(const COR_TYPEID &typeID, int &numStatic, int &numInstance);
+    void AddMembersCountToCache(const COR_TYPEID &typeID, int numStatic, int numInstance);
+
+    // Instance fields layout of exact type (see ICorDebugProcess5::GetTypeLayout and ICorDebugProcess5::GetTypeFields),
+    // allow decode field value from raw object data, read from debuggee memory.
+    struct FieldLayout
+    {
+        std::string name;
+        ULONG32 offset; // from boxed object start, for unboxed value types data see TypeLayout::boxOffset
+        CorElementType elemType;
+        std::string typeName;
+    };
+
+    struct TypeLayout
+    {
+        ULONG32 boxOffset = 0; // value type data offset in boxed object, 0 for reference types
+        std::vector<FieldLayout> fields; // fields of primitive types declared by this type only (not by base type)
+    };
+
+    HRESULT GetTypeLayout(ICorDebugProcess5 *pProcess5, ICorDebugType *pType, std::shared_ptr<TypeLayout> &typeLayout);
+    // Must be called at module unload, since type id could be reused by new loaded type.
+    void InvalidateTypeLayoutCache();
+
+    // Return E_INVALIDARG in case capacity is out of [0, TypeObjectCacheStats::MaxCapacity] range, capacity `0` disable cache.
+    HRESULT SetTypeObjectCacheCapacity(size_t capacity);
+    void GetTypeObjectCacheStats(TypeObjectCacheStats &stats, bool reset);
+
     void Cleanup();
 
 private:
@@ -77,16 +145,48 @@ private:
         ToRelease<ICorDebugHandleValue> typeObject;
     };
 
+    struct type_id_hash
+    {
+        size_t operator()(const COR_TYPEID &id) const
+        {
+            return std::hash<uint64_t>()(id.token1) ^ (std::hash<uint64_t>()(id.token2) << 1);
+        }
+    };
+
+    struct type_id_equal
+    {
+        bool operator()(const COR_TYPEID &lhs, const COR_TYPEID &rhs) const
+        {
+            return lhs.token1 == rhs.token1 && lhs.token2 == rhs.token2;
+        }
+    };
+
     std::mutex m_typeObjectCacheMutex;
     // Because handles affect the performance of the garbage collector, the debugger should limit itself to a relatively
     // small number of handles (about 256) that are active at a time.
     // https://docs.microsoft.com/en-us/dotnet/framework/unmanaged-api/debugging/icordebugheapvalue2-createhandle-method
     // Note, we also use handles (results of eval) in var refs during brake (cleared at 'Continue').
-    // Warning! Since we use `std::prev(m_typeObjectCache.end())` without any check in code, make sure cache size is `2` or bigger.
-    static const size_t m_typeObjectCacheSize = 100;
+    // Default capacity is small, but could be increased for applications that use thousands of types during eval.
+    static const size_t m_typeObjectCacheDefaultCapacity = 100;
+    size_t m_typeObjectCacheCapacity;
     // The idea of cache is not hold all type objects, but prevent numerous times same type objects creation during eval.
     // At access, element moved to front of list, new element also add to front. In this way, not used elements displaced from cache.
     std::list<type_object_t> m_typeObjectCache;
+    // Index for fast search in LRU list by type id.
+    std::unordered_map<COR_TYPEID, std::list<type_object_t>::iterator, type_id_hash, type_id_equal> m_typeObjectCacheIndex;
+    TypeObjectCacheStats m_typeObjectCacheStats;
+
+    std::mutex m_membersCountCacheMutex;
+    std::unordered_map<COR_TYPEID, std::pair<int, int>, type_id_hash, type_id_equal> m_membersCountCache;
+
+    std::mutex m_typeLayoutCacheMutex;
+    std::unordered_map<COR_TYPEID, std::shared_ptr<TypeLayout>, type_id_hash, type_id_equal> m_typeLayoutCache;
+
+    void EvictTypeObjectsFromCache(size_t capacity);
+
+    std::mutex m_typeMembersCacheMutex;
+    // Per-type members metadata, decoded once and reused for all objects of same type.
+    std::map<std::pair<CORDB_ADDRESS, mdTypeDef>, std::shared_ptr<TypeMembers>> m_typeMembersCache;
 
     HRESULT TryReuseTypeObjectFromCache(ICorDebugType *pType, ICorDebugValue **ppTypeObjectResult);
     HRESULT AddTypeObjectToCache(ICorDebugType *pType, ICorDebugValue *pTypeObject);
@@ -6,6 +6,7 @@
 #include <memory>
 #include <unordered_set>
 #include <vector>
+#include <limits>
 #include "debugger/evalhelpers.h"
 #include "debugger/evalutils.h"
 #include "debugger/evaluator.h"
@@ -551,6 +552,224 @@ static bool IsSynthesizedLocalName(WCHAR *mdName, ULONG nameLen)
            (nameLen > 4 && starts_with(mdName, W("CS$<")));
 }
 
+static bool IsDebuggerBrowsableNever(IMetaDataImport *pMD, mdProperty propertyDef)
+{
+    // https://github.sec.samsung.net/dotnet/coreclr/blob/9df87a133b0f29f4932f38b7307c87d09ab80d5d/src/System.Private.CoreLib/shared/System/Diagnostics/DebuggerBrowsableAttribute.cs#L17
+    // Since we check only first byte, no reason store it as int (default enum type in c#)
+    enum DebuggerBrowsableState : char
+    {
+        Never = 0,
+        Expanded = 1, 
+        Collapsed = 2,
+        RootHidden = 3
+    };
+
+    const char *g_DebuggerBrowsable = "System.Diagnostics.DebuggerBrowsableAttribute..ctor";
+    bool debuggerBrowsableState_Never = false;
+
+    ULONG numAttributes = 0;
+    HCORENUM hEnum = NULL;
+    mdCustomAttribute attr;
+    while(SUCCEEDED(pMD->EnumCustomAttributes(&hEnum, propertyDef, 0, &attr, 1, &numAttributes)) && numAttributes != 0)
+    {
+        mdToken ptkObj = mdTokenNil;
+        mdToken ptkType = mdTokenNil;
+        void const *ppBlob = 0;
+        ULONG pcbSize = 0;
+        if (FAILED(pMD->GetCustomAttributeProps(attr, &ptkObj, &ptkType, &ppBlob, &pcbSize)))
+            continue;
+
+        std::string mdName;
+        if (FAILED(TypePrinter::NameForToken(ptkType, pMD, mdName, true, nullptr)))
+            continue;
+
+        if (mdName == g_DebuggerBrowsable
+            // In case of DebuggerBrowsableAttribute blob is 8 bytes:
+            // 2 bytes - blob prolog 0x0001
+            // 4 bytes - data (DebuggerBrowsableAttribute::State), default enum type (int)
+            // 2 bytes - alignment
+            // We check only one byte (first data byte), no reason check 4 bytes in our case.
+            && pcbSize > 2
+            && ((char const *)ppBlob)[2] == DebuggerBrowsableState::Never)
+        {
+            debuggerBrowsableState_Never = true;
+            break;
+        }
+    }
+    pMD->CloseEnum(hEnum);
+
+    return debuggerBrowsableState_Never;
+}
+
+// Decode type's members metadata once, all other calls for same type (module + typedef) will reuse cached data.
+static HRESULT GetTypeMembers(EvalHelpers *pEvalHelpers, ICorDebugModule *pModule, mdTypeDef currentTypeDef,
+                              std::shared_ptr<EvalHelpers::TypeMembers> &typeMembers)
+{
+    HRESULT Status;
+    CORDB_ADDRESS modAddress;
+    IfFailRet(pModule->GetBaseAddress(&modAddress));
+
+    typeMembers = pEvalHelpers->GetTypeMembersFromCache(modAddress, currentTypeDef);
+    if (typeMembers)
+        return S_OK;
+
+    ToRelease<IUnknown> pMDUnknown;
+    IfFailRet(pModule->GetMetaDataInterface(IID_IMetaDataImport, &pMDUnknown));
+    ToRelease<IMetaDataImport> pMD;
+    IfFailRet(pMDUnknown->QueryInterface(IID_IMetaDataImport, (LPVOID*) &pMD));
+
+    std::shared_ptr<EvalHelpers::TypeMembers> newTypeMembers = std::make_shared<EvalHelpers::TypeMembers>();
+
+    std::string className;
+    if (SUCCEEDED(TypePrinter::NameForToken(currentTypeDef, pMD, className, true, nullptr)))
+        newTypeMembers->skipMembers = className == "decimal";
+
+    DWORD flags;
+    ULONG nameLen;
+    mdToken tkExtends;
+    IfFailRet(pMD->GetTypeDefProps(currentTypeDef, nullptr, 0, &nameLen, &flags, &tkExtends));
+    std::string baseTypeName;
+    if (IsNilToken(tkExtends))
+        newTypeMembers->baseType = EvalHelpers::BaseTypeKind::None;
+    else if (FAILED(TypePrinter::NameForToken(tkExtends, pMD, baseTypeName, true, nullptr))) // generic base type (TypeSpec)
+        newTypeMembers->baseType = EvalHelpers::BaseTypeKind::Walk;
+    else if (baseTypeName == "System.Enum")
+        newTypeMembers->baseType = EvalHelpers::BaseTypeKind::Enum;
+    else if (baseTypeName == "object" || baseTypeName == "System.ValueType")
+        newTypeMembers->baseType = EvalHelpers::BaseTypeKind::None;
+    else
+        newTypeMembers->baseType = EvalHelpers::BaseTypeKind::Walk;
+
+    IfFailRet(ForEachFields(pMD, currentTypeDef, [&](mdFieldDef fieldDef) -> HRESULT
+    {
+        EvalHelpers::MemberInfo member;
+        member.isProperty = false;
+        member.fieldDef = fieldDef;
+        member.fieldAttr = 0;
+        member.pSignatureBlob = nullptr;
+        member.sigBlobLength = 0;
+        member.pRawValue = nullptr;
+        member.rawValueLength = 0;
+        member.mdGetter = mdMethodDefNil;
+        member.mdSetter = mdMethodDefNil;
+
+        ULONG nameLen = 0;
+        WCHAR mdName[mdNameLen] = {0};
+        if (SUCCEEDED(pMD->GetFieldProps(fieldDef, nullptr, mdName, _countof(mdName), &nameLen, &member.fieldAttr,
+                                         &member.pSignatureBlob, &member.sigBlobLength, nullptr, &member.pRawValue, &member.rawValueLength)))
+        {
+            // Prevent access to internal compiler added fields (without visible name).
+            // Should be accessed by debugger routine only and hidden from user/ide.
+            // More about compiler generated names in Roslyn sources:
+            // https://github.com/dotnet/roslyn/blob/315c2e149ba7889b0937d872274c33fcbfe9af5f/src/Compilers/CSharp/Portable/Symbols/Synthesized/GeneratedNames.cs
+            // Note, uncontrolled access to internal compiler added field or its properties may break debugger work.
+            if (IsSynthesizedLocalName(mdName, nameLen))
+                return S_OK;
+
+            member.isStatic = (member.fieldAttr & fdStatic);
+            member.name = to_utf8(mdName);
+            newTypeMembers->members.emplace_back(std::move(member));
+        }
+        return S_OK;
+    }));
+    IfFailRet(ForEachProperties(pMD, currentTypeDef, [&](mdProperty propertyDef) -> HRESULT
+    {
+        mdTypeDef  propertyClass;
+
+        ULONG propertyNameLen = 0;
+        UVCP_CONSTANT pDefaultValue;
+        ULONG cchDefaultValue;
+        mdMethodDef mdGetter;
+        mdMethodDef mdSetter;
+        WCHAR propertyName[mdNameLen] = W("\0");
+        if (SUCCEEDED(pMD->GetPropertyProps(propertyDef, &propertyClass, propertyName, _countof(propertyName),
+                                            &propertyNameLen, nullptr, nullptr, nullptr, nullptr, &pDefaultValue,
+                                            &cchDefaultValue, &mdSetter, &mdGetter, nullptr, 0, nullptr)))
+        {
+            DWORD getterAttr = 0;
+            if (FAILED(pMD->GetMethodProps(mdGetter, NULL, NULL, 0, NULL, &getterAttr, NULL, NULL, NULL, NULL)))
+                return S_OK;
+
+            if (IsDebuggerBrowsableNever(pMD, propertyDef))
+                return S_OK;
+
+            EvalHelpers::MemberInfo member;
+            member.isProperty = true;
+            member.isStatic = (getterAttr & mdStatic);
+            member.name = to_utf8(propertyName);
+            member.fieldDef = mdFieldDefNil;
+            member.fieldAttr = 0;
+            member.pSignatureBlob = nullptr;
+            member.sigBlobLength = 0;
+            member.pRawValue = nullptr;
+            member.rawValueLength = 0;
+            member.mdGetter = mdGetter;
+            member.mdSetter = mdSetter;
+            newTypeMembers->members.emplace_back(std::move(member));
+        }
+        return S_OK;
+    }));
+
+    newTypeMembers->metaData = pMD.Detach();
+    pEvalHelpers->AddTypeMembersToCache(modAddress, currentTypeDef, newTypeMembers);
+    typeMembers = std::move(newTypeMembers);
+    return S_OK;
+}
+
+// Convert element position (row-major order) into array indicies.
+static void PositionToIndicies(ULONG32 position, const std::vector<ULONG32> &dims, std::vector<ULONG32> &ind)
+{
+    for (int i = static_cast<int32_t>(dims.size()) - 1; i >= 0; --i)
+    {
+        if (dims[i] == 0)
+            return;
+        ind[i] = position % dims[i];
+        position /= dims[i];
+    }
+}
+
+// Walk array elements in [startIndex, endIndex) positions range, all elements before startIndex are not touched.
+static HRESULT InternalWalkArrayElements(ICorDebugArrayValue *pArrayValue, ULONG32 startIndex, ULONG32 endIndex, Evaluator::WalkMembersCallback cb)
+{
+    HRESULT Status;
+
+    ULONG32 nRank;
+    IfFailRet(pArrayValue->GetRank(&nRank));
+
+    ULONG32 cElements;
+    IfFailRet(pArrayValue->GetCount(&cElements));
+
+    if (endIndex > cElements)
+        endIndex = cElements;
+    if (startIndex >= endIndex)
+        return S_OK;
+
+    std::vector<ULONG32> dims(nRank, 0);
+    IfFailRet(pArrayValue->GetDimensions(nRank, &dims[0]));
+
+    std::vector<ULONG32> base(nRank, 0);
+    BOOL hasBaseIndicies = FALSE;
+    if (SUCCEEDED(pArrayValue->HasBaseIndicies(&hasBaseIndicies)) && hasBaseIndicies)
+        IfFailRet(pArrayValue->GetBaseIndicies(nRank, &base[0]));
+
+    std::vector<ULONG32> ind(nRank, 0);
+    PositionToIndicies(startIndex, dims, ind);
+
+    for (ULONG32 i = startIndex; i < endIndex; ++i)
+    {
+        auto getValue = [&](ICorDebugValue **ppResultValue, int) -> HRESULT
+        {
+            IfFailRet(pArrayValue->GetElementAtPosition(i, ppResultValue));
+            return S_OK;
+        };
+
+        IfFailRet(cb(nullptr, false, "[" + IndiciesToStr(ind, base) + "]", getValue, nullptr));
+        IncIndicies(ind, dims);
+    }
+
+    return S_OK;
+}
+
 static HRESULT InternalWalkMembers(EvalHelpers *pEvalHelpers, ICorDebugValue *pInputValue, ICorDebugThread *pThread, FrameLevel frameLevel,
                                    ICorDebugType *pTypeCast, bool provideSetterData, Evaluator::WalkMembersCallback cb)
 {
@@ -580,37 +799,7 @@ static HRESULT InternalWalkMembers(EvalHelpers *pEvalHelpers, ICorDebugValue *pI
 
     ToRelease<ICorDebugArrayValue> pArrayValue;
     if (SUCCEEDED(pValue->QueryInterface(IID_ICorDebugArrayValue, (LPVOID *) &pArrayValue)))
-    {
-        ULONG32 nRank;
-        IfFailRet(pArrayValue->GetRank(&nRank));
-
-        ULONG32 cElements;
-        IfFailRet(pArrayValue->GetCount(&cElements));
-
-        std::vector<ULONG32> dims(nRank, 0);
-        IfFailRet(pArrayValue->GetDimensions(nRank, &dims[0]));
-
-        std::vector<ULONG32> base(nRank, 0);
-        BOOL hasBaseIndicies = FALSE;
-        if (SUCCEEDED(pArrayValue->HasBaseIndicies(&hasBaseIndicies)) && hasBaseIndicies)
-            IfFailRet(pArrayValue->GetBaseIndicies(nRank, &base[0]));
-
-        std::vector<ULONG32> ind(nRank, 0);
-
-        for (ULONG32 i = 0; i < cElements; ++i)
-        {
-            auto getValue = [&](ICorDebugValue **ppResultValue, int) -> HRESULT
-            {
-                IfFailRet(pArrayValue->GetElementAtPosition(i, ppResultValue));
-                return S_OK;
-            };
-
-            IfFailRet(cb(nullptr, false, "[" + IndiciesToStr(ind, base) + "]", getValue, nullptr));
-            IncIndicies(ind, dims);
-        }
-
-        return S_OK;
-    }
+        return InternalWalkArrayElements(pArrayValue, 0, std::numeric_limits<ULONG32>::max(), cb);
 
     ToRelease<ICorDebugValue2> pValue2;
     IfFailRet(pValue->QueryInterface(IID_ICorDebugValue2, (LPVOID *) &pValue2));
@@ -626,11 +815,6 @@ static HRESULT InternalWalkMembers(EvalHelpers *pEvalHelpers, ICorDebugValue *pI
         pType = pTypeCast;
     }
 
-    std::string className;
-    TypePrinter::GetTypeOfValue(pType, className);
-    if (className == "decimal") // TODO: implement mechanism for walking over custom type fields
-        return S_OK;
-
     CorElementType corElemType;
     IfFailRet(pType->GetType(&corElemType));
     if (corElemType == ELEMENT_TYPE_STRING)
@@ -642,43 +826,26 @@ static HRESULT InternalWalkMembers(EvalHelpers *pEvalHelpers, ICorDebugValue *pI
     IfFailRet(pClass->GetModule(&pModule));
     mdTypeDef currentTypeDef;
     IfFailRet(pClass->GetToken(&currentTypeDef));
-    ToRelease<IUnknown> pMDUnknown;
-    IfFailRet(pModule->GetMetaDataInterface(IID_IMetaDataImport, &pMDUnknown));
-    ToRelease<IMetaDataImport> pMD;
-    IfFailRet(pMDUnknown->QueryInterface(IID_IMetaDataImport, (LPVOID*) &pMD));
-    IfFailRet(ForEachFields(pMD, currentTypeDef, [&](mdFieldDef fieldDef) -> HRESULT
-    {
-        ULONG nameLen = 0;
-        DWORD fieldAttr = 0;
-        WCHAR mdName[mdNameLen] = {0};
-        PCCOR_SIGNATURE pSignatureBlob = nullptr;
-        ULONG sigBlobLength = 0;
-        UVCP_CONSTANT pRawValue = nullptr;
-        ULONG rawValueLength = 0;
-        if (SUCCEEDED(pMD->GetFieldProps(fieldDef, nullptr, mdName, _countof(mdName), &nameLen, &fieldAttr,
-                                         &pSignatureBlob, &sigBlobLength, nullptr, &pRawValue, &rawValueLength)))
-        {
-            // Prevent access to internal compiler added fields (without visible name).
-            // Should be accessed by debugger routine only and hidden from user/ide.
-            // More about compiler generated names in Roslyn sources:
-            // https://github.com/dotnet/roslyn/blob/315c2e149ba7889b0937d872274c33fcbfe9af5f/src/Compilers/CSharp/Portable/Symbols/Synthesized/GeneratedNames.cs
-            // Note, uncontrolled access to internal compiler added field or its properties may break debugger work.
-            if (IsSynthesizedLocalName(mdName, nameLen))
-                return S_OK;
-
-            bool is_static = (fieldAttr & fdStatic);
-            if (isNull && !is_static)
-                return S_OK;
+    std::shared_ptr<EvalHelpers::TypeMembers> typeMembers;
+    IfFailRet(GetTypeMembers(pEvalHelpers, pModule, currentTypeDef, typeMembers));
+    if (typeMembers->skipMembers) // TODO: implement mechanism for walking over custom type fields
+        return S_OK;
 
-            std::string name = to_utf8(mdName);
+    for (const auto &member : typeMembers->members)
+    {
+        if (isNull && !member.isStatic)
+            continue;
 
+        if (!member.isProperty)
+        {
             auto getValue = [&](ICorDebugValue **ppResultValue, int) -> HRESULT
             {
-                if (fieldAttr & fdLiteral)
+                if (member.fieldAttr & fdLiteral)
                 {
-                    IfFailRet(pEvalHelpers->GetLiteralValue(pThread, pType, pModule, pSignatureBlob, sigBlobLength, pRawValue, rawValueLength, ppResultValue));
+                    IfFailRet(pEvalHelpers->GetLiteralValue(pThread, pType, pModule, member.pSignatureBlob, member.sigBlobLength,
+                                                            member.pRawValue, member.rawValueLength, ppResultValue));
                 }
-                else if (fieldAttr & fdStatic)
+                else if (member.fieldAttr & fdStatic)
                 {
                     if (!pThread)
                         return E_FAIL;
@@ -689,7 +856,7 @@ static HRESULT InternalWalkMembers(EvalHelpers *pEvalHelpers, ICorDebugValue *pI
                     if (pFrame == nullptr)
                         return E_FAIL;
 
-                    IfFailRet(pType->GetStaticFieldValue(fieldDef, pFrame, ppResultValue));
+                    IfFailRet(pType->GetStaticFieldValue(member.fieldDef, pFrame, ppResultValue));
                 }
                 else
                 {
@@ -698,132 +865,56 @@ static HRESULT InternalWalkMembers(EvalHelpers *pEvalHelpers, ICorDebugValue *pI
                     IfFailRet(DereferenceAndUnboxValue(pInputValue, &pValue, &isNull));
                     ToRelease<ICorDebugObjectValue> pObjValue;
                     IfFailRet(pValue->QueryInterface(IID_ICorDebugObjectValue, (LPVOID*) &pObjValue));
-                    IfFailRet(pObjValue->GetFieldValue(pClass, fieldDef, ppResultValue));
+                    IfFailRet(pObjValue->GetFieldValue(pClass, member.fieldDef, ppResultValue));
                 }
 
                 return S_OK;
             };
 
-            IfFailRet(cb(pType, is_static, name, getValue, nullptr));
+            IfFailRet(cb(pType, member.isStatic, member.name, getValue, nullptr));
+            continue;
         }
-        return S_OK;
-    }));
-    IfFailRet(ForEachProperties(pMD, currentTypeDef, [&](mdProperty propertyDef) -> HRESULT
-    {
-        mdTypeDef  propertyClass;
 
-        ULONG propertyNameLen = 0;
-        UVCP_CONSTANT pDefaultValue;
-        ULONG cchDefaultValue;
-        mdMethodDef mdGetter;
-        mdMethodDef mdSetter;
-        WCHAR propertyName[mdNameLen] = W("\0");
-        if (SUCCEEDED(pMD->GetPropertyProps(propertyDef, &propertyClass, propertyName, _countof(propertyName),
-                                            &propertyNameLen, nullptr, nullptr, nullptr, nullptr, &pDefaultValue,
-                                            &cchDefaultValue, &mdSetter, &mdGetter, nullptr, 0, nullptr)))
+        auto getValue = [&](ICorDebugValue **ppResultValue, int evalFlags) -> HRESULT
         {
-            DWORD getterAttr = 0;
-            if (FAILED(pMD->GetMethodProps(mdGetter, NULL, NULL, 0, NULL, &getterAttr, NULL, NULL, NULL, NULL)))
-                return S_OK;
-
-            bool is_static = (getterAttr & mdStatic);
-            if (isNull && !is_static)
-                return S_OK;
+            if (!pThread)
+                return E_FAIL;
 
-            // https://github.sec.samsung.net/dotnet/coreclr/blob/9df87a133b0f29f4932f38b7307c87d09ab80d5d/src/System.Private.CoreLib/shared/System/Diagnostics/DebuggerBrowsableAttribute.cs#L17
-            // Since we check only first byte, no reason store it as int (default enum type in c#)
-            enum DebuggerBrowsableState : char
-            {
-                Never = 0,
-                Expanded = 1, 
-                Collapsed = 2,
-                RootHidden = 3
-            };
+            ToRelease<ICorDebugFunction> iCorFunc;
+            IfFailRet(pModule->GetFunctionFromToken(member.mdGetter, &iCorFunc));
 
-            const char *g_DebuggerBrowsable = "System.Diagnostics.DebuggerBrowsableAttribute..ctor";
-            bool debuggerBrowsableState_Never = false;
-
-            ULONG numAttributes = 0;
-            HCORENUM hEnum = NULL;
-            mdCustomAttribute attr;
-            while(SUCCEEDED(pMD->EnumCustomAttributes(&hEnum, propertyDef, 0, &attr, 1, &numAttributes)) && numAttributes != 0)
-            {
-                mdToken ptkObj = mdTokenNil;
-                mdToken ptkType = mdTokenNil;
-                void const *ppBlob = 0;
-                ULONG pcbSize = 0;
-                if (FAILED(pMD->GetCustomAttributeProps(attr, &ptkObj, &ptkType, &ppBlob, &pcbSize)))
-                    continue;
-
-                std::string mdName;
-                if (FAILED(TypePrinter::NameForToken(ptkType, pMD, mdName, true, nullptr)))
-                    continue;
-
-                if (mdName == g_DebuggerBrowsable
-                    // In case of DebuggerBrowsableAttribute blob is 8 bytes:
-                    // 2 bytes - blob prolog 0x0001
-                    // 4 bytes - data (DebuggerBrowsableAttribute::State), default enum type (int)
-                    // 2 bytes - alignment
-                    // We check only one byte (first data byte), no reason check 4 bytes in our case.
-                    && pcbSize > 2
-                    && ((char const *)ppBlob)[2] == DebuggerBrowsableState::Never)
-                {
-                    debuggerBrowsableState_Never = true;
-                    break;
-                }
-            }
-            pMD->CloseEnum(hEnum);
-
-            if (debuggerBrowsableState_Never)
-                return S_OK;
-
-            std::string name = to_utf8(propertyName);
-
-            auto getValue = [&](ICorDebugValue **ppResultValue, int evalFlags) -> HRESULT
-            {
-                if (!pThread)
-                    return E_FAIL;
-
-                ToRelease<ICorDebugFunction> iCorFunc;
-                IfFailRet(pModule->GetFunctionFromToken(mdGetter, &iCorFunc));
-
-                return pEvalHelpers->EvalFunction(pThread, iCorFunc, pType.GetRef(), 1, is_static ? nullptr : &pInputValue, is_static ? 0 : 1, ppResultValue, evalFlags);
-            };
+            return pEvalHelpers->EvalFunction(pThread, iCorFunc, pType.GetRef(), 1, member.isStatic ? nullptr : &pInputValue, member.isStatic ? 0 : 1, ppResultValue, evalFlags);
+        };
 
-            if (provideSetterData)
-            {
-                ToRelease<ICorDebugFunction> iCorFuncSetter;
-                if (FAILED(pModule->GetFunctionFromToken(mdSetter, &iCorFuncSetter)))
-                {
-                    iCorFuncSetter.Free();
-                }
-                Evaluator::SetterData setterData(is_static ? nullptr : pInputValue, pType, iCorFuncSetter);
-                IfFailRet(cb(pType, is_static, name, getValue, &setterData));
-            }
-            else
+        if (provideSetterData)
+        {
+            ToRelease<ICorDebugFunction> iCorFuncSetter;
+            if (FAILED(pModule->GetFunctionFromToken(member.mdSetter, &iCorFuncSetter)))
             {
-                IfFailRet(cb(pType, is_static, name, getValue, nullptr));
+                iCorFuncSetter.Free();
             }
+            Evaluator::SetterData setterData(member.isStatic ? nullptr : pInputValue, pType, iCorFuncSetter);
+            IfFailRet(cb(pType, member.isStatic, member.name, getValue, &setterData));
         }
+        else
+        {
+            IfFailRet(cb(pType, member.isStatic, member.name, getValue, nullptr));
+        }
+    }
+
+    if (typeMembers->baseType != EvalHelpers::BaseTypeKind::Walk)
         return S_OK;
-    }));
 
-    std::string baseTypeName;
     ToRelease<ICorDebugType> pBaseType;
-    if(SUCCEEDED(pType->GetBase(&pBaseType)) && pBaseType != NULL && SUCCEEDED(TypePrinter::GetTypeOfValue(pBaseType, baseTypeName)))
+    if(SUCCEEDED(pType->GetBase(&pBaseType)) && pBaseType != NULL)
     {
-        if(baseTypeName == "System.Enum")
-            return S_OK;
-        else if (baseTypeName != "object" && baseTypeName != "System.Object" && baseTypeName != "System.ValueType")
+        if (pThread)
         {
-            if (pThread)
-            {
-                // Note, this call could return S_FALSE without ICorDebugValue creation in case type don't have static members.
-                IfFailRet(pEvalHelpers->CreatTypeObjectStaticConstructor(pThread, pBaseType));
-            }
-            // Add fields of base class
-            IfFailRet(InternalWalkMembers(pEvalHelpers, pInputValue, pThread, frameLevel, pBaseType, provideSetterData, cb));
+            // Note, this call could return S_FALSE without ICorDebugValue creation in case type don't have static members.
+            IfFailRet(pEvalHelpers->CreatTypeObjectStaticConstructor(pThread, pBaseType));
         }
+        // Add fields of base class
+        IfFailRet(InternalWalkMembers(pEvalHelpers, pInputValue, pThread, frameLevel, pBaseType, provideSetterData, cb));
     }
 
     return S_OK;
@@ -839,6 +930,23 @@ HRESULT Evaluator::WalkMembers(
     return InternalWalkMembers(m_sharedEvalHelpers.get(), pValue, pThread, frameLevel, nullptr, provideSetterData, cb);
 }
 
+HRESULT Evaluator::WalkArrayElements(ICorDebugValue *pInputValue, ULONG32 startIndex, ULONG32 endIndex, WalkMembersCallback cb)
+{
+    HRESULT Status;
+    BOOL isNull = FALSE;
+    ToRelease<ICorDebugValue> pValue;
+
+    IfFailRet(DereferenceAndUnboxValue(pInputValue, &pValue, &isNull));
+
+    if (isNull && !pValue.GetPtr()) return S_OK;
+    else if (!pValue.GetPtr()) return E_FAIL;
+
+    ToRelease<ICorDebugArrayValue> pArrayValue;
+    IfFailRet(pValue->QueryInterface(IID_ICorDebugArrayValue, (LPVOID *) &pArrayValue));
+
+    return InternalWalkArrayElements(pArrayValue, startIndex, endIndex, cb);
+}
+
 enum class GeneratedCodeKind
 {
     Normal,
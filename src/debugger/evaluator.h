@@ -108,6 +108,13 @@ public:
         bool provideSetterData,
         WalkMembersCallback cb);
 
+    // Walk only array elements with positions (row-major order) in [startIndex, endIndex) range.
+    HRESULT WalkArrayElements(
+        ICorDebugValue *pInputValue,
+        ULONG32 startIndex,
+        ULONG32 endIndex,
+        WalkMembersCallback cb);
+
     HRESULT WalkStackVars(
         ICorDebugThread *pThread,
         FrameLevel frameLevel,
@@ -128,6 +128,19 @@ namespace EvalUtils
         return S_OK;
     }
 
+    // Type lookup result depends on identifiers names (without generic params) starting from nextIdentifier only.
+    static std::string GetTypeLookupKey(const std::vector<std::string> &identifiers, int nextIdentifier)
+    {
+        std::string typeKey;
+        for (int i = nextIdentifier; i < (int)identifiers.size(); i++)
+        {
+            std::string name;
+            ParseGenericParams(identifiers[i], name);
+            typeKey += (typeKey.empty() ? "" : ".") + name;
+        }
+        return typeKey;
+    }
+
     HRESULT GetType(const std::string &typeName, ICorDebugThread *pThread, Modules *pModules, ICorDebugType **ppType)
     {
         HRESULT Status;
@@ -244,17 +257,48 @@ namespace EvalUtils
 
         if (!pTypeModule)
         {
-            pModules->ForEachModule([&](ICorDebugModule *pModule)->HRESULT {
-                if (typeToken != mdTypeDefNil) // already found
-                    return S_OK;
+            std::string typeKey = GetTypeLookupKey(identifiers, nextIdentifier);
+            Modules::TypeLookup typeLookup;
+            uint64_t cacheGeneration;
+            if (pModules->GetTypeLookupFromCache(typeKey, typeLookup, cacheGeneration))
+            {
+                if (typeLookup.typeToken == mdTypeDefNil)
+                    return E_FAIL;
 
-                if (SUCCEEDED(FindTypeInModule(pModule, identifiers, nextIdentifier, typeToken)))
+                if (SUCCEEDED(pModules->GetModuleInfo(typeLookup.modAddress, [&](Modules::ModuleInfo &mdInfo) -> HRESULT
+                    {
+                        mdInfo.m_iCorModule->AddRef();
+                        pTypeModule = mdInfo.m_iCorModule.GetPtr();
+                        return S_OK;
+                    })))
                 {
-                    pModule->AddRef();
-                    pTypeModule = pModule;
+                    typeToken = typeLookup.typeToken;
+                    nextIdentifier += typeLookup.identifiersUsed;
                 }
-                return S_OK;
-            });
+            }
+
+            if (typeToken == mdTypeDefNil)
+            {
+                const int startIdentifier = nextIdentifier;
+                pModules->ForEachModule([&](ICorDebugModule *pModule)->HRESULT {
+                    if (typeToken != mdTypeDefNil) // already found
+                        return S_OK;
+
+                    if (SUCCEEDED(FindTypeInModule(pModule, identifiers, nextIdentifier, typeToken)))
+                    {
+                        pModule->AddRef();
+                        pTypeModule = pModule;
+                    }
+                    return S_OK;
+                });
+
+                typeLookup.modAddress = 0;
+                typeLookup.typeToken = typeToken;
+                typeLookup.identifiersUsed = nextIdentifier - startIdentifier;
+                if (typeToken != mdTypeDefNil)
+                    IfFailRet(pTypeModule->GetBaseAddress(&typeLookup.modAddress));
+                pModules->AddTypeLookupToCache(typeKey, typeLookup, cacheGeneration);
+            }
         }
         else
         {
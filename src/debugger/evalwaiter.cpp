@@ -4,6 +4,7 @@
 
 #include "debugger/evalwaiter.h"
 #include "debugger/threads.h"
+#include "debugger/frames.h"
 
 namespace netcoredbg
 {
@@ -75,6 +76,9 @@ std::future<std::unique_ptr<EvalWaiter::evalResultData_t> > EvalWaiter::RunEval(
     assert(!m_evalResult); // We can have only 1 eval, and previous must be completed.
     m_evalResult.reset(new evalResult_t{threadId, pEval, std::move(p)});
 
+    // Note, all frames will be neutered by process continue for eval.
+    InvalidateFramesCache();
+
     // We don't have easy way to abort setuped eval in case of some error in debugger API,
     // try setup eval only if all is OK right before we run process.
     if (FAILED(Status = cbSetupEval(pEval)))
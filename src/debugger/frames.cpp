@@ -5,6 +5,9 @@
 #include <sstream>
 #include <algorithm>
 #include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
 #include "debugger/frames.h"
 #include "metadata/typeprinter.h"
 #include "utils/platform.h"
@@ -83,7 +86,7 @@ HRESULT StitchInternalFrames(
 }
 
 // From https://github.com/SymbolSource/Microsoft.Samples.Debugging/blob/master/src/debugger/mdbgeng/FrameFactory.cs
-HRESULT WalkFrames(ICorDebugThread *pThread, WalkFramesCallback cb)
+static HRESULT WalkFramesUncached(ICorDebugThread *pThread, WalkFramesCallback cb)
 {
     HRESULT Status;
 
@@ -226,6 +229,119 @@ HRESULT WalkFrames(ICorDebugThread *pThread, WalkFramesCallback cb)
     return S_OK;
 }
 
+namespace
+{
+    // Frames chain of thread, walked at current stop. Note, chain could be partial (walk was aborted by callback),
+    // since callers usually need only top frames.
+    struct CachedFrame
+    {
+        FrameType frameType;
+        ToRelease<ICorDebugFrame> iCorFrame;
+        ToRelease<ICorDebugFunction> iCorFunction;
+        std::unique_ptr<NativeFrame> nativeFrame;
+
+        CachedFrame(FrameType frameType, ICorDebugFrame *pFrame, NativeFrame *pNative, ICorDebugFunction *pFunction) :
+            frameType(frameType),
+            iCorFrame(pFrame),
+            iCorFunction(pFunction),
+            nativeFrame(pNative ? new NativeFrame(*pNative) : nullptr)
+        {
+            if (pFrame)
+                pFrame->AddRef();
+            if (pFunction)
+                pFunction->AddRef();
+        }
+        CachedFrame(CachedFrame &&that) = default;
+        CachedFrame(const CachedFrame &that) = delete;
+    };
+
+    struct FramesChain
+    {
+        std::vector<CachedFrame> frames;
+        bool complete;
+
+        FramesChain() : complete(false) {}
+    };
+
+    // Note, all ICorDebugFrame objects are neutered at process continue (include continue for func-eval),
+    // cached chain checked for this before usage, so, cache can't provide frames from previous stop.
+    std::mutex g_framesCacheMutex;
+    std::map<DWORD, std::shared_ptr<const FramesChain>> g_framesCache;
+
+    bool IsFramesChainValid(const FramesChain &chain)
+    {
+        for (auto &frame : chain.frames)
+        {
+            if (!frame.iCorFrame)
+                continue;
+
+            CORDB_ADDRESS startAddr = 0;
+            CORDB_ADDRESS endAddr = 0;
+            return SUCCEEDED(frame.iCorFrame->GetStackRange(&startAddr, &endAddr));
+        }
+        return false;
+    }
+}
+
+void InvalidateFramesCache()
+{
+    std::lock_guard<std::mutex> lock(g_framesCacheMutex);
+    g_framesCache.clear();
+}
+
+HRESULT WalkFrames(ICorDebugThread *pThread, WalkFramesCallback cb)
+{
+    HRESULT Status;
+    DWORD threadId = 0;
+    IfFailRet(pThread->GetID(&threadId));
+
+    std::shared_ptr<const FramesChain> cachedChain;
+    {
+        std::lock_guard<std::mutex> lock(g_framesCacheMutex);
+        auto find = g_framesCache.find(threadId);
+        if (find != g_framesCache.end())
+            cachedChain = find->second;
+    }
+
+    // Note, callback is called without cache lock held, since it could walk frames by itself.
+    size_t delivered = 0;
+    if (cachedChain && IsFramesChainValid(*cachedChain))
+    {
+        for (auto &frame : cachedChain->frames)
+        {
+            if (FAILED(Status = cb(frame.frameType, frame.iCorFrame.GetPtr(), frame.nativeFrame.get(), frame.iCorFunction.GetPtr())))
+                return Status;
+            delivered++;
+        }
+        if (cachedChain->complete)
+            return S_OK;
+    }
+
+    // Walk from the top of stack again, frames already provided to callback from cache are skipped.
+    std::shared_ptr<FramesChain> chain(new FramesChain);
+    size_t current = 0;
+    Status = WalkFramesUncached(pThread, [&](
+        FrameType frameType,
+        ICorDebugFrame *pFrame,
+        NativeFrame *pNative,
+        ICorDebugFunction *pFunction)
+    {
+        chain->frames.emplace_back(frameType, pFrame, pNative, pFunction);
+        if (current++ < delivered)
+            return S_OK;
+        return cb(frameType, pFrame, pNative, pFunction);
+    });
+    chain->complete = SUCCEEDED(Status);
+
+    if (!chain->frames.empty() && (!cachedChain || chain->complete || chain->frames.size() > cachedChain->frames.size()))
+    {
+        std::lock_guard<std::mutex> lock(g_framesCacheMutex);
+        g_framesCache[threadId] = chain;
+    }
+
+    return Status;
+}
+
 HRESULT GetFrameAt(ICorDebugThread *pThread, FrameLevel level, ICorDebugFrame **ppFrame)
 {
     // Try get 0 (current active) frame in fast way, if possible.
@@ -39,6 +39,9 @@ struct Thread;
 HRESULT GetFrameAt(ICorDebugThread *pThread, FrameLevel level, ICorDebugFrame **ppFrame);
 uint64_t GetFrameAddr(ICorDebugFrame *pFrame);
 const char *GetInternalTypeName(CorDebugInternalFrameType frameType);
+// Note, frames chain walked at current stop is cached per thread, so, next walk don't unwind stack again.
 HRESULT WalkFrames(ICorDebugThread *pThread, WalkFramesCallback cb);
+// Drop cached frames chains, must be called before process continue (include continue for func-eval).
+void InvalidateFramesCache();
 
 } // namespace netcoredbg
@@ -0,0 +1,143 @@
+// Copyright (c) 2026 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include "debugger/latency.h"
+
+#include <algorithm>
+
+namespace netcoredbg
+{
+
+static const char *GetOperationName(StopReason reason, IDebugger::StepType stepType)
+{
+    switch (reason)
+    {
+        case StopStep:
+            return stepType == IDebugger::StepType::STEP_IN ? "stepIn" :
+                   stepType == IDebugger::StepType::STEP_OVER ? "stepOver" : "stepOut";
+        case StopBreakpoint:
+            return "breakpoint";
+        case StopException:
+            return "exception";
+        case StopPause:
+            return "pause";
+        case StopEntry:
+            return "entry";
+    }
+    return "";
+}
+
+void LatencyStats::Enable(bool enable)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_enabled = enable;
+    m_requestPending = false;
+}
+
+void LatencyStats::SetStepRequest(IDebugger::StepType stepType, uint64_t requestUs)
+{
+    if (!m_enabled)
+        return;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_requestStepType = stepType;
+    m_requestUs = requestUs;
+    m_requestPending = true;
+}
+
+void LatencyStats::AddStop(StopReason reason, uint64_t queueUs, uint64_t callbackUs, uint64_t symbolsUs, uint64_t emitUs)
+{
+    if (!m_enabled)
+        return;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    // Note, step could be interrupted by other stop event (breakpoint, pause, etc), in this case step request time is dropped.
+    bool stepComplete = reason == StopStep && m_requestPending;
+    Sample sample{stepComplete ? m_requestUs : 0, queueUs, callbackUs, symbolsUs, emitUs};
+    m_requestPending = false;
+
+    m_samples[stepComplete || reason != StopStep ? GetOperationName(reason, m_requestStepType) : "step"].Add(sample);
+}
+
+void LatencyStats::AddCallbackQueue(uint64_t delayUs, size_t depth)
+{
+    if (!m_enabled)
+        return;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_queueDelays.Add(delayUs);
+    m_queueMaxDepth = std::max(m_queueMaxDepth, depth);
+}
+
+// Nearest-rank percentiles.
+static LatencyPercentiles CalculatePercentiles(std::vector<uint64_t> &values)
+{
+    LatencyPercentiles result;
+    if (values.empty())
+        return result;
+
+    std::sort(values.begin(), values.end());
+    auto percentile = [&](unsigned p) -> uint64_t
+    {
+        size_t rank = (values.size() * p + 99) / 100;
+        return values[rank > 0 ? rank - 1 : 0];
+    };
+    result.p50 = percentile(50);
+    result.p90 = percentile(90);
+    result.p99 = percentile(99);
+    result.max = values.back();
+    return result;
+}
+
+void LatencyStats::GetStats(std::vector<StopLatencyStats> &stats, CallbacksQueueStats &queueStats, bool reset)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    stats.clear();
+    for (const auto &entry : m_samples)
+    {
+        const std::vector<Sample> &ring = entry.second.ring;
+
+        std::vector<uint64_t> request, queue, callback, symbols, emit, total;
+        request.reserve(ring.size());
+        queue.reserve(ring.size());
+        callback.reserve(ring.size());
+        symbols.reserve(ring.size());
+        emit.reserve(ring.size());
+        total.reserve(ring.size());
+        for (const Sample &sample : ring)
+        {
+            request.push_back(sample.requestUs);
+            queue.push_back(sample.queueUs);
+            callback.push_back(sample.callbackUs);
+            symbols.push_back(sample.symbolsUs);
+            emit.push_back(sample.emitUs);
+            total.push_back(sample.requestUs + sample.queueUs + sample.callbackUs + sample.symbolsUs + sample.emitUs);
+        }
+
+        stats.emplace_back(entry.first);
+        StopLatencyStats &result = stats.back();
+        result.count = unsigned(ring.size());
+        result.request = CalculatePercentiles(request);
+        result.queue = CalculatePercentiles(queue);
+        result.callback = CalculatePercentiles(callback);
+        result.symbols = CalculatePercentiles(symbols);
+        result.emit = CalculatePercentiles(emit);
+        result.total = CalculatePercentiles(total);
+    }
+
+    std::vector<uint64_t> delays(m_queueDelays.ring);
+    queueStats.count = unsigned(delays.size());
+    queueStats.maxDepth = unsigned(m_queueMaxDepth);
+    queueStats.delay = CalculatePercentiles(delays);
+
+    if (reset)
+    {
+        m_samples.clear();
+        m_queueDelays = Samples<uint64_t>();
+        m_queueMaxDepth = 0;
+    }
+}
+
+} // namespace netcoredbg
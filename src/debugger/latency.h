@@ -0,0 +1,75 @@
+// Copyright (c) 2026 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+#pragma once
+
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "interfaces/idebugger.h"
+
+namespace netcoredbg
+{
+
+// Stop events latency statistics, samples are collected only in case statistics enabled.
+class LatencyStats
+{
+public:
+
+    LatencyStats() : m_enabled(false), m_requestStepType(IDebugger::StepType::STEP_IN), m_requestUs(0), m_requestPending(false), m_queueMaxDepth(0) {}
+
+    void Enable(bool enable);
+    bool IsEnabled() const { return m_enabled; }
+
+    // Step command processing time, accounted in step complete stop event sample.
+    void SetStepRequest(IDebugger::StepType stepType, uint64_t requestUs);
+    void AddStop(StopReason reason, uint64_t queueUs, uint64_t callbackUs, uint64_t symbolsUs, uint64_t emitUs);
+    // Delay of each dispatched managed callback and callbacks queue depth at dispatch.
+    void AddCallbackQueue(uint64_t delayUs, size_t depth);
+    void GetStats(std::vector<StopLatencyStats> &stats, CallbacksQueueStats &queueStats, bool reset);
+
+private:
+
+    struct Sample
+    {
+        uint64_t requestUs;
+        uint64_t queueUs;
+        uint64_t callbackUs;
+        uint64_t symbolsUs;
+        uint64_t emitUs;
+    };
+
+    // Note, only last m_maxSamples samples are kept for each stop reason.
+    static const size_t m_maxSamples = 100000;
+
+    template <typename T> struct Samples
+    {
+        std::vector<T> ring;
+        size_t next;
+
+        Samples() : next(0) {}
+
+        void Add(const T &sample)
+        {
+            if (ring.size() < m_maxSamples)
+                ring.push_back(sample);
+            else
+                ring[next] = sample;
+
+            next = (next + 1) % m_maxSamples;
+        }
+    };
+
+    std::atomic<bool> m_enabled;
+    std::mutex m_mutex;
+    IDebugger::StepType m_requestStepType;
+    uint64_t m_requestUs;
+    bool m_requestPending;
+    std::map<std::string, Samples<Sample>> m_samples;
+    Samples<uint64_t> m_queueDelays;
+    size_t m_queueMaxDepth;
+};
+
+} // namespace netcoredbg
@@ -9,6 +9,7 @@
 #include "debugger/managedcallback.h"
 #include "debugger/threads.h"
 #include "debugger/evalwaiter.h"
+#include "debugger/evalhelpers.h"
 #include "debugger/breakpoint_break.h"
 #include "debugger/breakpoint_entry.h"
 #include "debugger/breakpoints_exception.h"
@@ -22,6 +23,8 @@
 #include "debugger/stepper_async.h"
 #include "debugger/steppers.h"
 #include "debugger/evalstackmachine.h"
+#include "debugger/frames.h"
+#include "debugger/latency.h"
 #include "metadata/modules.h"
 #include "metadata/typeprinter.h"
 #include "interfaces/iprotocol.h"
@@ -32,6 +35,32 @@
 namespace netcoredbg
 {
 
+// Active frame location for stop event, time spent is accounted as symbols lookup in latency statistics.
+void ManagedCallback::GetStopFrameLocation(ICorDebugThread *pThread, ThreadId threadId, StackFrame &stackFrame)
+{
+    auto start = std::chrono::steady_clock::now();
+
+    ToRelease<ICorDebugFrame> iCorFrame;
+    if (SUCCEEDED(pThread->GetActiveFrame(&iCorFrame)) && iCorFrame != nullptr)
+        m_debugger.GetFrameLocation(iCorFrame, threadId, FrameLevel(0), stackFrame);
+
+    m_stopSymbolsUs += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+void ManagedCallback::EmitStoppedEvent(const StoppedEvent &event)
+{
+    auto emitStart = std::chrono::steady_clock::now();
+    m_debugger.m_sharedProtocol->EmitStoppedEvent(event);
+
+    if (!m_debugger.m_uniqueLatencyStats->IsEnabled())
+        return;
+
+    auto emitEnd = std::chrono::steady_clock::now();
+    uint64_t callbackUs = std::chrono::duration_cast<std::chrono::microseconds>(emitStart - m_stopLatencyStart).count();
+    uint64_t emitUs = std::chrono::duration_cast<std::chrono::microseconds>(emitEnd - emitStart).count();
+    m_debugger.m_uniqueLatencyStats->AddStop(event.reason, m_stopQueueUs, callbackUs > m_stopSymbolsUs ? callbackUs - m_stopSymbolsUs : 0, m_stopSymbolsUs, emitUs);
+}
+
 bool ManagedCallback::CallbacksWorkerBreakpoint(ICorDebugAppDomain *pAppDomain, ICorDebugThread *pThread, ICorDebugBreakpoint *pBreakpoint)
 {
     // S_FALSE or error - continue callback.
@@ -44,11 +73,21 @@ bool ManagedCallback::CallbacksWorkerBreakpoint(ICorDebugAppDomain *pAppDomain,
         return false;
 
     bool atEntry = false;
+    SnapshotOptions snapshot;
     ThreadId threadId(getThreadId(pThread));
     StoppedEvent event(StopBreakpoint, threadId);
     // S_FALSE - not error and not affect on callback (callback will emit stop event)
-    if (S_FALSE != m_debugger.m_uniqueBreakpoints->ManagedCallbackBreakpoint(pThread, pBreakpoint, event.breakpoint, atEntry))
+    if (S_FALSE != m_debugger.m_uniqueBreakpoints->ManagedCallbackBreakpoint(pThread, pBreakpoint, event.breakpoint, atEntry, snapshot))
+        return false;
+
+    // Snapshot breakpoint don't stop process and don't affect steppers, capture data and continue.
+    if (snapshot.IsEnabled())
+    {
+        m_snapshotEvents.emplace_back(event.breakpoint.id, threadId);
+        if (FAILED(m_debugger.CaptureSnapshot(pThread, snapshot, m_snapshotEvents.back())))
+            m_snapshotEvents.pop_back();
         return false;
+    }
 
     // Disable all steppers if we stop at breakpoint during step.
     m_debugger.m_uniqueSteppers->DisableAllSteppers(pAppDomain);
@@ -56,12 +95,10 @@ bool ManagedCallback::CallbacksWorkerBreakpoint(ICorDebugAppDomain *pAppDomain,
     if (atEntry)
         event.reason = StopEntry;
 
-    ToRelease<ICorDebugFrame> pFrame;
-    if (SUCCEEDED(pThread->GetActiveFrame(&pFrame)) && pFrame != nullptr)
-        m_debugger.GetFrameLocation(pFrame, threadId, FrameLevel(0), event.frame);
+    GetStopFrameLocation(pThread, threadId, event.frame);
 
     m_debugger.SetLastStoppedThread(pThread);
-    m_debugger.m_sharedProtocol->EmitStoppedEvent(event);
+    EmitStoppedEvent(event);
     m_debugger.m_ioredirect.async_cancel();
     return true;
 }
@@ -75,16 +112,14 @@ bool ManagedCallback::CallbacksWorkerStepComplete(ICorDebugAppDomain *pAppDomain
         return false;
 
     StackFrame stackFrame;
-    ToRelease<ICorDebugFrame> iCorFrame;
     ThreadId threadId(getThreadId(pThread));
-    if (SUCCEEDED(pThread->GetActiveFrame(&iCorFrame)) && iCorFrame != nullptr)
-        m_debugger.GetFrameLocation(iCorFrame, threadId, FrameLevel(0), stackFrame);
+    GetStopFrameLocation(pThread, threadId, stackFrame);
 
     StoppedEvent event(StopStep, threadId);
     event.frame = stackFrame;
 
     m_debugger.SetLastStoppedThread(pThread);
-    m_debugger.m_sharedProtocol->EmitStoppedEvent(event);
+    EmitStoppedEvent(event);
     m_debugger.m_ioredirect.async_cancel();
     return true;
 }
@@ -103,14 +138,11 @@ bool ManagedCallback::CallbacksWorkerBreak(ICorDebugAppDomain *pAppDomain, ICorD
     m_debugger.SetLastStoppedThread(pThread);
     ThreadId threadId(getThreadId(pThread));
     StackFrame stackFrame;
-
-    ToRelease<ICorDebugFrame> iCorFrame;
-    if (SUCCEEDED(pThread->GetActiveFrame(&iCorFrame)) && iCorFrame != nullptr)
-        m_debugger.GetFrameLocation(iCorFrame, threadId, FrameLevel(0), stackFrame);
+    GetStopFrameLocation(pThread, threadId, stackFrame);
 
     StoppedEvent event(StopPause, threadId);
     event.frame = stackFrame;
-    m_debugger.m_sharedProtocol->EmitStoppedEvent(event);
+    EmitStoppedEvent(event);
     m_debugger.m_ioredirect.async_cancel();
     return true;
 }
@@ -126,16 +158,14 @@ bool ManagedCallback::CallbacksWorkerException(ICorDebugAppDomain *pAppDomain, I
     if (S_FALSE != m_debugger.m_uniqueBreakpoints->ManagedCallbackException(pThread, eventType, excModule, event))
         return false;
 
-    ToRelease<ICorDebugFrame> pActiveFrame;
-    if (SUCCEEDED(pThread->GetActiveFrame(&pActiveFrame)) && pActiveFrame != nullptr)
-        m_debugger.GetFrameLocation(pActiveFrame, threadId, FrameLevel(0), event.frame);
+    GetStopFrameLocation(pThread, threadId, event.frame);
 
     // Disable all steppers if we stop during step.
     m_debugger.m_uniqueSteppers->DisableAllSteppers(pAppDomain);
 
     m_debugger.SetLastStoppedThread(pThread);
 
-    m_debugger.m_sharedProtocol->EmitStoppedEvent(event);
+    EmitStoppedEvent(event);
     m_debugger.m_ioredirect.async_cancel();
     return true;
 }
@@ -160,6 +190,11 @@ void ManagedCallback::CallbacksWorker()
         }
 
         auto &c = m_callbacksQueue.front();
+        c.Dispatched = std::chrono::steady_clock::now();
+        m_stopLatencyStart = c.Dispatched;
+        m_stopQueueUs = std::chrono::duration_cast<std::chrono::microseconds>(c.Dispatched - c.Queued).count();
+        m_stopSymbolsUs = 0;
+        m_debugger.m_uniqueLatencyStats->AddCallbackQueue(m_stopQueueUs, m_callbacksQueue.size());
 
         switch (c.Call)
         {
@@ -185,13 +220,30 @@ void ManagedCallback::CallbacksWorker()
         }
 
         ToRelease<ICorDebugAppDomain> iCorAppDomain(c.iCorAppDomain.Detach());
+        c.Reset();
         m_callbacksQueue.pop_front();
 
         // Continue process execution only in case we don't have stop event emitted and queue is empty.
         // We safe here against fast Continue()/AddCallbackToQueue() call from new callback call, since we don't unlock m_callbacksMutex.
         // m_callbacksMutex will be unlocked only in m_callbacksCV.wait(), when CallbacksWorker will be ready for notify_one.
         if (m_callbacksQueue.empty() && !m_stopEventInProcess)
+        {
+            // Frames could be walked during callback processing (conditions, snapshot breakpoints).
+            InvalidateFramesCache();
             iCorAppDomain->Continue(0);
+        }
+
+        // Note, snapshot events are emitted without m_callbacksMutex locked, so, process pause and
+        // new callbacks processing don't depend on protocol output.
+        if (!m_snapshotEvents.empty())
+        {
+            std::vector<SnapshotEvent> snapshotEvents;
+            snapshotEvents.swap(m_snapshotEvents);
+            lock.unlock();
+            for (const SnapshotEvent &snapshotEvent : snapshotEvents)
+                m_debugger.m_sharedProtocol->EmitSnapshotEvent(snapshotEvent);
+            lock.lock();
+        }
     }
 }
 
@@ -290,6 +342,7 @@ HRESULT ManagedCallback::Continue(ICorDebugProcess *pProcess)
 
     assert(m_stopEventInProcess);
     m_stopEventInProcess = false;
+    InvalidateFramesCache();
 
     if (m_callbacksQueue.empty())
         return pProcess->Continue(0);
@@ -327,7 +380,11 @@ HRESULT ManagedCallback::Pause(ICorDebugProcess *pProcess, ThreadId lastStoppedT
     if (!lastStoppedThread)
         return E_INVALIDARG;
 
+    auto pauseStart = std::chrono::steady_clock::now();
     std::unique_lock<std::mutex> lock(m_callbacksMutex);
+    m_stopLatencyStart = pauseStart;
+    m_stopQueueUs = 0;
+    m_stopSymbolsUs = 0;
 
     // Note, in case Stop() failed, no stop event will be emitted, don't set m_stopEventInProcess to "true" in this case.
     HRESULT Status;
@@ -351,7 +408,7 @@ HRESULT ManagedCallback::Pause(ICorDebugProcess *pProcess, ThreadId lastStoppedT
         {
             // VSCode protocol event must provide thread only (VSCode count on this), even if this thread don't have user code.
             m_debugger.SetLastStoppedThreadId(lastStoppedThread);
-            m_debugger.m_sharedProtocol->EmitStoppedEvent(StoppedEvent(StopPause, lastStoppedThread));
+            EmitStoppedEvent(StoppedEvent(StopPause, lastStoppedThread));
             m_debugger.m_ioredirect.async_cancel();
             return S_OK;
         }
@@ -379,7 +436,10 @@ HRESULT ManagedCallback::Pause(ICorDebugProcess *pProcess, ThreadId lastStoppedT
             int totalFrames = 0;
             std::vector<StackFrame> stackFrames;
 
-            if (FAILED(m_debugger.GetStackTrace(thread.id, FrameLevel(0), 0, stackFrames, totalFrames)))
+            auto symbolsStart = std::chrono::steady_clock::now();
+            HRESULT hrStackTrace = m_debugger.GetStackTrace(thread.id, FrameLevel(0), 0, stackFrames, totalFrames);
+            m_stopSymbolsUs += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - symbolsStart).count();
+            if (FAILED(hrStackTrace))
                 continue;
 
             for (const StackFrame& stackFrame : stackFrames)
@@ -390,7 +450,7 @@ HRESULT ManagedCallback::Pause(ICorDebugProcess *pProcess, ThreadId lastStoppedT
                 StoppedEvent event(StopPause, thread.id);
                 event.frame = stackFrame;
                 m_debugger.SetLastStoppedThreadId(thread.id);
-                m_debugger.m_sharedProtocol->EmitStoppedEvent(event);
+                EmitStoppedEvent(event);
                 m_debugger.m_ioredirect.async_cancel();
                 return S_OK;
             }
@@ -408,8 +468,12 @@ ManagedCallback::~ManagedCallback()
     std::unique_lock<std::mutex> lock(m_callbacksMutex);
 
     // Clear queue and do notify_one call with FinishWorker request.
-    m_callbacksQueue.clear();
-    m_callbacksQueue.emplace_front(CallbackQueueCall::FinishWorker, nullptr, nullptr, nullptr, STEP_NORMAL, ExceptionCallbackType::FIRST_CHANCE);
+    while (!m_callbacksQueue.empty())
+    {
+        m_callbacksQueue.front().Reset();
+        m_callbacksQueue.pop_front();
+    }
+    m_callbacksQueue.push_back().Set(CallbackQueueCall::FinishWorker, nullptr, nullptr, nullptr, STEP_NORMAL, ExceptionCallbackType::FIRST_CHANCE);
     m_stopEventInProcess = false; // forced to proceed during brake too
     m_callbacksCV.notify_one(); // notify_one with lock
     lock.unlock();
@@ -490,7 +554,7 @@ HRESULT STDMETHODCALLTYPE ManagedCallback::Breakpoint(ICorDebugAppDomain *pAppDo
         pAppDomain->AddRef();
         pThread->AddRef();
         pBreakpoint->AddRef();
-        m_callbacksQueue.emplace_back(CallbackQueueCall::Breakpoint, pAppDomain, pThread, pBreakpoint, STEP_NORMAL, ExceptionCallbackType::FIRST_CHANCE);
+        m_callbacksQueue.push_back().Set(CallbackQueueCall::Breakpoint, pAppDomain, pThread, pBreakpoint, STEP_NORMAL, ExceptionCallbackType::FIRST_CHANCE);
     });
 }
 
@@ -502,7 +566,7 @@ HRESULT STDMETHODCALLTYPE ManagedCallback::StepComplete(ICorDebugAppDomain *pApp
     {
         pAppDomain->AddRef();
         pThread->AddRef();
-        m_callbacksQueue.emplace_back(CallbackQueueCall::StepComplete, pAppDomain, pThread, nullptr, reason, ExceptionCallbackType::FIRST_CHANCE);
+        m_callbacksQueue.push_back().Set(CallbackQueueCall::StepComplete, pAppDomain, pThread, nullptr, reason, ExceptionCallbackType::FIRST_CHANCE);
     });
 }
 
@@ -513,7 +577,7 @@ HRESULT STDMETHODCALLTYPE ManagedCallback::Break(ICorDebugAppDomain *pAppDomain,
     {
         pAppDomain->AddRef();
         pThread->AddRef();
-        m_callbacksQueue.emplace_back(CallbackQueueCall::Break, pAppDomain, pThread, nullptr, STEP_NORMAL, ExceptionCallbackType::FIRST_CHANCE);
+        m_callbacksQueue.push_back().Set(CallbackQueueCall::Break, pAppDomain, pThread, nullptr, STEP_NORMAL, ExceptionCallbackType::FIRST_CHANCE);
     });
 }
 
@@ -558,10 +622,10 @@ HRESULT STDMETHODCALLTYPE ManagedCallback::CreateProcess(ICorDebugProcess *pProc
         // At this point we have only one domain for sure.
         if (SUCCEEDED(domains->Next(1, &pAppDomain, &domainsFetched)) && domainsFetched == 1)
         {
-            // Don't AddRef() here for pAppDomain! We get it with AddRef() from Next() and will release in m_callbacksQueue by ToRelease destructor.
+            // Don't AddRef() here for pAppDomain! We get it with AddRef() from Next() and will release it by queue entry Reset().
             return AddCallbackToQueue(pAppDomain, [&]()
             {
-                m_callbacksQueue.emplace_back(CallbackQueueCall::CreateProcess, pAppDomain, nullptr, nullptr, STEP_NORMAL, ExceptionCallbackType::FIRST_CHANCE);
+                m_callbacksQueue.push_back().Set(CallbackQueueCall::CreateProcess, pAppDomain, nullptr, nullptr, STEP_NORMAL, ExceptionCallbackType::FIRST_CHANCE);
             });
         }
     }
@@ -597,6 +661,7 @@ HRESULT STDMETHODCALLTYPE ManagedCallback::ExitProcess(ICorDebugProcess *pProces
 #endif // FEATURE_PAL
 
     m_debugger.m_sharedProtocol->EmitExitedEvent(ExitedEvent(exitCode));
+    m_debugger.m_sharedThreads->Clear();
     m_debugger.NotifyProcessExited();
     m_debugger.m_sharedProtocol->EmitTerminatedEvent();
     m_debugger.m_ioredirect.async_cancel();
@@ -611,6 +676,7 @@ HRESULT STDMETHODCALLTYPE ManagedCallback::CreateThread(ICorDebugAppDomain *pApp
         LOGW("Thread was created by user code during evaluation with implicit user code execution.");
 
     ThreadId threadId(getThreadId(pThread));
+    m_debugger.m_sharedThreads->InvalidateThreadName(threadId);
     m_debugger.m_sharedThreads->Add(threadId);
 
     m_debugger.m_sharedProtocol->EmitThreadEvent(ThreadEvent(ThreadStarted, threadId));
@@ -667,6 +733,12 @@ HRESULT STDMETHODCALLTYPE ManagedCallback::LoadModule(ICorDebugAppDomain *pAppDo
 HRESULT STDMETHODCALLTYPE ManagedCallback::UnloadModule(ICorDebugAppDomain *pAppDomain, ICorDebugModule *pModule)
 {
     LogFuncEntry();
+    m_debugger.m_sharedModules->InvalidateTypeLookupCache();
+    m_debugger.m_sharedModules->InvalidateFrameLocationCache();
+    m_debugger.m_sharedEvalHelpers->InvalidateTypeMembersCache();
+    m_debugger.m_sharedEvalHelpers->InvalidateTypeLayoutCache();
+    m_debugger.m_uniqueSteppers->ClearAsyncInfo();
+    TypePrinter::InvalidateCache();
     return ContinueAppDomainWithCallbacksQueue(pAppDomain);
 }
 
@@ -755,6 +827,15 @@ HRESULT STDMETHODCALLTYPE ManagedCallback::ControlCTrap(ICorDebugProcess *pProce
 HRESULT STDMETHODCALLTYPE ManagedCallback::NameChange(ICorDebugAppDomain *pAppDomain, ICorDebugThread *pThread)
 {
     LogFuncEntry();
+
+    // Note, pThread is null in case of AppDomain name change.
+    if (pThread != nullptr)
+    {
+        ThreadId threadId(getThreadId(pThread));
+        if (threadId)
+            m_debugger.m_sharedThreads->InvalidateThreadName(threadId);
+    }
+
     return ContinueAppDomainWithCallbacksQueue(pAppDomain);
 }
 
@@ -884,7 +965,7 @@ HRESULT STDMETHODCALLTYPE ManagedCallback::Exception(ICorDebugAppDomain *pAppDom
 
         pAppDomain->AddRef();
         pThread->AddRef();
-        m_callbacksQueue.emplace_back(CallbackQueueCall::Exception, pAppDomain, pThread, nullptr, STEP_NORMAL, eventType, excModule);
+        m_callbacksQueue.push_back().Set(CallbackQueueCall::Exception, pAppDomain, pThread, nullptr, STEP_NORMAL, eventType, excModule);
     });
 }
 
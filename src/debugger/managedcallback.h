@@ -5,8 +5,9 @@
 #pragma once
 
 #include "debugger/manageddebugger.h"
+#include "utils/ring_buffer.h"
 #include <thread>
-#include <list>
+#include <chrono>
 
 namespace netcoredbg
 {
@@ -47,30 +48,59 @@ class ManagedCallback final : public ICorDebugManagedCallback, ICorDebugManagedC
         CorDebugStepReason Reason;
         ExceptionCallbackType EventType;
         std::string ExcModule;
+        std::chrono::steady_clock::time_point Queued;
+        std::chrono::steady_clock::time_point Dispatched;
 
-        CallbackQueueEntry(CallbackQueueCall call,
-                           ICorDebugAppDomain *pAppDomain,
-                           ICorDebugThread *pThread,
-                           ICorDebugBreakpoint *pBreakpoint,
-                           CorDebugStepReason reason,
-                           ExceptionCallbackType eventType,
-                           const std::string &excModule = "") :
-            Call(call),
-            iCorAppDomain(pAppDomain),
-            iCorThread(pThread),
-            iCorBreakpoint(pBreakpoint),
-            Reason(reason),
-            EventType(eventType),
-            ExcModule(excModule)
+        CallbackQueueEntry() :
+            Call(CallbackQueueCall::FinishWorker),
+            Reason(STEP_NORMAL),
+            EventType(ExceptionCallbackType::FIRST_CHANCE)
         {}
+
+        // Note, entry is stored in pooled slot, all fields must be reassigned here.
+        void Set(CallbackQueueCall call,
+                 ICorDebugAppDomain *pAppDomain,
+                 ICorDebugThread *pThread,
+                 ICorDebugBreakpoint *pBreakpoint,
+                 CorDebugStepReason reason,
+                 ExceptionCallbackType eventType,
+                 const std::string &excModule = "")
+        {
+            Call = call;
+            iCorAppDomain = pAppDomain;
+            iCorThread = pThread;
+            iCorBreakpoint = pBreakpoint;
+            Reason = reason;
+            EventType = eventType;
+            ExcModule.assign(excModule); // reuse slot's string buffer
+            Queued = std::chrono::steady_clock::now();
+        }
+
+        // Release COM objects before slot return to pool.
+        void Reset()
+        {
+            iCorAppDomain.Free();
+            iCorThread.Free();
+            iCorBreakpoint.Free();
+            ExcModule.clear();
+        }
     };
 
     std::mutex m_callbacksMutex;
     std::condition_variable m_callbacksCV;
-    std::list<CallbackQueueEntry> m_callbacksQueue; // Make sure this one initialized before m_callbacksWorker.
+    Utility::RingBuffer<CallbackQueueEntry> m_callbacksQueue; // Make sure this one initialized before m_callbacksWorker.
     bool m_stopEventInProcess; // Make sure this one initialized before m_callbacksWorker.
+    // Current stop event latency data, protected by m_callbacksMutex.
+    std::chrono::steady_clock::time_point m_stopLatencyStart;
+    uint64_t m_stopQueueUs;
+    uint64_t m_stopSymbolsUs; // Make sure this one initialized before m_callbacksWorker.
+    // Captured by snapshot breakpoints, emitted by callbacks worker after process continue.
+    std::vector<SnapshotEvent> m_snapshotEvents; // Make sure this one initialized before m_callbacksWorker.
     std::thread m_callbacksWorker;
 
+    void GetStopFrameLocation(ICorDebugThread *pThread, ThreadId threadId, StackFrame &stackFrame);
+    void EmitStoppedEvent(const StoppedEvent &event);
+
     void CallbacksWorker();
     bool CallbacksWorkerBreakpoint(ICorDebugAppDomain *pAppDomain, ICorDebugThread *pThread, ICorDebugBreakpoint *pBreakpoint);
     bool CallbacksWorkerStepComplete(ICorDebugAppDomain *pAppDomain, ICorDebugThread *pThread, CorDebugStepReason reason);
@@ -85,7 +115,7 @@ class ManagedCallback final : public ICorDebugManagedCallback, ICorDebugManagedC
 public:
 
     ManagedCallback(ManagedDebugger &debugger) :
-        m_refCount(0), m_debugger(debugger), m_stopEventInProcess(false), m_callbacksWorker{&ManagedCallback::CallbacksWorker, this} {}
+        m_refCount(0), m_debugger(debugger), m_callbacksQueue(64), m_stopEventInProcess(false), m_stopQueueUs(0), m_stopSymbolsUs(0), m_callbacksWorker{&ManagedCallback::CallbacksWorker, this} {}
     ~ManagedCallback();
     ULONG GetRefCount();
 
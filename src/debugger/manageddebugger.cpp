@@ -13,7 +13,9 @@
 #include <stdexcept>
 #include <vector>
 #include <map>
+#include <unordered_map>
 #include <fstream>
+#include <algorithm>
 
 #include <sys/types.h>
 #include <sys/stat.h>
@@ -35,6 +37,8 @@
 #include "debugger/hotreloadhelpers.h"
 #include "debugger/manageddebugger.h"
 #include "debugger/managedcallback.h"
+#include "debugger/sampler.h"
+#include "debugger/latency.h"
 #include "debugger/stepper_simple.h"
 #include "debugger/stepper_async.h"
 #include "debugger/steppers.h"
@@ -182,12 +186,16 @@ ManagedDebugger::ManagedDebugger() :
     m_sharedVariables(new Variables(m_sharedEvalHelpers, m_sharedEvaluator, m_sharedEvalStackMachine)),
     m_uniqueSteppers(new Steppers(m_sharedModules, m_sharedEvalHelpers)),
     m_uniqueBreakpoints(new Breakpoints(m_sharedModules, m_sharedEvaluator, m_sharedEvalHelpers, m_sharedVariables)),
+    m_uniqueLatencyStats(new LatencyStats),
     m_managedCallback(nullptr),
     m_justMyCode(true),
     m_stepFiltering(true),
+    m_lazyProperties(false),
     m_hotReload(false),
     m_unregisterToken(nullptr),
     m_processId(0),
+    m_samplingActive(false),
+    m_uniqueSamplingProfile(new SamplingProfile),
     m_ioredirect(
         { IOSystem::unnamed_pipe(), IOSystem::unnamed_pipe(), IOSystem::unnamed_pipe() },
         std::bind(&ManagedDebugger::InputCallback, this, std::placeholders::_1, std::placeholders::_2)
@@ -199,6 +207,7 @@ ManagedDebugger::ManagedDebugger() :
 
 ManagedDebugger::~ManagedDebugger()
 {
+    StopSamplingThread();
 }
 
 HRESULT ManagedDebugger::Initialize()
@@ -312,6 +321,7 @@ HRESULT ManagedDebugger::StepCommand(ThreadId threadId, StepType stepType)
     LogFuncEntry();
 
     std::lock_guard<Utility::RWLock::Reader> guardProcessRWLock(m_debugProcessRWLock.reader);
+    std::lock_guard<std::mutex> lockSample(m_sampleMutex);
     HRESULT Status;
     IfFailRet(CheckDebugProcess(m_iCorProcess, m_processAttachedMutex, m_processAttachedState));
 
@@ -328,6 +338,8 @@ HRESULT ManagedDebugger::StepCommand(ThreadId threadId, StepType stepType)
         return E_FAIL;
     }
 
+    auto requestStart = std::chrono::steady_clock::now();
+
     ToRelease<ICorDebugThread> pThread;
     IfFailRet(m_iCorProcess->GetThread(int(threadId), &pThread));
     IfFailRet(m_uniqueSteppers->SetupStep(pThread, stepType));
@@ -336,6 +348,9 @@ HRESULT ManagedDebugger::StepCommand(ThreadId threadId, StepType stepType)
     FrameId::invalidate(); // Clear all created during break frames.
     m_sharedProtocol->EmitContinuedEvent(threadId); // VSCode protocol need thread ID.
 
+    // Note, must be set before process continue, since stop event could be emitted at any moment after.
+    m_uniqueLatencyStats->SetStepRequest(stepType, std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - requestStart).count());
+
     // Note, process continue must be after event emitted, since we could get new stop event from queue here.
     if (FAILED(Status = m_managedCallback->Continue(m_iCorProcess)))
         LOGE("Continue failed: %s", errormessage(Status));
@@ -348,6 +363,7 @@ HRESULT ManagedDebugger::Continue(ThreadId threadId)
     LogFuncEntry();
 
     std::lock_guard<Utility::RWLock::Reader> guardProcessRWLock(m_debugProcessRWLock.reader);
+    std::lock_guard<std::mutex> lockSample(m_sampleMutex);
     HRESULT Status;
     IfFailRet(CheckDebugProcess(m_iCorProcess, m_processAttachedMutex, m_processAttachedState));
 
@@ -380,6 +396,7 @@ HRESULT ManagedDebugger::Pause(ThreadId lastStoppedThread)
     LogFuncEntry();
 
     std::lock_guard<Utility::RWLock::Reader> guardProcessRWLock(m_debugProcessRWLock.reader);
+    std::lock_guard<std::mutex> lockSample(m_sampleMutex);
     HRESULT Status;
     IfFailRet(CheckDebugProcess(m_iCorProcess, m_processAttachedMutex, m_processAttachedState));
 
@@ -769,9 +786,15 @@ HRESULT ManagedDebugger::TerminateProcess()
 
 void ManagedDebugger::Cleanup()
 {
+    StopSamplingThread();
     m_sharedModules->CleanupAllModules();
     m_sharedEvalHelpers->Cleanup();
+    m_uniqueSteppers->ClearAsyncInfo();
+    TypePrinter::InvalidateCache();
+    InvalidateFramesCache();
     m_sharedVariables->Clear(); // Important, must be sync with MIProtocol m_vars.clear()
+    m_sharedVariables->ClearValuesHistory();
+    m_sharedThreads->Clear();
     m_sharedProtocol->Cleanup();
 
     std::lock_guard<Utility::RWLock::Writer> guardProcessRWLock(m_debugProcessRWLock.writer);
@@ -913,6 +936,36 @@ HRESULT ManagedDebugger::AllBreakpointsActivate(bool act)
     return m_uniqueBreakpoints->AllBreakpointsActivate(act);
 }
 
+static HRESULT GetFrameLocationKey(ICorDebugFrame *pFrame, ICorDebugFunction *pFunc, ICorDebugModule *pModule,
+                                   mdMethodDef methodToken, Modules::FrameLocationKey &key)
+{
+    HRESULT Status;
+    IfFailRet(pModule->GetBaseAddress(&key.modAddress));
+    key.methodToken = methodToken;
+
+    ToRelease<ICorDebugCode> pCode;
+    IfFailRet(pFunc->GetILCode(&pCode));
+    IfFailRet(pCode->GetVersionNumber(&key.methodVersion));
+
+    ToRelease<ICorDebugILFrame> pILFrame;
+    IfFailRet(pFrame->QueryInterface(IID_ICorDebugILFrame, (LPVOID*) &pILFrame));
+    CorDebugMappingResult mappingResult;
+    return pILFrame->GetIP(&key.ilOffset, &mappingResult);
+}
+
+static bool HasGenericArgs(ICorDebugFrame *pFrame)
+{
+    ToRelease<ICorDebugILFrame2> pILFrame2;
+    ToRelease<ICorDebugTypeEnum> pTypeEnum;
+    ULONG count = 0;
+    if (FAILED(pFrame->QueryInterface(IID_ICorDebugILFrame2, (LPVOID*) &pILFrame2)) ||
+        FAILED(pILFrame2->EnumerateTypeParameters(&pTypeEnum)) ||
+        FAILED(pTypeEnum->GetCount(&count)))
+        return true;
+
+    return count > 0;
+}
+
 static HRESULT InternalGetFrameLocation(ICorDebugFrame *pFrame, Modules *pModules, bool hotReload, ThreadId threadId, FrameLevel level, StackFrame &stackFrame, bool hotReloadAwareCaller)
 {
     HRESULT Status;
@@ -960,10 +1013,31 @@ static HRESULT InternalGetFrameLocation(ICorDebugFrame *pFrame, Modules *pModule
 
     stackFrame = StackFrame(threadId, level, "");
 
-    ULONG32 ilOffset;
-    Modules::SequencePoint sp;
-    if (SUCCEEDED(pModules->GetFrameILAndSequencePoint(pFrame, ilOffset, sp)))
+    mdMethodDef methodToken;
+    IfFailRet(pFrame->GetFunctionToken(&methodToken));
+
+    // Note, location is pure function of module, method token, executed method version and IL offset,
+    // so, frames of many threads stopped in same methods share cached location.
+    Modules::FrameLocationKey locationKey;
+    Modules::FrameLocation location;
+    uint64_t cacheGeneration = 0;
+    ULONG32 ilOffset = 0;
+    bool cacheable = SUCCEEDED(GetFrameLocationKey(pFrame, pFunc, pModule, methodToken, locationKey));
+    if (cacheable)
+        ilOffset = locationKey.ilOffset;
+    if (!cacheable || !pModules->GetFrameLocationFromCache(locationKey, location, cacheGeneration))
+    {
+        location.hasSequencePoint = SUCCEEDED(pModules->GetFrameILAndSequencePoint(pFrame, ilOffset, location.sequencePoint));
+        IfFailRet(GetModuleId(pModule, location.moduleId));
+        if (!HasGenericArgs(pFrame))
+            TypePrinter::GetMethodName(pFrame, location.methodName);
+        if (cacheable)
+            pModules->AddFrameLocationToCache(locationKey, location, cacheGeneration);
+    }
+
+    if (location.hasSequencePoint)
     {
+        const Modules::SequencePoint &sp = location.sequencePoint;
         stackFrame.source = Source(sp.document);
         stackFrame.line = sp.startLine;
         stackFrame.column = sp.startColumn;
@@ -971,15 +1045,12 @@ static HRESULT InternalGetFrameLocation(ICorDebugFrame *pFrame, Modules *pModule
         stackFrame.endColumn = sp.endColumn;
     }
 
-    mdMethodDef methodToken;
-    IfFailRet(pFrame->GetFunctionToken(&methodToken));
-
     ULONG32 nOffset = 0;
     ToRelease<ICorDebugNativeFrame> pNativeFrame;
     IfFailRet(pFrame->QueryInterface(IID_ICorDebugNativeFrame, (LPVOID*) &pNativeFrame));
     IfFailRet(pNativeFrame->GetIP(&nOffset));
 
-    IfFailRet(GetModuleId(pModule, stackFrame.moduleId));
+    stackFrame.moduleId = location.moduleId;
 
     stackFrame.clrAddr.methodToken = methodToken;
     stackFrame.clrAddr.ilOffset = ilOffset;
@@ -995,7 +1066,10 @@ static HRESULT InternalGetFrameLocation(ICorDebugFrame *pFrame, Modules *pModule
     else
         stackFrame.activeStatementFlags |= StackFrame::ActiveStatementFlags::Stale;
 
-    TypePrinter::GetMethodName(pFrame, stackFrame.name);
+    if (!location.methodName.empty())
+        stackFrame.name = location.methodName;
+    else
+        TypePrinter::GetMethodName(pFrame, stackFrame.name);
 
     return S_OK;
 }
@@ -1026,7 +1100,7 @@ static HRESULT InternalGetStackTrace(Modules *pModules, bool hotReload, ICorDebu
             stackFrames.back().activeStatementFlags |= StackFrame::ActiveStatementFlags::NonLeafFrame;
     };
 
-    IfFailRet(WalkFrames(pThread, [&](
+    if (FAILED(Status = WalkFrames(pThread, [&](
         FrameType frameType,
         ICorDebugFrame *pFrame,
         NativeFrame *pNative,
@@ -1036,8 +1110,10 @@ static HRESULT InternalGetStackTrace(Modules *pModules, bool hotReload, ICorDebu
 
         if (currentFrame < int(startFrame))
             return S_OK;
+        // Note, stack could be really deep (for example, in case of recursion), don't unwind it after requested
+        // frames only in order to count frames, enough to know that at least one frame exists after requested range.
         if (maxFrames != 0 && currentFrame >= int(startFrame) + int(maxFrames))
-            return S_OK;
+            return E_ABORT; // Fast exit from cycle.
 
         switch(frameType)
         {
@@ -1083,9 +1159,12 @@ static HRESULT InternalGetStackTrace(Modules *pModules, bool hotReload, ICorDebu
         }
 
         return S_OK;
-    }));
+    })) && Status != E_ABORT)
+    {
+        return Status;
+    }
 
-    totalFrames = currentFrame + 1;
+    totalFrames = Status == E_ABORT ? -1 : currentFrame + 1;
 
     return S_OK;
 }
@@ -1103,6 +1182,250 @@ HRESULT ManagedDebugger::GetStackTrace(ThreadId  threadId, FrameLevel startFrame
     return InternalGetStackTrace(m_sharedModules.get(), m_hotReload, pThread, startFrame, maxFrames, stackFrames, totalFrames, hotReloadAwareCaller);
 }
 
+// Capture top frames and its variables for snapshot breakpoint, must be called from managed callback (process stopped).
+// Note, capture is interrupted by time and size budgets, since process continue only after capture finished,
+// time budget include stack walk.
+HRESULT ManagedDebugger::CaptureSnapshot(ICorDebugThread *pThread, const SnapshotOptions &options, SnapshotEvent &event)
+{
+    auto captureStart = std::chrono::steady_clock::now();
+    auto deadline = captureStart + std::chrono::milliseconds(options.maxTimeMs);
+
+    HRESULT Status;
+    int totalFrames = 0;
+    std::vector<StackFrame> stackFrames;
+    IfFailRet(InternalGetStackTrace(m_sharedModules.get(), m_hotReload, pThread, FrameLevel{0}, options.frames, stackFrames, totalFrames, false));
+    if (std::chrono::steady_clock::now() > deadline)
+        event.truncated = true;
+
+    size_t bytesBudget = options.maxBytes;
+    for (StackFrame &stackFrame : stackFrames)
+    {
+        event.frames.emplace_back();
+        SnapshotFrame &snapshotFrame = event.frames.back();
+        snapshotFrame.frame = std::move(stackFrame);
+
+        if (event.truncated || snapshotFrame.frame.clrAddr.methodToken == 0) // Not managed frame.
+            continue;
+
+        if (m_sharedVariables->CaptureSnapshotVariables(pThread, snapshotFrame.frame.GetLevel(), options.depth,
+                                                        bytesBudget, deadline, snapshotFrame.variables) == S_FALSE)
+            event.truncated = true;
+    }
+
+    event.captureUs = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - captureStart).count();
+    return S_OK;
+}
+
+// Stacks are equal in case all frames are same code positions (IL offset for managed frames).
+static std::string GetStackKey(const std::vector<StackFrame> &stackFrames)
+{
+    std::ostringstream ss;
+    for (const StackFrame &stackFrame : stackFrames)
+    {
+        ss << stackFrame.moduleId << "!" << stackFrame.clrAddr.methodToken << ":" << stackFrame.clrAddr.methodVersion
+           << "+" << stackFrame.clrAddr.ilOffset << " " << stackFrame.name << "\n";
+    }
+    return ss.str();
+}
+
+HRESULT ManagedDebugger::GetThreadsStackTraces(unsigned maxFrames, ThreadsStackCallback cb)
+{
+    LogFuncEntry();
+
+    std::lock_guard<Utility::RWLock::Reader> guardProcessRWLock(m_debugProcessRWLock.reader);
+    HRESULT Status;
+    IfFailRet(CheckDebugProcess(m_iCorProcess, m_processAttachedMutex, m_processAttachedState));
+
+    std::vector<ThreadId> threadIds;
+    IfFailRet(m_sharedThreads->GetThreadIds(threadIds));
+
+    struct StackGroup
+    {
+        std::vector<ThreadId> threads;
+        std::vector<StackFrame> stackFrames;
+    };
+    std::vector<StackGroup> groups;
+    std::unordered_map<std::string, size_t> groupsIndex;
+
+    // Note, all threads walked at same stop, so, frames locations of different threads (usually, same methods
+    // in thread pool or framework code) are symbolized once and reused from frame location cache.
+    for (const ThreadId &threadId : threadIds)
+    {
+        ToRelease<ICorDebugThread> pThread;
+        int totalFrames = 0;
+        std::vector<StackFrame> stackFrames;
+        if (FAILED(m_iCorProcess->GetThread(int(threadId), &pThread)) ||
+            FAILED(InternalGetStackTrace(m_sharedModules.get(), m_hotReload, pThread, FrameLevel{0}, maxFrames, stackFrames, totalFrames, false)))
+            continue;
+
+        auto emplaceResult = groupsIndex.emplace(GetStackKey(stackFrames), groups.size());
+        if (emplaceResult.second)
+        {
+            groups.emplace_back();
+            groups.back().stackFrames = std::move(stackFrames);
+        }
+        groups[emplaceResult.first->second].threads.push_back(threadId);
+    }
+
+    // Biggest groups first, since they are most interesting in case of hang investigation.
+    std::stable_sort(groups.begin(), groups.end(), [](const StackGroup &lhs, const StackGroup &rhs)
+    {
+        return lhs.threads.size() > rhs.threads.size();
+    });
+
+    for (const StackGroup &group : groups)
+    {
+        cb(group.threads, group.stackFrames);
+    }
+
+    return S_OK;
+}
+
+HRESULT ManagedDebugger::StartSampling(unsigned intervalMs)
+{
+    LogFuncEntry();
+
+    if (intervalMs == 0)
+        return E_INVALIDARG;
+
+    std::lock_guard<Utility::RWLock::Reader> guardProcessRWLock(m_debugProcessRWLock.reader);
+    HRESULT Status;
+    IfFailRet(CheckDebugProcess(m_iCorProcess, m_processAttachedMutex, m_processAttachedState));
+
+    std::lock_guard<std::mutex> lock(m_samplingMutex);
+    if (m_samplingActive || m_samplingThread.joinable())
+        return E_FAIL; // Already started.
+
+    m_uniqueSamplingProfile->Reset(intervalMs);
+    m_samplingActive = true;
+    m_samplingThread = std::thread(&ManagedDebugger::SamplingWorker, this, intervalMs);
+    return S_OK;
+}
+
+HRESULT ManagedDebugger::StopSampling(SamplingFormat format, std::string &profile, SamplingStats &stats)
+{
+    LogFuncEntry();
+
+    {
+        std::lock_guard<std::mutex> lock(m_samplingMutex);
+        if (!m_samplingActive)
+            return E_FAIL; // Not started.
+    }
+
+    StopSamplingThread();
+    m_uniqueSamplingProfile->Format(format, profile);
+    m_uniqueSamplingProfile->GetStats(stats);
+    return S_OK;
+}
+
+HRESULT ManagedDebugger::EnableLatencyStats(bool enable)
+{
+    LogFuncEntry();
+
+    m_uniqueLatencyStats->Enable(enable);
+    return S_OK;
+}
+
+HRESULT ManagedDebugger::GetLatencyStats(bool reset, std::vector<StopLatencyStats> &stats, CallbacksQueueStats &queueStats,
+                                         TypeObjectCacheStats &typeObjectCacheStats)
+{
+    LogFuncEntry();
+
+    m_uniqueLatencyStats->GetStats(stats, queueStats, reset);
+    m_sharedEvalHelpers->GetTypeObjectCacheStats(typeObjectCacheStats, reset);
+    return S_OK;
+}
+
+void ManagedDebugger::StopSamplingThread()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_samplingMutex);
+        m_samplingActive = false;
+    }
+    m_samplingCV.notify_one();
+
+    if (m_samplingThread.joinable())
+        m_samplingThread.join();
+}
+
+void ManagedDebugger::SamplingWorker(unsigned intervalMs)
+{
+    std::unique_lock<std::mutex> lock(m_samplingMutex);
+    while (!m_samplingCV.wait_for(lock, std::chrono::milliseconds(intervalMs), [this]{ return !m_samplingActive; }))
+    {
+        lock.unlock();
+        HRESULT Status;
+        if (FAILED(Status = TakeSample()))
+        {
+            // Note, most likely process exited or detached, collected samples are still available by StopSampling().
+            LOGE("Sampling stopped: %s", errormessage(Status));
+            return;
+        }
+        lock.lock();
+    }
+}
+
+// Stop process, capture managed frames names of all threads and continue process.
+// Note, user Pause/Continue/Step commands wait for sample end (see m_sampleMutex), so, sampler's stop-continue cycle
+// is not visible for user: pause is not lost and no continue is done for process, stopped by sampler.
+HRESULT ManagedDebugger::TakeSample()
+{
+    std::lock_guard<Utility::RWLock::Reader> guardProcessRWLock(m_debugProcessRWLock.reader);
+    std::lock_guard<std::mutex> lockSample(m_sampleMutex);
+    HRESULT Status;
+    IfFailRet(CheckDebugProcess(m_iCorProcess, m_processAttachedMutex, m_processAttachedState));
+
+    auto pauseStart = std::chrono::steady_clock::now();
+    IfFailRet(m_managedCallback->Stop(m_iCorProcess));
+    if (Status == S_FALSE) // Already stopped (by user or debugger event), nothing executed in this interval.
+        return S_OK;
+
+    std::vector<std::vector<std::string>> stacks;
+    std::vector<ThreadId> threadIds;
+    if (SUCCEEDED(m_sharedThreads->GetThreadIds(threadIds)))
+    {
+        for (const ThreadId &threadId : threadIds)
+        {
+            ToRelease<ICorDebugThread> pThread;
+            if (FAILED(m_iCorProcess->GetThread(int(threadId), &pThread)))
+                continue;
+
+            std::vector<std::string> frames;
+            WalkFrames(pThread, [&](FrameType frameType, ICorDebugFrame *pFrame, NativeFrame *pNative, ICorDebugFunction *pFunction)
+            {
+                // Note, only managed frames are symbolized, names are taken from frame location cache in most cases.
+                if (frameType == FrameCLRManaged)
+                {
+                    StackFrame stackFrame;
+                    if (SUCCEEDED(InternalGetFrameLocation(pFrame, m_sharedModules.get(), m_hotReload, threadId, FrameLevel{0}, stackFrame, false)))
+                        frames.push_back(stackFrame.name);
+                }
+                else if (frameType == FrameCLRNative)
+                    frames.push_back("[Native Frame]");
+
+                return S_OK;
+            });
+
+            if (frames.empty())
+                continue;
+
+            std::reverse(frames.begin(), frames.end()); // Root frame first.
+            stacks.push_back(std::move(frames));
+        }
+    }
+
+    IfFailRet(m_managedCallback->Continue(m_iCorProcess));
+    uint64_t pauseUs = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - pauseStart).count();
+
+    for (const auto &frames : stacks)
+    {
+        m_uniqueSamplingProfile->AddStack(frames);
+    }
+    m_uniqueSamplingProfile->AddPause(pauseUs);
+
+    return S_OK;
+}
+
 int ManagedDebugger::GetNamedVariables(uint32_t variablesReference)
 {
     LogFuncEntry();
@@ -1137,7 +1460,29 @@ HRESULT ManagedDebugger::GetScopes(FrameId frameId, std::vector<Scope> &scopes)
     return m_sharedVariables->GetScopes(m_iCorProcess, frameId, scopes);
 }
 
-HRESULT ManagedDebugger::Evaluate(FrameId frameId, const std::string &expression, Variable &variable, std::string &output)
+HRESULT ManagedDebugger::Evaluate(FrameId frameId, const std::string &expression, Variable &variable, std::string &output, bool truncateStrings)
+{
+    LogFuncEntry();
+
+    std::lock_guard<Utility::RWLock::Reader> guardProcessRWLock(m_debugProcessRWLock.reader);
+    HRESULT Status;
+    IfFailRet(CheckDebugProcess(m_iCorProcess, m_processAttachedMutex, m_processAttachedState));
+
+    return m_sharedVariables->Evaluate(m_iCorProcess, frameId, expression, variable, output, truncateStrings);
+}
+
+HRESULT ManagedDebugger::ReadStringValue(FrameId frameId, const std::string &expression, int offset, int count, std::string &value, int &totalLength, int &readLength, std::string &output)
+{
+    LogFuncEntry();
+
+    std::lock_guard<Utility::RWLock::Reader> guardProcessRWLock(m_debugProcessRWLock.reader);
+    HRESULT Status;
+    IfFailRet(CheckDebugProcess(m_iCorProcess, m_processAttachedMutex, m_processAttachedState));
+
+    return m_sharedVariables->ReadStringValue(m_iCorProcess, frameId, expression, offset, count, value, totalLength, readLength, output);
+}
+
+HRESULT ManagedDebugger::ReadMemory(uint64_t address, uint32_t count, std::vector<uint8_t> &data, uint32_t &unreadableBytes)
 {
     LogFuncEntry();
 
@@ -1145,7 +1490,39 @@ HRESULT ManagedDebugger::Evaluate(FrameId frameId, const std::string &expression
     HRESULT Status;
     IfFailRet(CheckDebugProcess(m_iCorProcess, m_processAttachedMutex, m_processAttachedState));
 
-    return m_sharedVariables->Evaluate(m_iCorProcess, frameId, expression, variable, output);
+    // Note, requested count is limited, since data must be sent in one protocol message. Rest of memory is not
+    // reported as unreadable, client should request it by next call with offset.
+    static const uint32_t maxReadSize = 1024 * 1024;
+    uint32_t readSize = std::min(count, maxReadSize);
+    data.resize(readSize);
+
+    SIZE_T read = 0;
+    if (SUCCEEDED(m_iCorProcess->ReadMemory(address, readSize, data.data(), &read)) && read == readSize)
+    {
+        unreadableBytes = 0;
+        return S_OK;
+    }
+
+    // Part of requested memory could be unreadable, read page by page in this case.
+    // Stop at first unreadable page and report rest as unreadable bytes.
+    static const uint64_t pageSize = 4096;
+    uint32_t readTotal = 0;
+    while (readTotal < readSize)
+    {
+        uint64_t currentAddress = address + readTotal;
+        uint32_t chunkSize = (uint32_t)std::min<uint64_t>(readSize - readTotal, pageSize - currentAddress % pageSize);
+        read = 0;
+        if (FAILED(m_iCorProcess->ReadMemory(currentAddress, chunkSize, &data[readTotal], &read)) || read == 0)
+            break;
+
+        readTotal += (uint32_t)read;
+        if (read < chunkSize)
+            break;
+    }
+
+    data.resize(readTotal);
+    unreadableBytes = readSize - readTotal;
+    return S_OK;
 }
 
 void ManagedDebugger::CancelEvalRunning()
@@ -1311,6 +1688,22 @@ void ManagedDebugger::SetStepFiltering(bool enable)
     m_uniqueSteppers->SetStepFiltering(enable);
 }
 
+void ManagedDebugger::SetLazyProperties(bool enable)
+{
+    m_lazyProperties = enable;
+    m_sharedVariables->SetLazyProperties(enable);
+}
+
+void ManagedDebugger::SetGroupHugeArrays(bool enable)
+{
+    m_sharedVariables->SetGroupHugeArrays(enable);
+}
+
+HRESULT ManagedDebugger::SetTypeObjectCacheCapacity(unsigned capacity)
+{
+    return m_sharedEvalHelpers->SetTypeObjectCacheCapacity(capacity);
+}
+
 HRESULT ManagedDebugger::SetHotReload(bool enable)
 {
     std::lock_guard<Utility::RWLock::Reader> guardProcessRWLock(m_debugProcessRWLock.reader);
@@ -1431,6 +1824,9 @@ HRESULT ManagedDebugger::HotReloadApplyDeltas(const std::string &dllFileName, co
     bool continueProcess = (Status == S_OK); // Was stopped by m_managedCallback->Stop() call.
 
     IfFailRet(ApplyMetadataAndILDeltas(m_sharedModules.get(), dllFileName, deltaMD, deltaIL));
+    // Metadata delta could add new members to types.
+    m_sharedEvalHelpers->InvalidateTypeMembersCache();
+    TypePrinter::InvalidateCache();
     std::string updatedDLL;
     std::unordered_set<mdTypeDef> updatedTypeTokens;
     IfFailRet(ApplyPdbDeltaAndLineUpdates(dllFileName, deltaPDB, lineUpdates, updatedDLL, updatedTypeTokens));
@@ -9,6 +9,7 @@
 #include <vector>
 #include <map>
 #include <set>
+#include <thread>
 #include "interfaces/idebugger.h"
 #include "debugger/dbgshim.h"
 #include "utils/string_view.h"
@@ -33,6 +34,8 @@ class Variables;
 class ManagedCallback;
 class Breakpoints;
 class Modules;
+class SamplingProfile;
+class LatencyStats;
 
 enum class ProcessAttachedState
 {
@@ -81,6 +84,7 @@ private:
     std::shared_ptr<Variables> m_sharedVariables;
     std::unique_ptr<Steppers> m_uniqueSteppers;
     std::unique_ptr<Breakpoints> m_uniqueBreakpoints;
+    std::unique_ptr<LatencyStats> m_uniqueLatencyStats; // Note, used by m_managedCallback, must be destroyed after it.
     std::unique_ptr<ManagedCallback> m_managedCallback;
 
     Utility::RWLock m_debugProcessRWLock;
@@ -89,6 +93,7 @@ private:
 
     bool m_justMyCode;
     bool m_stepFiltering;
+    bool m_lazyProperties;
     bool m_hotReload;
 
     PVOID m_unregisterToken;
@@ -108,6 +113,7 @@ private:
     void DisableAllBreakpointsAndSteppers();
 
     HRESULT GetFrameLocation(ICorDebugFrame *pFrame, ThreadId threadId, FrameLevel level, StackFrame &stackFrame);
+    HRESULT CaptureSnapshot(ICorDebugThread *pThread, const SnapshotOptions &options, SnapshotEvent &event);
 
     HRESULT RunProcess(const std::string& fileExec, const std::vector<std::string>& execArgs);
     HRESULT AttachToProcess(DWORD pid);
@@ -118,6 +124,18 @@ private:
 
     HRESULT SetEnableCustomNotification(BOOL fEnable);
 
+    std::mutex m_samplingMutex;
+    // Serialize sampler's process stop-continue cycle with user Pause, Continue and Step commands.
+    std::mutex m_sampleMutex;
+    std::condition_variable m_samplingCV;
+    bool m_samplingActive;
+    std::thread m_samplingThread;
+    std::unique_ptr<SamplingProfile> m_uniqueSamplingProfile;
+
+    void SamplingWorker(unsigned intervalMs);
+    HRESULT TakeSample();
+    void StopSamplingThread();
+
     HRESULT FindEvalCapableThread(ToRelease<ICorDebugThread> &pThread);
     HRESULT ApplyPdbDeltaAndLineUpdates(const std::string &dllFileName, const std::string &deltaPDB, const std::string &lineUpdates,
                                         std::string &updatedDLL, std::unordered_set<mdTypeDef> &updatedTypeTokens);
@@ -130,6 +148,10 @@ public:
     void SetJustMyCode(bool enable) override;
     bool IsStepFiltering() const override { return m_stepFiltering; }
     void SetStepFiltering(bool enable) override;
+    bool IsLazyProperties() const override { return m_lazyProperties; }
+    void SetLazyProperties(bool enable) override;
+    void SetGroupHugeArrays(bool enable) override;
+    HRESULT SetTypeObjectCacheCapacity(unsigned capacity) override;
     bool IsHotReload() const override { return m_hotReload; }
     HRESULT SetHotReload(bool enable) override;
 
@@ -153,11 +175,19 @@ public:
     void EnumerateBreakpoints(std::function<bool (const IDebugger::BreakpointInfo&)>&& callback) override;
     HRESULT AllBreakpointsActivate(bool act) override;
     HRESULT GetStackTrace(ThreadId threadId, FrameLevel startFrame, unsigned maxFrames, std::vector<StackFrame> &stackFrames, int &totalFrames, bool hotReloadAwareCaller = false) override;
+    HRESULT GetThreadsStackTraces(unsigned maxFrames, ThreadsStackCallback cb) override;
+    HRESULT StartSampling(unsigned intervalMs) override;
+    HRESULT StopSampling(SamplingFormat format, std::string &profile, SamplingStats &stats) override;
+    HRESULT EnableLatencyStats(bool enable) override;
+    HRESULT GetLatencyStats(bool reset, std::vector<StopLatencyStats> &stats, CallbacksQueueStats &queueStats,
+                            TypeObjectCacheStats &typeObjectCacheStats) override;
     HRESULT StepCommand(ThreadId threadId, StepType stepType) override;
     HRESULT GetScopes(FrameId frameId, std::vector<Scope> &scopes) override;
     HRESULT GetVariables(uint32_t variablesReference, VariablesFilter filter, int start, int count, std::vector<Variable> &variables) override;
     int GetNamedVariables(uint32_t variablesReference) override;
-    HRESULT Evaluate(FrameId frameId, const std::string &expression, Variable &variable, std::string &output) override;
+    HRESULT Evaluate(FrameId frameId, const std::string &expression, Variable &variable, std::string &output, bool truncateStrings) override;
+    HRESULT ReadStringValue(FrameId frameId, const std::string &expression, int offset, int count, std::string &value, int &totalLength, int &readLength, std::string &output) override;
+    HRESULT ReadMemory(uint64_t address, uint32_t count, std::vector<uint8_t> &data, uint32_t &unreadableBytes) override;
     void CancelEvalRunning() override;
     HRESULT SetVariable(const std::string &name, const std::string &value, uint32_t ref, std::string &output) override;
     HRESULT SetExpression(FrameId frameId, const std::string &expression, int evalFlags, const std::string &value, std::string &output) override;
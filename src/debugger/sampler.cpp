@@ -0,0 +1,146 @@
+// Copyright (c) 2026 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include "debugger/sampler.h"
+
+#include <algorithm>
+#include <sstream>
+
+namespace netcoredbg
+{
+
+void SamplingProfile::Reset(unsigned intervalMs)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_intervalMs = intervalMs;
+    m_stats = SamplingStats();
+    m_framesIndex.clear();
+    m_frames.clear();
+    m_stacks.clear();
+}
+
+void SamplingProfile::AddStack(const std::vector<std::string> &frames)
+{
+    if (frames.empty())
+        return;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::vector<size_t> stack;
+    stack.reserve(frames.size());
+    for (const std::string &frame : frames)
+    {
+        auto emplaceResult = m_framesIndex.emplace(frame, m_frames.size());
+        if (emplaceResult.second)
+            m_frames.push_back(frame);
+        stack.push_back(emplaceResult.first->second);
+    }
+    m_stacks[stack]++;
+}
+
+void SamplingProfile::AddPause(uint64_t pauseUs)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stats.samples++;
+    m_stats.pauseTotalUs += pauseUs;
+    m_stats.pauseMaxUs = std::max(m_stats.pauseMaxUs, pauseUs);
+}
+
+void SamplingProfile::GetStats(SamplingStats &stats)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    stats = m_stats;
+}
+
+void SamplingProfile::Format(SamplingFormat format, std::string &output)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (format == SamplingFormat::Speedscope)
+        FormatSpeedscope(output);
+    else
+        FormatCollapsed(output);
+}
+
+void SamplingProfile::FormatCollapsed(std::string &output)
+{
+    std::ostringstream ss;
+    for (const auto &entry : m_stacks)
+    {
+        const char *sep = "";
+        for (size_t frameIndex : entry.first)
+        {
+            // Note, `;` is frames separator in this format.
+            std::string name = m_frames[frameIndex];
+            std::replace(name.begin(), name.end(), ';', ':');
+            ss << sep << name;
+            sep = ";";
+        }
+        ss << " " << entry.second << "\n";
+    }
+    output = ss.str();
+}
+
+static std::string EscapeJsonString(const std::string &str)
+{
+    std::ostringstream ss;
+    for (char c : str)
+    {
+        switch (c)
+        {
+        case '"':  ss << "\\\""; break;
+        case '\\': ss << "\\\\"; break;
+        case '\n': ss << "\\n"; break;
+        case '\r': ss << "\\r"; break;
+        case '\t': ss << "\\t"; break;
+        default:
+            if ((unsigned char)c < 0x20)
+            {
+                static const char hex[] = "0123456789abcdef";
+                ss << "\\u00" << hex[(c >> 4) & 0xf] << hex[c & 0xf];
+            }
+            else
+                ss << c;
+        }
+    }
+    return ss.str();
+}
+
+// https://github.com/jlfwong/speedscope/wiki/Importing-from-custom-sources
+// Each unique stack is one sample with weight, that is time of all its samples.
+void SamplingProfile::FormatSpeedscope(std::string &output)
+{
+    std::ostringstream ss;
+    ss << "{\"$schema\":\"https://www.speedscope.app/file-format-schema.json\",\"shared\":{\"frames\":[";
+    const char *sep = "";
+    for (const std::string &frame : m_frames)
+    {
+        ss << sep << "{\"name\":\"" << EscapeJsonString(frame) << "\"}";
+        sep = ",";
+    }
+    ss << "]},\"profiles\":[{\"type\":\"sampled\",\"name\":\"netcoredbg\",\"unit\":\"milliseconds\",\"startValue\":0";
+
+    uint64_t endValue = 0;
+    std::ostringstream samples;
+    std::ostringstream weights;
+    sep = "";
+    for (const auto &entry : m_stacks)
+    {
+        samples << sep << "[";
+        const char *frameSep = "";
+        for (size_t frameIndex : entry.first)
+        {
+            samples << frameSep << frameIndex;
+            frameSep = ",";
+        }
+        samples << "]";
+
+        uint64_t weight = entry.second * m_intervalMs;
+        weights << sep << weight;
+        endValue += weight;
+        sep = ",";
+    }
+    ss << ",\"endValue\":" << endValue << ",\"samples\":[" << samples.str() << "],\"weights\":[" << weights.str() << "]}]}";
+    output = ss.str();
+}
+
+} // namespace netcoredbg
@@ -0,0 +1,44 @@
+// Copyright (c) 2026 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+#pragma once
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "interfaces/types.h"
+
+namespace netcoredbg
+{
+
+// Aggregated stacks of sampling profiler, each unique stack stored once with its samples count.
+class SamplingProfile
+{
+public:
+
+    SamplingProfile() : m_intervalMs(0) {}
+
+    void Reset(unsigned intervalMs);
+    // Stack frames names, root frame first.
+    void AddStack(const std::vector<std::string> &frames);
+    void AddPause(uint64_t pauseUs);
+
+    void GetStats(SamplingStats &stats);
+    void Format(SamplingFormat format, std::string &output);
+
+private:
+
+    std::mutex m_mutex;
+    unsigned m_intervalMs;
+    SamplingStats m_stats;
+    std::unordered_map<std::string, size_t> m_framesIndex;
+    std::vector<std::string> m_frames;
+    std::map<std::vector<size_t>, uint64_t> m_stacks;
+
+    void FormatCollapsed(std::string &output);
+    void FormatSpeedscope(std::string &output);
+};
+
+} // namespace netcoredbg
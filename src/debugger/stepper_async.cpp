@@ -336,6 +336,11 @@ HRESULT AsyncStepper::ManagedCallbackStepComplete()
     return S_FALSE; // S_FALSE - no error, but steppers not affect on callback
 }
 
+void AsyncStepper::ClearAsyncInfo()
+{
+    m_uniqueAsyncInfo->Clear();
+}
+
 HRESULT AsyncStepper::DisableAllSteppers()
 {
     m_asyncStepMutex.lock();
@@ -44,6 +44,7 @@ public:
     HRESULT ManagedCallbackStepComplete();
 
     HRESULT DisableAllSteppers();
+    void ClearAsyncInfo();
 
 private:
 
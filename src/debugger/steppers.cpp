@@ -244,4 +244,9 @@ void Steppers::SetStepFiltering(bool enable)
     m_stepFiltering = enable;
 }
 
+void Steppers::ClearAsyncInfo()
+{
+    m_asyncStepper->ClearAsyncInfo();
+}
+
 } // namespace netcoredbg
@@ -48,6 +48,7 @@ public:
 
     void SetJustMyCode(bool enable);
     void SetStepFiltering(bool enable);
+    void ClearAsyncInfo();
 
 private:
 
@@ -29,6 +29,8 @@ void Threads::Add(const ThreadId &threadId)
 
 void Threads::Remove(const ThreadId &threadId)
 {
+    InvalidateThreadName(threadId);
+
     std::unique_lock<Utility::RWLock::Writer> write_lock(m_userThreadsRWLock.writer);
 
     auto it = m_userThreads.find(threadId);
@@ -38,45 +40,136 @@ void Threads::Remove(const ThreadId &threadId)
     m_userThreads.erase(it);
 }
 
+void Threads::InvalidateThreadName(const ThreadId &threadId)
+{
+    std::lock_guard<std::mutex> lock(m_threadNamesMutex);
+    m_threadNames.erase(threadId);
+    m_threadNamesGeneration++;
+}
+
+void Threads::Clear()
+{
+    {
+        std::unique_lock<Utility::RWLock::Writer> write_lock(m_userThreadsRWLock.writer);
+        m_userThreads.clear();
+        MainThread = ThreadId::Invalid;
+    }
+
+    std::lock_guard<std::mutex> lock(m_threadNamesMutex);
+    m_threadNames.clear();
+    m_threadNamesGeneration++;
+}
+
+static const std::string NoThreadName = "<No name>";
+
+// Resolve `_name` field of System.Threading.Thread class, so, names of all threads could be read directly by field token.
+static HRESULT GetThreadNameField(ICorDebugValue *pThreadObject, ICorDebugClass **ppClass, mdFieldDef &fieldDef)
+{
+    HRESULT Status;
+    BOOL isNull = TRUE;
+    ToRelease<ICorDebugValue> pValue;
+    IfFailRet(DereferenceAndUnboxValue(pThreadObject, &pValue, &isNull));
+    if (isNull)
+        return E_FAIL;
+    ToRelease<ICorDebugObjectValue> pObjectValue;
+    IfFailRet(pValue->QueryInterface(IID_ICorDebugObjectValue, (LPVOID*) &pObjectValue));
+    ToRelease<ICorDebugClass> pClass;
+    IfFailRet(pObjectValue->GetClass(&pClass));
+    mdTypeDef typeDef;
+    IfFailRet(pClass->GetToken(&typeDef));
+    ToRelease<ICorDebugModule> pModule;
+    IfFailRet(pClass->GetModule(&pModule));
+    ToRelease<IUnknown> pMDUnknown;
+    IfFailRet(pModule->GetMetaDataInterface(IID_IMetaDataImport, &pMDUnknown));
+    ToRelease<IMetaDataImport> pMD;
+    IfFailRet(pMDUnknown->QueryInterface(IID_IMetaDataImport, (LPVOID*) &pMD));
+    IfFailRet(pMD->FindField(typeDef, W("_name"), nullptr, 0, &fieldDef));
+
+    *ppClass = pClass.Detach();
+    return S_OK;
+}
+
+static HRESULT GetThreadNameByField(ICorDebugValue *pThreadObject, ICorDebugClass *pClass, mdFieldDef fieldDef, std::string &threadName)
+{
+    HRESULT Status;
+    BOOL isNull = TRUE;
+    ToRelease<ICorDebugValue> pValue;
+    IfFailRet(DereferenceAndUnboxValue(pThreadObject, &pValue, &isNull));
+    if (isNull)
+        return E_FAIL;
+    ToRelease<ICorDebugObjectValue> pObjectValue;
+    IfFailRet(pValue->QueryInterface(IID_ICorDebugObjectValue, (LPVOID*) &pObjectValue));
+    ToRelease<ICorDebugValue> iCorNameValue;
+    IfFailRet(pObjectValue->GetFieldValue(pClass, fieldDef, &iCorNameValue));
+
+    ToRelease<ICorDebugValue> pNameValue;
+    IfFailRet(DereferenceAndUnboxValue(iCorNameValue, &pNameValue, &isNull));
+    if (isNull)
+    {
+        threadName = NoThreadName;
+        return S_OK;
+    }
+    return PrintStringValue(pNameValue, threadName);
+}
+
 std::string Threads::GetThreadName(ICorDebugProcess *pProcess, const ThreadId &userThread)
 {
     if (MainThread == userThread)
         return "Main Thread";
 
-    std::string threadName = "<No name>";
+    uint64_t generation;
+    {
+        std::lock_guard<std::mutex> lock(m_threadNamesMutex);
+        auto find = m_threadNames.find(userThread);
+        if (find != m_threadNames.end())
+            return find->second;
+        generation = m_threadNamesGeneration;
+    }
+
+    ToRelease<ICorDebugThread> pThread;
+    ToRelease<ICorDebugValue> iCorThreadObject;
+    if (FAILED(pProcess->GetThread(int(userThread), &pThread)) ||
+        FAILED(pThread->GetObject(&iCorThreadObject)))
+        return NoThreadName; // Thread object could be not available yet, don't cache result in this case.
+
+    std::string threadName = GetThreadNameByWalk(iCorThreadObject);
+
+    std::lock_guard<std::mutex> lock(m_threadNamesMutex);
+    if (generation == m_threadNamesGeneration)
+        m_threadNames[userThread] = threadName;
+    return threadName;
+}
+
+std::string Threads::GetThreadNameByWalk(ICorDebugValue *iCorThreadObject)
+{
+    std::string threadName = NoThreadName;
 
     if (m_sharedEvaluator)
     {
-        ToRelease<ICorDebugThread> pThread;
-        ToRelease<ICorDebugValue> iCorThreadObject;
-        if (SUCCEEDED(pProcess->GetThread(int(userThread), &pThread)) &&
-            SUCCEEDED(pThread->GetObject(&iCorThreadObject)))
+        HRESULT Status;
+        m_sharedEvaluator->WalkMembers(iCorThreadObject, nullptr, FrameLevel{0}, false, [&](
+            ICorDebugType *,
+            bool,
+            const std::string  &memberName,
+            Evaluator::GetValueCallback getValue,
+            Evaluator::SetterData*)
         {
-            HRESULT Status;
-            m_sharedEvaluator->WalkMembers(iCorThreadObject, nullptr, FrameLevel{0}, false, [&](
-                ICorDebugType *,
-                bool,
-                const std::string  &memberName,
-                Evaluator::GetValueCallback getValue,
-                Evaluator::SetterData*)
-            {
-                // Note, only field here (not `Name` property), since we can't guarantee code execution (call property's getter),
-                // this thread can be in not consistent state for evaluation or thread could break in optimized code.
-                if (memberName != "_name")
-                    return S_OK;
-
-                ToRelease<ICorDebugValue> iCorResultValue;
-                IfFailRet(getValue(&iCorResultValue, defaultEvalFlags));
-
-                BOOL isNull = TRUE;
-                ToRelease<ICorDebugValue> pValue;
-                IfFailRet(DereferenceAndUnboxValue(iCorResultValue, &pValue, &isNull));
-                if (!isNull)
-                    IfFailRet(PrintStringValue(pValue, threadName));
-
-                return E_ABORT; // Fast exit from cycle.
-            });
-        }
+            // Note, only field here (not `Name` property), since we can't guarantee code execution (call property's getter),
+            // this thread can be in not consistent state for evaluation or thread could break in optimized code.
+            if (memberName != "_name")
+                return S_OK;
+
+            ToRelease<ICorDebugValue> iCorResultValue;
+            IfFailRet(getValue(&iCorResultValue, defaultEvalFlags));
+
+            BOOL isNull = TRUE;
+            ToRelease<ICorDebugValue> pValue;
+            IfFailRet(DereferenceAndUnboxValue(iCorResultValue, &pValue, &isNull));
+            if (!isNull)
+                IfFailRet(PrintStringValue(pValue, threadName));
+
+            return E_ABORT; // Fast exit from cycle.
+        });
     }
 
     return threadName;
@@ -91,11 +184,61 @@ HRESULT Threads::GetThreadsWithState(ICorDebugProcess *pProcess, std::vector<Thr
     BOOL procRunning = FALSE;
     IfFailRet(pProcess->IsRunning(&procRunning));
 
+    std::map<ThreadId, std::string> names;
+    std::vector<ThreadId> missingNames;
+    uint64_t generation;
+    {
+        std::lock_guard<std::mutex> lock(m_threadNamesMutex);
+        generation = m_threadNamesGeneration;
+        for (auto &userThread : m_userThreads)
+        {
+            auto find = m_threadNames.find(userThread);
+            if (find != m_threadNames.end())
+                names.emplace(userThread, find->second);
+            else if (MainThread != userThread)
+                missingNames.emplace_back(userThread);
+        }
+    }
+
+    // Fetch all missing names in one pass, `_name` field resolved only once for all threads.
+    ToRelease<ICorDebugClass> pThreadClass;
+    mdFieldDef nameFieldDef = mdFieldDefNil;
+    bool nameFieldResolved = false;
+    for (auto &userThread : missingNames)
+    {
+        std::string threadName;
+        ToRelease<ICorDebugThread> pThread;
+        ToRelease<ICorDebugValue> iCorThreadObject;
+        if (FAILED(pProcess->GetThread(int(userThread), &pThread)) ||
+            FAILED(pThread->GetObject(&iCorThreadObject)))
+        {
+            // Thread object could be not available yet, don't cache result in this case.
+            names.emplace(userThread, NoThreadName);
+            continue;
+        }
+
+        if (!nameFieldResolved)
+        {
+            nameFieldResolved = true;
+            if (FAILED(GetThreadNameField(iCorThreadObject, &pThreadClass, nameFieldDef)))
+                pThreadClass.Free();
+        }
+
+        if (!pThreadClass || FAILED(GetThreadNameByField(iCorThreadObject, pThreadClass, nameFieldDef, threadName)))
+            threadName = GetThreadNameByWalk(iCorThreadObject);
+
+        names.emplace(userThread, threadName);
+
+        std::lock_guard<std::mutex> lock(m_threadNamesMutex);
+        if (generation == m_threadNamesGeneration)
+            m_threadNames[userThread] = threadName;
+    }
+
     threads.reserve(m_userThreads.size());
     for (auto &userThread : m_userThreads)
     {
         // ICorDebugThread::GetUserState not available for running thread.
-        threads.emplace_back(userThread, GetThreadName(pProcess, userThread), procRunning);
+        threads.emplace_back(userThread, MainThread == userThread ? "Main Thread" : names[userThread], procRunning);
     }
 
     return S_OK;
@@ -6,6 +6,8 @@
 #include "cor.h"
 #include "cordebug.h"
 
+#include <map>
+#include <mutex>
 #include <set>
 #include <vector>
 #include "interfaces/types.h"
@@ -24,6 +26,15 @@ class Threads
     ThreadId MainThread;
     std::shared_ptr<Evaluator> m_sharedEvaluator;
 
+    // Note, thread name read from debuggee thread object, but could be changed only by Thread.Name setter,
+    // that generate NameChange callback, so, names are cached until NameChange/CreateThread/ExitThread.
+    // Generation is changed at each invalidation, name read before invalidation must not be stored into cache.
+    std::mutex m_threadNamesMutex;
+    std::map<ThreadId, std::string> m_threadNames;
+    uint64_t m_threadNamesGeneration = 0;
+
+    std::string GetThreadNameByWalk(ICorDebugValue *iCorThreadObject);
+
 public:
 
     void Add(const ThreadId &threadId);
@@ -31,6 +42,8 @@ public:
     HRESULT GetThreadsWithState(ICorDebugProcess *pProcess, std::vector<Thread> &threads);
     HRESULT GetThreadIds(std::vector<ThreadId> &threads);
     std::string GetThreadName(ICorDebugProcess *pProcess, const ThreadId &userThread);
+    void InvalidateThreadName(const ThreadId &threadId);
+    void Clear();
     void SetEvaluator(std::shared_ptr<Evaluator> &sharedEvaluator);
 };
 
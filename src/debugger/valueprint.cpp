@@ -584,6 +584,86 @@ HRESULT PrintStringValue(ICorDebugValue * pValue, std::string &output)
     return S_OK;
 }
 
+// Read `count` chars starting from `offset` char directly from string object data.
+// Note, string object layout: method table pointer, 32-bit length, chars.
+static HRESULT ReadStringChars(ICorDebugProcess *pProcess, ICorDebugStringValue *pStringValue, ULONG32 length,
+                               ULONG32 offset, ULONG32 count, WCHAR *str)
+{
+    HRESULT Status;
+    CORDB_ADDRESS address = 0;
+    IfFailRet(pStringValue->GetAddress(&address));
+    if (address == 0)
+        return E_FAIL;
+
+    // Make sure object layout is the one we expect, length must be stored right after method table pointer.
+    INT32 storedLength = 0;
+    SIZE_T read = 0;
+    IfFailRet(pProcess->ReadMemory(address + sizeof(void*), sizeof(storedLength), (BYTE*)&storedLength, &read));
+    if (read != sizeof(storedLength) || (ULONG32)storedLength != length)
+        return E_FAIL;
+
+    CORDB_ADDRESS charsAddress = address + sizeof(void*) + sizeof(INT32) + (CORDB_ADDRESS)offset * sizeof(WCHAR);
+    IfFailRet(pProcess->ReadMemory(charsAddress, count * sizeof(WCHAR), (BYTE*)str, &read));
+    if (read != count * sizeof(WCHAR))
+        return E_FAIL;
+
+    return S_OK;
+}
+
+HRESULT ReadStringValue(ICorDebugProcess *pProcess, ICorDebugValue *pValue, ULONG32 offset, ULONG32 count, std::string &output,
+                        ULONG32 *pTotalLength, ULONG32 *pReadLength)
+{
+    HRESULT Status;
+
+    ToRelease<ICorDebugStringValue> pStringValue;
+    IfFailRet(pValue->QueryInterface(IID_ICorDebugStringValue, (LPVOID*) &pStringValue));
+
+    ULONG32 cchValue;
+    IfFailRet(pStringValue->GetLength(&cchValue));
+    if (pTotalLength)
+        *pTotalLength = cchValue;
+    if (pReadLength)
+        *pReadLength = 0;
+
+    output.clear();
+    if (offset >= cchValue || count == 0)
+        return S_OK;
+
+    // Note, read one more char (if any), in order to check surrogate pair at the end of requested part.
+    ULONG32 cchRequested = (count > cchValue - offset) ? cchValue - offset : count;
+    ULONG32 cchWindow = (cchRequested < cchValue - offset) ? cchRequested + 1 : cchRequested;
+    std::vector<WCHAR> str(cchWindow + 1);
+    WCHAR *window = str.data();
+
+    if (pProcess == nullptr || FAILED(ReadStringChars(pProcess, pStringValue, cchValue, offset, cchWindow, window)))
+    {
+        // Note, GetString() always copy string from the beginning, read only requested part plus prefix, but not whole string.
+        str.resize(offset + cchWindow + 1);
+        ULONG32 cchValueReturned = 0;
+        IfFailRet(pStringValue->GetString(offset + cchWindow, &cchValueReturned, str.data()));
+        if (cchValueReturned < offset + cchWindow)
+            return E_FAIL;
+        window = &str[offset];
+    }
+
+    // Don't split surrogate pair at the end of requested part, return pair in case only one char requested.
+    ULONG32 cchRead = cchRequested;
+    if (cchRead < cchWindow && window[cchRead - 1] >= 0xD800 && window[cchRead - 1] <= 0xDBFF)
+    {
+        if (cchRead > 1)
+            cchRead--;
+        else
+            cchRead++;
+    }
+
+    window[cchRead] = 0;
+    output = to_utf8(window);
+    if (pReadLength)
+        *pReadLength = cchRead;
+
+    return S_OK;
+}
+
 void EscapeString(std::string &s, char q = '\"')
 {
     for (std::size_t i = 0; i < s.size(); ++i)
@@ -617,7 +697,87 @@ void EscapeString(std::string &s, char q = '\"')
     }
 }
 
-HRESULT PrintValue(ICorDebugValue *pInputValue, std::string &output, bool escape)
+HRESULT PrintBasicValue(CorElementType corElemType, const BYTE *rgbValue, std::string &output, bool escape)
+{
+    std::ostringstream ss;
+
+    switch (corElemType)
+    {
+    default:
+        return E_INVALIDARG;
+
+    case ELEMENT_TYPE_BOOLEAN:
+        ss << (rgbValue[0] == 0 ? "false" : "true");
+        break;
+
+    case ELEMENT_TYPE_CHAR:
+        {
+            WCHAR wc = * (WCHAR *) &(rgbValue[0]);
+            std::string printableVal = to_utf8(wc);
+            if (!escape)
+            {
+                output = printableVal;
+                return S_OK;
+            }
+            EscapeString(printableVal, '\'');
+            ss << (unsigned int)wc << " '" << printableVal << "'";
+        }
+        break;
+
+    case ELEMENT_TYPE_I1:
+        ss << (int) *(char*) &(rgbValue[0]);
+        break;
+
+    case ELEMENT_TYPE_U1:
+        ss << (unsigned int) *(unsigned char*) &(rgbValue[0]);
+        break;
+
+    case ELEMENT_TYPE_I2:
+        ss << *(short*) &(rgbValue[0]);
+        break;
+
+    case ELEMENT_TYPE_U2:
+        ss << *(unsigned short*) &(rgbValue[0]);
+        break;
+
+    case ELEMENT_TYPE_I:
+        ss << *(int*) &(rgbValue[0]);
+        break;
+
+    case ELEMENT_TYPE_U:
+        ss << *(unsigned int*) &(rgbValue[0]);
+        break;
+
+    case ELEMENT_TYPE_I4:
+        ss << *(int*) &(rgbValue[0]);
+        break;
+
+    case ELEMENT_TYPE_U4:
+        ss << *(unsigned int*) &(rgbValue[0]);
+        break;
+
+    case ELEMENT_TYPE_I8:
+        ss << *(__int64*) &(rgbValue[0]);
+        break;
+
+    case ELEMENT_TYPE_U8:
+        ss << *(unsigned __int64*) &(rgbValue[0]);
+        break;
+
+    case ELEMENT_TYPE_R4:
+        ss << std::setprecision(8) << *(float*) &(rgbValue[0]);
+        break;
+
+    case ELEMENT_TYPE_R8:
+        ss << std::setprecision(16) << *(double*) &(rgbValue[0]);
+        break;
+    }
+
+    output = ss.str();
+    return S_OK;
+}
+
+HRESULT PrintValue(ICorDebugValue *pInputValue, std::string &output, bool escape, ULONG32 maxStringLength)
 {
     HRESULT Status;
 
@@ -645,19 +805,22 @@ HRESULT PrintValue(ICorDebugValue *pInputValue, std::string &output, bool escape
     IfFailRet(pValue->GetType(&corElemType));
     if (corElemType == ELEMENT_TYPE_STRING)
     {
+        // Read and print only first part of huge string, full string could be read by ReadStringValue() on demand.
         std::string raw_str;
-        IfFailRet(PrintStringValue(pValue, raw_str));
+        ULONG32 totalLength = 0;
+        IfFailRet(ReadStringValue(nullptr, pValue, 0, maxStringLength, raw_str, &totalLength));
+        const char *truncationMarker = totalLength > maxStringLength ? "..." : "";
 
         if (!escape)
         {
-            output = raw_str;
+            output = raw_str + truncationMarker;
             return S_OK;
         }
 
         EscapeString(raw_str, '"');
 
         std::ostringstream ss;
-        ss << "\"" << raw_str << "\"";
+        ss << "\"" << raw_str << "\"" << truncationMarker;
         output = ss.str();
         return S_OK;
     }
@@ -721,70 +884,20 @@ HRESULT PrintValue(ICorDebugValue *pInputValue, std::string &output, bool escape
         break;
 
     case ELEMENT_TYPE_BOOLEAN:
-        ss << (rgbValue[0] == 0 ? "false" : "true");
-        break;
-
     case ELEMENT_TYPE_CHAR:
-        {
-            WCHAR wc = * (WCHAR *) &(rgbValue[0]);
-            std::string printableVal = to_utf8(wc);
-            if (!escape)
-            {
-                output = printableVal;
-                return S_OK;
-            }
-            EscapeString(printableVal, '\'');
-            ss << (unsigned int)wc << " '" << printableVal << "'";
-        }
-        break;
-
     case ELEMENT_TYPE_I1:
-        ss << (int) *(char*) &(rgbValue[0]);
-        break;
-
     case ELEMENT_TYPE_U1:
-        ss << (unsigned int) *(unsigned char*) &(rgbValue[0]);
-        break;
-
     case ELEMENT_TYPE_I2:
-        ss << *(short*) &(rgbValue[0]);
-        break;
-
     case ELEMENT_TYPE_U2:
-        ss << *(unsigned short*) &(rgbValue[0]);
-        break;
-
     case ELEMENT_TYPE_I:
-        ss << *(int*) &(rgbValue[0]);
-        break;
-
     case ELEMENT_TYPE_U:
-        ss << *(unsigned int*) &(rgbValue[0]);
-        break;
-
     case ELEMENT_TYPE_I4:
-        ss << *(int*) &(rgbValue[0]);
-        break;
-
     case ELEMENT_TYPE_U4:
-        ss << *(unsigned int*) &(rgbValue[0]);
-        break;
-
     case ELEMENT_TYPE_I8:
-        ss << *(__int64*) &(rgbValue[0]);
-        break;
-
     case ELEMENT_TYPE_U8:
-        ss << *(unsigned __int64*) &(rgbValue[0]);
-        break;
-
     case ELEMENT_TYPE_R4:
-        ss << std::setprecision(8) << *(float*) &(rgbValue[0]);
-        break;
-
     case ELEMENT_TYPE_R8:
-        ss << std::setprecision(16) << *(double*) &(rgbValue[0]);
-        break;
+        return PrintBasicValue(corElemType, rgbValue.GetPtr(), output, escape);
 
     case ELEMENT_TYPE_OBJECT:
         ss << "object";
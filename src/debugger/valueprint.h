@@ -7,12 +7,25 @@
 #include "cordebug.h"
 
 #include <string>
+#include <limits>
 
 namespace netcoredbg
 {
 
-HRESULT PrintValue(ICorDebugValue *pInputValue, std::string &output, bool escape = true);
+// Max string length (in UTF-16 chars) printed for variables view and hover, longer strings are truncated with "..." marker.
+const ULONG32 PrintStringMaxLength = 10000;
+
+// Note, string value is printed in full by default, `maxStringLength` limit is used for variables view only.
+HRESULT PrintValue(ICorDebugValue *pInputValue, std::string &output, bool escape = true,
+                   ULONG32 maxStringLength = std::numeric_limits<ULONG32>::max());
 HRESULT PrintStringValue(ICorDebugValue * pValue, std::string &output);
+// Print value of primitive type (bool, char, integer and floating point types) from raw data.
+HRESULT PrintBasicValue(CorElementType corElemType, const BYTE *rgbValue, std::string &output, bool escape = true);
+// Read `count` chars of string value starting from `offset` char, `pReadLength` - count of UTF-16 chars actually read
+// (could differ from requested, since surrogate pair is not split). In case `pProcess` provided, only requested part
+// of string is read from debuggee memory, otherwise, string is read from the beginning.
+HRESULT ReadStringValue(ICorDebugProcess *pProcess, ICorDebugValue *pValue, ULONG32 offset, ULONG32 count, std::string &output,
+                        ULONG32 *pTotalLength = nullptr, ULONG32 *pReadLength = nullptr);
 HRESULT DereferenceAndUnboxValue(ICorDebugValue * pValue, ICorDebugValue** ppOutputValue, BOOL * pIsNull = nullptr);
 
 } // namespace netcoredbg
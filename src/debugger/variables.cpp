@@ -8,6 +8,7 @@
 #include <cstring>
 #include <algorithm>
 #include <sstream>
+#include <cstdlib>
 
 #include "metadata/typeprinter.h"
 #include "valueprint.h"
@@ -16,6 +17,7 @@
 #include "debugger/evaluator.h"
 #include "debugger/frames.h"
 #include "debugger/evalstackmachine.h"
+#include "metadata/modules.h"
 #include "managed/interop.h"
 #include "utils/logger.h"
 #include "utils/utf.h"
@@ -24,33 +26,433 @@
 namespace netcoredbg
 {
 
-static void GetNumChild(Evaluator *pEvaluator, ICorDebugValue *pValue, int &numChild, bool static_members)
+// Huge arrays are shown as "[0..999]"-like groups of elements, each group contain up to ArrayGroupSize elements or sub-groups.
+// Note, groups are used only in case protocol enable them (see Variables::SetGroupHugeArrays()).
+static const ULONG32 ArrayGroupSize = 1000;
+
+// Return count of elements in one group for array elements range with `length` elements (1 in case groups not needed).
+static ULONG32 GetArrayGroupElements(ULONG32 length, bool groupHugeArrays)
+{
+    if (!groupHugeArrays || length <= ArrayGroupSize)
+        return 1;
+
+    ULONG32 groupElements = ArrayGroupSize;
+    while (length / groupElements > ArrayGroupSize)
+        groupElements *= ArrayGroupSize;
+
+    return groupElements;
+}
+
+static ULONG32 GetArrayRangeNumChild(ULONG32 length, bool groupHugeArrays)
+{
+    ULONG32 groupElements = GetArrayGroupElements(length, groupHugeArrays);
+    return length / groupElements + (length % groupElements == 0 ? 0 : 1);
+}
+
+static HRESULT GetArrayLength(ICorDebugValue *pInputValue, ULONG32 &length)
+{
+    HRESULT Status;
+    BOOL isNull = FALSE;
+    ToRelease<ICorDebugValue> pValue;
+    IfFailRet(DereferenceAndUnboxValue(pInputValue, &pValue, &isNull));
+    if (isNull || !pValue.GetPtr())
+        return E_FAIL;
+
+    ToRelease<ICorDebugArrayValue> pArrayValue;
+    IfFailRet(pValue->QueryInterface(IID_ICorDebugArrayValue, (LPVOID *) &pArrayValue));
+    return pArrayValue->GetCount(&length);
+}
+
+// Get array element by its name in "[indexes]" form (see Evaluator::WalkArrayElements()), without walk through all elements.
+static HRESULT GetArrayElementByName(ICorDebugValue *pInputValue, const std::string &name, ULONG32 &position, ICorDebugValue **ppElementValue)
+{
+    HRESULT Status;
+    BOOL isNull = FALSE;
+    ToRelease<ICorDebugValue> pValue;
+    IfFailRet(DereferenceAndUnboxValue(pInputValue, &pValue, &isNull));
+    if (isNull || !pValue.GetPtr())
+        return E_FAIL;
+
+    ToRelease<ICorDebugArrayValue> pArrayValue;
+    IfFailRet(pValue->QueryInterface(IID_ICorDebugArrayValue, (LPVOID *) &pArrayValue));
+
+    ULONG32 nRank;
+    IfFailRet(pArrayValue->GetRank(&nRank));
+    std::vector<ULONG32> dims(nRank, 0);
+    IfFailRet(pArrayValue->GetDimensions(nRank, &dims[0]));
+    std::vector<ULONG32> base(nRank, 0);
+    BOOL hasBaseIndicies = FALSE;
+    if (SUCCEEDED(pArrayValue->HasBaseIndicies(&hasBaseIndicies)) && hasBaseIndicies)
+        IfFailRet(pArrayValue->GetBaseIndicies(nRank, &base[0]));
+
+    if (name.size() < 3 || name.front() != '[' || name.back() != ']')
+        return E_INVALIDARG;
+
+    // Position in row-major order.
+    position = 0;
+    const char *ptr = name.c_str() + 1;
+    for (ULONG32 i = 0; i < nRank; i++)
+    {
+        char *end = nullptr;
+        unsigned long index = strtoul(ptr, &end, 10);
+        if (end == ptr || index < base[i] || index - base[i] >= dims[i])
+            return E_INVALIDARG;
+
+        position = position * dims[i] + (ULONG32)(index - base[i]);
+        ptr = end;
+        if (i + 1 < nRank)
+        {
+            if (*ptr != ',')
+                return E_INVALIDARG;
+            ptr++;
+            while (*ptr == ' ')
+                ptr++;
+        }
+    }
+    if (*ptr != ']' || ptr + 1 != name.c_str() + name.size())
+        return E_INVALIDARG;
+
+    return pArrayValue->GetElementAtPosition(position, ppElementValue);
+}
+
+static bool IsPrimitiveElementType(CorElementType elemType)
+{
+    switch (elemType)
+    {
+    case ELEMENT_TYPE_BOOLEAN:
+    case ELEMENT_TYPE_CHAR:
+    case ELEMENT_TYPE_I1:
+    case ELEMENT_TYPE_U1:
+    case ELEMENT_TYPE_I2:
+    case ELEMENT_TYPE_U2:
+    case ELEMENT_TYPE_I4:
+    case ELEMENT_TYPE_U4:
+    case ELEMENT_TYPE_I8:
+    case ELEMENT_TYPE_U8:
+    case ELEMENT_TYPE_R4:
+    case ELEMENT_TYPE_R8:
+    case ELEMENT_TYPE_I:
+    case ELEMENT_TYPE_U:
+        return true;
+    default:
+        return false;
+    }
+}
+
+// Get address of first element in range for array with primitive type elements.
+static HRESULT GetPrimitiveArrayElementAddress(ICorDebugValue *pInputValue, ULONG32 startIndex, CorElementType &elemType,
+                                               ULONG32 &elemSize, CORDB_ADDRESS &elemAddress, std::string *pElemTypeName = nullptr)
+{
+    HRESULT Status;
+    BOOL isNull = FALSE;
+    ToRelease<ICorDebugValue> pValue;
+    IfFailRet(DereferenceAndUnboxValue(pInputValue, &pValue, &isNull));
+    if (isNull || !pValue.GetPtr())
+        return E_FAIL;
+
+    ToRelease<ICorDebugArrayValue> pArrayValue;
+    IfFailRet(pValue->QueryInterface(IID_ICorDebugArrayValue, (LPVOID *) &pArrayValue));
+    IfFailRet(pArrayValue->GetElementType(&elemType));
+    if (!IsPrimitiveElementType(elemType))
+        return E_FAIL;
+
+    ToRelease<ICorDebugValue> pElementValue;
+    IfFailRet(pArrayValue->GetElementAtPosition(startIndex, &pElementValue));
+    IfFailRet(pElementValue->GetAddress(&elemAddress));
+    IfFailRet(pElementValue->GetSize(&elemSize));
+    if (elemAddress == 0 || elemSize == 0)
+        return E_FAIL;
+
+    if (pElemTypeName)
+        IfFailRet(TypePrinter::GetTypeOfValue(pElementValue, *pElemTypeName));
+
+    return S_OK;
+}
+
+// Read data of array elements in [startIndex, endIndex) range by one memory read, instead of COM call for each element.
+static HRESULT ReadPrimitiveArrayData(ICorDebugThread *pThread, ICorDebugValue *pInputValue, ULONG32 startIndex, ULONG32 endIndex,
+                                      CorElementType &elemType, std::string &elemTypeName, ULONG32 &elemSize, std::vector<BYTE> &data)
+{
+    HRESULT Status;
+    CORDB_ADDRESS elemAddress = 0;
+    IfFailRet(GetPrimitiveArrayElementAddress(pInputValue, startIndex, elemType, elemSize, elemAddress, &elemTypeName));
+
+    ToRelease<ICorDebugProcess> pProcess;
+    IfFailRet(pThread->GetProcess(&pProcess));
+
+    data.resize((size_t)(endIndex - startIndex) * elemSize);
+    SIZE_T read = 0;
+    IfFailRet(pProcess->ReadMemory(elemAddress, (DWORD)data.size(), data.data(), &read));
+    if (read != data.size())
+        return E_FAIL;
+
+    return S_OK;
+}
+
+enum class CollectionKind
+{
+    None,
+    List,           // System.Collections.Generic.List<T>
+    Queue,          // System.Collections.Generic.Queue<T>
+    HashSet,        // System.Collections.Generic.HashSet<T>
+    Dictionary,     // System.Collections.Generic.Dictionary<TKey,TValue>
+    ImmutableArray  // System.Collections.Immutable.ImmutableArray<T>
+};
+
+// Logical view of BCL collection, built from collection private fields without func-eval.
+// Note, fields layout of .NET 5+ BCL collections is used (and .NET Core 3.x Dictionary entries layout),
+// for other layouts collection shown as usual object.
+struct CollectionView
+{
+    CollectionKind kind;
+    ToRelease<ICorDebugValue> storage; // backing array field value
+    std::string storageName;           // backing array field name
+    ULONG32 storageLength;
+    ULONG32 head;  // Queue only, position of first element in backing array
+    ULONG32 size;  // elements count for List, Queue, ImmutableArray, used entries count for HashSet and Dictionary
+    ULONG32 count; // elements count
+    bool freeByHashCode; // .NET Core 3.x Dictionary, free entries have negative `hashCode` instead of `next` less than -1
+
+    CollectionView() : kind(CollectionKind::None), storageLength(0), head(0), size(0), count(0), freeByHashCode(false) {}
+};
+
+static HRESULT GetFieldValueByName(Evaluator *pEvaluator, ICorDebugValue *pInputValue, const std::string &fieldName, ICorDebugValue **ppResultValue)
+{
+    HRESULT Status;
+    bool found = false;
+    // No thread and FrameLevel{0} here, since we need only instance fields, that don't need func-eval.
+    IfFailRet(pEvaluator->WalkMembers(pInputValue, nullptr, FrameLevel{0}, false, [&](
+        ICorDebugType*,
+        bool is_static,
+        const std::string &name,
+        Evaluator::GetValueCallback getValue,
+        Evaluator::SetterData*) -> HRESULT
+    {
+        if (found || is_static || name != fieldName)
+            return S_OK;
+
+        found = true;
+        return getValue(ppResultValue, defaultEvalFlags);
+    }));
+
+    return found ? S_OK : E_FAIL;
+}
+
+static HRESULT GetIntFieldValue(Evaluator *pEvaluator, ICorDebugValue *pInputValue, const std::string &fieldName, int32_t &result)
+{
+    HRESULT Status;
+    ToRelease<ICorDebugValue> pFieldValue;
+    IfFailRet(GetFieldValueByName(pEvaluator, pInputValue, fieldName, &pFieldValue));
+
+    CorElementType elemType;
+    IfFailRet(pFieldValue->GetType(&elemType));
+    if (elemType != ELEMENT_TYPE_I4 && elemType != ELEMENT_TYPE_U4)
+        return E_FAIL;
+
+    ToRelease<ICorDebugGenericValue> pGenericValue;
+    IfFailRet(pFieldValue->QueryInterface(IID_ICorDebugGenericValue, (LPVOID*) &pGenericValue));
+    return pGenericValue->GetValue(&result);
+}
+
+static bool StartsWith(const std::string &str, const char *prefix)
+{
+    return str.compare(0, strlen(prefix), prefix) == 0;
+}
+
+// .NET 5+ Dictionary entry have `uint hashCode`, HashSet entry have `int HashCode`, free entries have `next` less than -1
+// (see StartOfFreeList in .NET sources). .NET Core 3.x Dictionary entry have `int hashCode`, that is -1 for free entries.
+static HRESULT GetEntriesLayout(Evaluator *pEvaluator, CollectionView &view)
+{
+    HRESULT Status;
+    BOOL isNull = FALSE;
+    ToRelease<ICorDebugValue> pStorageValue;
+    IfFailRet(DereferenceAndUnboxValue(view.storage, &pStorageValue, &isNull));
+    ToRelease<ICorDebugArrayValue> pStorage;
+    IfFailRet(pStorageValue->QueryInterface(IID_ICorDebugArrayValue, (LPVOID *) &pStorage));
+    ToRelease<ICorDebugValue> pFirstEntry;
+    IfFailRet(pStorage->GetElementAtPosition(0, &pFirstEntry));
+    ToRelease<ICorDebugValue> pHashCode;
+    IfFailRet(GetFieldValueByName(pEvaluator, pFirstEntry, view.kind == CollectionKind::HashSet ? "HashCode" : "hashCode", &pHashCode));
+    CorElementType hashCodeType;
+    IfFailRet(pHashCode->GetType(&hashCodeType));
+
+    if (view.kind == CollectionKind::HashSet && hashCodeType == ELEMENT_TYPE_I4)
+        view.freeByHashCode = false;
+    else if (view.kind == CollectionKind::Dictionary && hashCodeType == ELEMENT_TYPE_U4)
+        view.freeByHashCode = false;
+    else if (view.kind == CollectionKind::Dictionary && hashCodeType == ELEMENT_TYPE_I4)
+        view.freeByHashCode = true;
+    else
+        return E_FAIL; // Unknown layout, collection will be shown as usual object.
+
+    return S_OK;
+}
+
+static HRESULT GetCollectionView(Evaluator *pEvaluator, ICorDebugValue *pInputValue, CollectionView &view)
+{
+    HRESULT Status;
+    std::string typeName;
+    IfFailRet(TypePrinter::GetTypeOfValue(pInputValue, typeName));
+
+    if (StartsWith(typeName, "System.Collections.Generic.List<"))
+        view.kind = CollectionKind::List;
+    else if (StartsWith(typeName, "System.Collections.Generic.Queue<"))
+        view.kind = CollectionKind::Queue;
+    else if (StartsWith(typeName, "System.Collections.Generic.HashSet<"))
+        view.kind = CollectionKind::HashSet;
+    else if (StartsWith(typeName, "System.Collections.Generic.Dictionary<"))
+        view.kind = CollectionKind::Dictionary;
+    else if (StartsWith(typeName, "System.Collections.Immutable.ImmutableArray<"))
+        view.kind = CollectionKind::ImmutableArray;
+    else
+        return E_FAIL;
+
+    BOOL isNull = FALSE;
+    ToRelease<ICorDebugValue> pValue;
+    IfFailRet(DereferenceAndUnboxValue(pInputValue, &pValue, &isNull));
+    if (isNull || !pValue.GetPtr())
+        return E_FAIL;
+
+    int32_t size = 0;
+    int32_t freeCount = 0;
+    int32_t head = 0;
+    switch (view.kind)
+    {
+    case CollectionKind::List:
+        view.storageName = "_items";
+        IfFailRet(GetIntFieldValue(pEvaluator, pValue, "_size", size));
+        break;
+    case CollectionKind::Queue:
+        view.storageName = "_array";
+        IfFailRet(GetIntFieldValue(pEvaluator, pValue, "_size", size));
+        IfFailRet(GetIntFieldValue(pEvaluator, pValue, "_head", head));
+        break;
+    case CollectionKind::HashSet:
+    case CollectionKind::Dictionary:
+        view.storageName = "_entries";
+        IfFailRet(GetIntFieldValue(pEvaluator, pValue, "_count", size));
+        IfFailRet(GetIntFieldValue(pEvaluator, pValue, "_freeCount", freeCount));
+        break;
+    case CollectionKind::ImmutableArray:
+        view.storageName = "array";
+        break;
+    default:
+        return E_FAIL;
+    }
+
+    IfFailRet(GetFieldValueByName(pEvaluator, pValue, view.storageName, &view.storage));
+    // Note, backing array could be null, for example, for Dictionary or HashSet without added elements.
+    if (FAILED(GetArrayLength(view.storage, view.storageLength)))
+    {
+        if (size != 0 || view.kind == CollectionKind::ImmutableArray)
+            return E_FAIL;
+        view.storageLength = 0;
+    }
+
+    if (view.kind == CollectionKind::ImmutableArray)
+        size = (int32_t)view.storageLength;
+
+    if (size < 0 || freeCount < 0 || freeCount > size || head < 0 ||
+        (ULONG32)size > view.storageLength || (view.storageLength > 0 && (ULONG32)head >= view.storageLength))
+        return E_FAIL;
+
+    if ((view.kind == CollectionKind::HashSet || view.kind == CollectionKind::Dictionary) && size > 0)
+        IfFailRet(GetEntriesLayout(pEvaluator, view));
+
+    view.size = (ULONG32)size;
+    view.head = (ULONG32)head;
+    view.count = (ULONG32)(size - freeCount);
+    return S_OK;
+}
+
+// Return count of children for collection elements, huge collections elements are grouped as array elements.
+static ULONG32 GetCollectionElementsNumChild(const CollectionView &view, bool groupHugeArrays)
+{
+    return GetArrayRangeNumChild(view.count, groupHugeArrays);
+}
+
+// Get exact type id for not null object (class or value type), since only in this case members count depends on type only.
+static HRESULT GetObjectTypeID(ICorDebugValue *pInputValue, COR_TYPEID &typeID)
+{
+    HRESULT Status;
+    CorElementType inputCorType;
+    IfFailRet(pInputValue->GetType(&inputCorType));
+    if (inputCorType == ELEMENT_TYPE_PTR)
+        return E_FAIL;
+
+    BOOL isNull = FALSE;
+    ToRelease<ICorDebugValue> pValue;
+    IfFailRet(DereferenceAndUnboxValue(pInputValue, &pValue, &isNull));
+    if (isNull || !pValue.GetPtr())
+        return E_FAIL;
+
+    ToRelease<ICorDebugValue2> pValue2;
+    IfFailRet(pValue->QueryInterface(IID_ICorDebugValue2, (LPVOID *) &pValue2));
+    ToRelease<ICorDebugType> pType;
+    IfFailRet(pValue2->GetExactType(&pType));
+    CorElementType corType;
+    IfFailRet(pType->GetType(&corType));
+    if (corType != ELEMENT_TYPE_CLASS && corType != ELEMENT_TYPE_VALUETYPE)
+        return E_FAIL;
+
+    ToRelease<ICorDebugType2> pType2;
+    IfFailRet(pType->QueryInterface(IID_ICorDebugType2, (LPVOID*) &pType2));
+    return pType2->GetTypeID(&typeID);
+}
+
+static void GetNumChild(Evaluator *pEvaluator, EvalHelpers *pEvalHelpers, ICorDebugValue *pValue, int &numChild, bool static_members,
+                        bool collectionView = false, bool groupHugeArrays = false)
 {
     numChild = 0;
 
     if (pValue == nullptr)
         return;
 
-    int numStatic = 0;
-    int numInstance = 0;
-    // No thread and FrameLevel{0} here, since we need only count childs.
-    if (FAILED(pEvaluator->WalkMembers(pValue, nullptr, FrameLevel{0}, false, [&numStatic, &numInstance](
-        ICorDebugType *,
-        bool is_static,
-        const std::string &,
-        Evaluator::GetValueCallback,
-        Evaluator::SetterData*)
+    // Collection have only elements and "Raw View" entry.
+    CollectionView view;
+    if (collectionView && SUCCEEDED(GetCollectionView(pEvaluator, pValue, view)))
     {
-        if (is_static)
-            numStatic++;
-        else
-            numInstance++;
-        return S_OK;
-    })))
+        numChild = (int)GetCollectionElementsNumChild(view, groupHugeArrays) + 1;
+        return;
+    }
+
+    // Array have only elements, no reason walk all of them just for count.
+    ULONG32 arrayLength = 0;
+    if (SUCCEEDED(GetArrayLength(pValue, arrayLength)))
     {
+        if (!static_members)
+            numChild = (int)GetArrayRangeNumChild(arrayLength, groupHugeArrays);
         return;
     }
 
+    int numStatic = 0;
+    int numInstance = 0;
+    COR_TYPEID typeID;
+    bool cacheable = SUCCEEDED(GetObjectTypeID(pValue, typeID));
+    if (!cacheable || !pEvalHelpers->GetMembersCountFromCache(typeID, numStatic, numInstance))
+    {
+        // No thread and FrameLevel{0} here, since we need only count childs.
+        if (FAILED(pEvaluator->WalkMembers(pValue, nullptr, FrameLevel{0}, false, [&numStatic, &numInstance](
+            ICorDebugType *,
+            bool is_static,
+            const std::string &,
+            Evaluator::GetValueCallback,
+            Evaluator::SetterData*)
+        {
+            if (is_static)
+                numStatic++;
+            else
+                numInstance++;
+            return S_OK;
+        })))
+        {
+            return;
+        }
+
+        if (cacheable)
+            pEvalHelpers->AddMembersCountToCache(typeID, numStatic, numInstance);
+    }
+
     if (static_members)
     {
         numChild = numStatic;
@@ -67,29 +469,174 @@ struct VariableMember
     std::string name;
     std::string ownerType;
     ToRelease<ICorDebugValue> value;
-    VariableMember(const std::string &name, const std::string& ownerType, ICorDebugValue *pValue) :
+    // Not evaluated property (lazy mode), index is member position in object members walk.
+    bool lazy;
+    int index;
+    // Field value and type, decoded from raw object data (value is not created in this case).
+    bool decoded;
+    std::string decodedValue;
+    std::string decodedType;
+    VariableMember(const std::string &name, const std::string& ownerType, ICorDebugValue *pValue, bool lazy = false, int index = 0) :
         name(name),
         ownerType(ownerType),
-        value(pValue)
+        value(pValue),
+        lazy(lazy),
+        index(index),
+        decoded(false)
     {}
     VariableMember(VariableMember &&that) = default;
     VariableMember(const VariableMember &that) = delete;
 };
 
-static void FillValueAndType(VariableMember &member, Variable &var)
+void Variables::FillValueAndType(VariableMember &member, Variable &var, FrameId frameId)
 {
+    if (member.decoded)
+    {
+        var.value = member.decodedValue;
+        var.type = member.decodedType;
+        MarkChangedValue(frameId, var);
+        return;
+    }
     if (member.value == nullptr)
     {
         var.value = "<error>";
         return;
     }
-    PrintValue(member.value, var.value, true);
-    TypePrinter::GetTypeOfValue(member.value, var.type);
+    PrintValueAndType(frameId, member.value, var, PrintStringMaxLength);
+}
+
+// Object data, read from debuggee memory by one call, in order to decode primitive type fields
+// without GetFieldValue() and GetValue() COM calls for each field.
+struct RawObjectData
+{
+    EvalHelpers *pEvalHelpers;
+    ToRelease<ICorDebugProcess5> iCorProcess5;
+    std::vector<BYTE> data;
+    ULONG32 boxOffset;
+    // Last used type layout, since all members of same type are walked in a row.
+    ICorDebugType *pLastType;
+    std::shared_ptr<EvalHelpers::TypeLayout> lastTypeLayout;
+
+    RawObjectData(EvalHelpers *pEvalHelpers) :
+        pEvalHelpers(pEvalHelpers),
+        boxOffset(0),
+        pLastType(nullptr)
+    {}
+};
+
+static HRESULT ReadRawObjectData(ICorDebugThread *pThread, ICorDebugValue *pInputValue, RawObjectData &rawData)
+{
+    HRESULT Status;
+    BOOL isNull = FALSE;
+    ToRelease<ICorDebugValue> pValue;
+    IfFailRet(DereferenceAndUnboxValue(pInputValue, &pValue, &isNull));
+    if (isNull || !pValue.GetPtr())
+        return E_FAIL;
+
+    ToRelease<ICorDebugValue2> pValue2;
+    IfFailRet(pValue->QueryInterface(IID_ICorDebugValue2, (LPVOID *) &pValue2));
+    ToRelease<ICorDebugType> pType;
+    IfFailRet(pValue2->GetExactType(&pType));
+    CorElementType elemType;
+    IfFailRet(pType->GetType(&elemType));
+    if (elemType != ELEMENT_TYPE_CLASS && elemType != ELEMENT_TYPE_VALUETYPE)
+        return E_FAIL;
+
+    ToRelease<ICorDebugProcess> pProcess;
+    IfFailRet(pThread->GetProcess(&pProcess));
+    IfFailRet(pProcess->QueryInterface(IID_ICorDebugProcess5, (LPVOID *) &rawData.iCorProcess5));
+
+    std::shared_ptr<EvalHelpers::TypeLayout> typeLayout;
+    IfFailRet(rawData.pEvalHelpers->GetTypeLayout(rawData.iCorProcess5, pType, typeLayout));
+    rawData.boxOffset = typeLayout->boxOffset;
+
+    // Note, value type could be stored in registers, in this case address is 0.
+    CORDB_ADDRESS address = 0;
+    ULONG32 size = 0;
+    IfFailRet(pValue->GetAddress(&address));
+    IfFailRet(pValue->GetSize(&size));
+    if (address == 0 || size == 0)
+        return E_FAIL;
+
+    rawData.data.resize(size);
+    SIZE_T read = 0;
+    IfFailRet(pProcess->ReadMemory(address, size, rawData.data.data(), &read));
+    if (read != size)
+        return E_FAIL;
+
+    return S_OK;
+}
+
+static ULONG32 GetPrimitiveElementSize(CorElementType elemType)
+{
+    switch (elemType)
+    {
+    case ELEMENT_TYPE_BOOLEAN:
+    case ELEMENT_TYPE_I1:
+    case ELEMENT_TYPE_U1:
+        return 1;
+    case ELEMENT_TYPE_CHAR:
+    case ELEMENT_TYPE_I2:
+    case ELEMENT_TYPE_U2:
+        return 2;
+    case ELEMENT_TYPE_I4:
+    case ELEMENT_TYPE_U4:
+    case ELEMENT_TYPE_R4:
+        return 4;
+    case ELEMENT_TYPE_I8:
+    case ELEMENT_TYPE_U8:
+    case ELEMENT_TYPE_R8:
+        return 8;
+    case ELEMENT_TYPE_I:
+    case ELEMENT_TYPE_U:
+        return sizeof(void*);
+    default:
+        return 0;
+    }
+}
+
+static bool DecodeRawField(RawObjectData &rawData, ICorDebugType *pType, const std::string &name, VariableMember &member)
+{
+    if (rawData.data.empty() || !pType)
+        return false;
+
+    if (pType != rawData.pLastType)
+    {
+        rawData.lastTypeLayout.reset();
+        rawData.pLastType = pType;
+        if (FAILED(rawData.pEvalHelpers->GetTypeLayout(rawData.iCorProcess5, pType, rawData.lastTypeLayout)))
+            return false;
+    }
+    if (!rawData.lastTypeLayout)
+        return false;
+
+    for (const auto &field : rawData.lastTypeLayout->fields)
+    {
+        if (field.name != name)
+            continue;
+
+        // Field offset provided for boxed object, but we could have unboxed value type data.
+        ULONG32 size = GetPrimitiveElementSize(field.elemType);
+        if (size == 0 || field.offset < rawData.boxOffset)
+            return false;
+        size_t position = field.offset - rawData.boxOffset;
+        if (position + size > rawData.data.size())
+            return false;
+
+        if (FAILED(PrintBasicValue(field.elemType, &rawData.data[position], member.decodedValue)))
+            return false;
+        member.decodedType = field.typeName;
+        member.decoded = true;
+        return true;
+    }
+
+    return false;
 }
 
 static HRESULT FetchFieldsAndProperties(Evaluator *pEvaluator, ICorDebugValue *pInputValue, ICorDebugThread *pThread,
                                         FrameLevel frameLevel, std::vector<VariableMember> &members, bool fetchOnlyStatic,
-                                        bool &hasStaticMembers, int childStart, int childEnd, int evalFlags)
+                                        bool &hasStaticMembers, int childStart, int childEnd, int evalFlags, bool lazyProperties = false,
+                                        RawObjectData *pRawData = nullptr)
 {
     hasStaticMembers = false;
     HRESULT Status;
@@ -99,12 +646,14 @@ static HRESULT FetchFieldsAndProperties(Evaluator *pEvaluator, ICorDebugValue *p
 
     int currentIndex = -1;
 
-    IfFailRet(pEvaluator->WalkMembers(pInputValue, pThread, frameLevel, false, [&](
+    // Note, in lazy mode we need setter data only in order to distinguish properties from fields,
+    // since WalkMembers provide setter data for properties only.
+    IfFailRet(pEvaluator->WalkMembers(pInputValue, pThread, frameLevel, lazyProperties, [&](
         ICorDebugType *pType,
         bool is_static,
         const std::string &name,
         Evaluator::GetValueCallback getValue,
-        Evaluator::SetterData*)
+        Evaluator::SetterData *setterData)
     {
         if (is_static)
             hasStaticMembers = true;
@@ -119,6 +668,30 @@ static HRESULT FetchFieldsAndProperties(Evaluator *pEvaluator, ICorDebugValue *p
         if (currentIndex >= childEnd)
             return S_OK;
 
+        if (lazyProperties && setterData)
+        {
+            std::string className;
+            if (pType)
+                IfFailRet(TypePrinter::GetTypeOfValue(pType, className));
+
+            members.emplace_back(name, className, nullptr, true, currentIndex);
+            return S_OK;
+        }
+
+        // Note, raw object data contain only instance fields, properties and static members will be not found in layout.
+        if (pRawData && !is_static)
+        {
+            VariableMember member(name, "", nullptr);
+            if (DecodeRawField(*pRawData, pType, name, member))
+            {
+                if (pType)
+                    IfFailRet(TypePrinter::GetTypeOfValue(pType, member.ownerType));
+
+                members.emplace_back(std::move(member));
+                return S_OK;
+            }
+        }
+
         // Note, in this case error is not fatal, but if protocol side need cancel command execution, stop walk and return error to caller.
         ToRelease<ICorDebugValue> iCorResultValue;
         if (getValue(&iCorResultValue, evalFlags) == COR_E_OPERATIONCANCELED)
@@ -135,14 +708,250 @@ static HRESULT FetchFieldsAndProperties(Evaluator *pEvaluator, ICorDebugValue *p
     return S_OK;
 }
 
+// Reference id is position in references storage (+1, since 0 is "no reference") after ids of all previous stops.
+uint32_t Variables::GetNextReferenceId()
+{
+    return m_referencesBase + (uint32_t)(m_references.size() + 1);
+}
+
+// Note, m_referencesMutex must be locked by caller.
+Variables::VariableReference *Variables::FindReference(uint32_t variablesReference)
+{
+    // Reject stale reference (from previous stop) without search.
+    if (variablesReference <= m_referencesBase)
+        return nullptr;
+
+    uint32_t index = variablesReference - m_referencesBase;
+    if (index > m_references.size())
+        return nullptr;
+
+    return &m_references[index - 1];
+}
+
+// Read data, that define printed representation of primitive type or string value.
+static HRESULT GetValueRawData(ICorDebugValue *pInputValue, ULONG32 maxStringLength, CorElementType &elemType, std::vector<BYTE> &rawData)
+{
+    HRESULT Status;
+    BOOL isNull = FALSE;
+    ToRelease<ICorDebugValue> pValue;
+    IfFailRet(DereferenceAndUnboxValue(pInputValue, &pValue, &isNull));
+    if (isNull)
+        return E_FAIL;
+
+    IfFailRet(pValue->GetType(&elemType));
+    if (IsPrimitiveElementType(elemType))
+    {
+        ULONG32 size = 0;
+        IfFailRet(pValue->GetSize(&size));
+        ToRelease<ICorDebugGenericValue> pGenericValue;
+        IfFailRet(pValue->QueryInterface(IID_ICorDebugGenericValue, (LPVOID*) &pGenericValue));
+        rawData.resize(size);
+        return pGenericValue->GetValue(rawData.data());
+    }
+    else if (elemType == ELEMENT_TYPE_STRING)
+    {
+        ToRelease<ICorDebugStringValue> pStringValue;
+        IfFailRet(pValue->QueryInterface(IID_ICorDebugStringValue, (LPVOID*) &pStringValue));
+        ULONG32 length = 0;
+        IfFailRet(pStringValue->GetLength(&length));
+        // Note, printed string is truncated to maxStringLength chars, so, only this part matters.
+        if (length > maxStringLength)
+            length = maxStringLength + 1;
+        rawData.resize((length + 1) * sizeof(WCHAR));
+        ULONG32 fetched = 0;
+        return pStringValue->GetString(length + 1, &fetched, reinterpret_cast<WCHAR*>(rawData.data()));
+    }
+
+    return E_FAIL;
+}
+
+static HRESULT GetFrameMethodKey(ICorDebugThread *pThread, FrameLevel frameLevel, std::string &key)
+{
+    HRESULT Status;
+    ToRelease<ICorDebugFrame> pFrame;
+    IfFailRet(GetFrameAt(pThread, frameLevel, &pFrame));
+    if (pFrame == nullptr)
+        return E_FAIL;
+
+    mdMethodDef methodToken;
+    IfFailRet(pFrame->GetFunctionToken(&methodToken));
+    ToRelease<ICorDebugFunction> pFunc;
+    IfFailRet(pFrame->GetFunction(&pFunc));
+    ToRelease<ICorDebugCode> pCode;
+    IfFailRet(pFunc->GetILCode(&pCode));
+    ULONG32 methodVersion;
+    IfFailRet(pCode->GetVersionNumber(&methodVersion));
+    ToRelease<ICorDebugModule> pModule;
+    IfFailRet(pFunc->GetModule(&pModule));
+    std::string moduleId;
+    IfFailRet(GetModuleId(pModule, moduleId));
+
+    key = moduleId + ":" + std::to_string(methodToken) + ":" + std::to_string(methodVersion);
+    return S_OK;
+}
+
+// Note, values history is not used for frame, method identity of which can't be resolved.
+void Variables::UpdateFrameMethodKey(ICorDebugThread *pThread, FrameId frameId)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_valuesHistoryMutex);
+        if (m_frameMethodKeys.find(int(frameId)) != m_frameMethodKeys.end())
+            return;
+    }
+
+    std::string key;
+    if (FAILED(GetFrameMethodKey(pThread, frameId.getLevel(), key)))
+        key.clear();
+
+    std::lock_guard<std::mutex> lock(m_valuesHistoryMutex);
+    m_frameMethodKeys[int(frameId)] = key;
+}
+
+bool Variables::GetValuesHistoryKey(FrameId frameId, const std::string &evaluateName, std::string &key)
+{
+    if (evaluateName.empty())
+        return false;
+
+    std::lock_guard<std::mutex> lock(m_valuesHistoryMutex);
+    auto find = m_frameMethodKeys.find(int(frameId));
+    if (find == m_frameMethodKeys.end() || find->second.empty())
+        return false;
+
+    key = std::to_string(int(frameId.getThread())) + ":" + std::to_string(int(frameId.getLevel())) + ":" + find->second + ":" + evaluateName;
+    return true;
+}
+
+void Variables::UpdateValuesHistory(const std::string &key, const Variable &var, CorElementType elemType, std::vector<BYTE> &&rawData, bool &changed)
+{
+    std::lock_guard<std::mutex> lock(m_valuesHistoryMutex);
+
+    auto find = m_valuesHistory.find(key);
+    if (find == m_valuesHistory.end())
+    {
+        changed = false;
+        if (m_valuesHistory.size() >= MaxValuesHistorySize)
+        {
+            // Drop values, that was not requested at this stop.
+            for (auto it = m_valuesHistory.begin(); it != m_valuesHistory.end();)
+            {
+                if (it->second.stopCount != m_stopCount)
+                    it = m_valuesHistory.erase(it);
+                else
+                    ++it;
+            }
+            if (m_valuesHistory.size() >= MaxValuesHistorySize)
+                return;
+        }
+        find = m_valuesHistory.emplace(key, PrintedValue()).first;
+        find->second.changed = false;
+    }
+    else if (find->second.stopCount != m_stopCount)
+    {
+        // First request at this stop, compare with value from previous stop.
+        find->second.changed = find->second.value != var.value || find->second.type != var.type;
+    }
+    else if (find->second.value != var.value || find->second.type != var.type)
+    {
+        // Value was changed at this stop (for example, by setVariable).
+        find->second.changed = true;
+    }
+
+    find->second.elemType = elemType;
+    find->second.rawData = std::move(rawData);
+    find->second.value = var.value;
+    find->second.type = var.type;
+    find->second.stopCount = m_stopCount;
+    changed = find->second.changed;
+}
+
+HRESULT Variables::PrintValueAndType(FrameId frameId, ICorDebugValue *pValue, Variable &var, ULONG32 maxStringLength)
+{
+    HRESULT Status;
+    std::string key;
+    if (!GetValuesHistoryKey(frameId, var.evaluateName, key))
+    {
+        IfFailRet(TypePrinter::GetTypeOfValue(pValue, var.type));
+        return PrintValue(pValue, var.value, true, maxStringLength);
+    }
+
+    // Note, truncated and full strings printing must not share history.
+    if (maxStringLength != PrintStringMaxLength)
+        key += "#full";
+
+    // Note, raw data compared instead of printed value, since for primitives and strings
+    // raw data read is much cheaper than value printing (formatting, UTF conversion and escaping).
+    // Key includes method identity, so, same element type and data mean same type name too.
+    CorElementType elemType = ELEMENT_TYPE_END;
+    std::vector<BYTE> rawData;
+    bool hasRawData = SUCCEEDED(GetValueRawData(pValue, maxStringLength, elemType, rawData));
+
+    bool printed = false;
+    if (hasRawData)
+    {
+        std::lock_guard<std::mutex> lock(m_valuesHistoryMutex);
+        auto find = m_valuesHistory.find(key);
+        if (find != m_valuesHistory.end() && find->second.elemType == elemType && find->second.rawData == rawData)
+        {
+            var.value = find->second.value;
+            var.type = find->second.type;
+            printed = true;
+        }
+    }
+
+    if (!printed)
+    {
+        IfFailRet(TypePrinter::GetTypeOfValue(pValue, var.type));
+        IfFailRet(PrintValue(pValue, var.value, true, maxStringLength));
+    }
+
+    UpdateValuesHistory(key, var, elemType, std::move(rawData), var.changed);
+    return S_OK;
+}
+
+void Variables::MarkChangedValue(FrameId frameId, Variable &var)
+{
+    std::string key;
+    if (!GetValuesHistoryKey(frameId, var.evaluateName, key))
+        return;
+
+    UpdateValuesHistory(key, var, ELEMENT_TYPE_END, std::vector<BYTE>(), var.changed);
+}
+
+void Variables::ClearValuesHistory()
+{
+    std::lock_guard<std::mutex> lock(m_valuesHistoryMutex);
+    m_valuesHistory.clear();
+    m_frameMethodKeys.clear();
+}
+
+void Variables::Clear()
+{
+    std::deque<VariableReference> references;
+    {
+        std::lock_guard<std::recursive_mutex> lock(m_referencesMutex);
+        references.swap(m_references);
+        m_referencesBase += (uint32_t)references.size();
+        if (m_referencesBase > MaxReferenceId - MaxReferencesPerStop)
+            m_referencesBase = 0;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_valuesHistoryMutex);
+        m_stopCount++;
+        m_frameMethodKeys.clear();
+    }
+
+    // Note, COM objects must be released while process is stopped, so, release them here without references lock held.
+    references.clear();
+}
+
 int Variables::GetNamedVariables(uint32_t variablesReference)
 {
     std::lock_guard<std::recursive_mutex> lock(m_referencesMutex);
 
-    auto it = m_references.find(variablesReference);
-    if (it == m_references.end())
+    VariableReference *pRef = FindReference(variablesReference);
+    if (!pRef)
         return 0;
-    return it->second.namedVariables;
+    return pRef->namedVariables;
 }
 
 // Caller should guarantee, that pProcess is not null.
@@ -156,16 +965,17 @@ HRESULT Variables::GetVariables(
 {
     std::lock_guard<std::recursive_mutex> lock(m_referencesMutex);
 
-    auto it = m_references.find(variablesReference);
-    if (it == m_references.end())
+    VariableReference *pRef = FindReference(variablesReference);
+    if (!pRef)
         return E_FAIL;
 
-    VariableReference &ref = it->second;
+    VariableReference &ref = *pRef;
 
     HRESULT Status;
 
     ToRelease<ICorDebugThread> pThread;
     IfFailRet(pProcess->GetThread(int(ref.frameId.getThread()), &pThread));
+    UpdateFrameMethodKey(pThread, ref.frameId);
 
     // Named and Indexed variables are in the same index (internally), Named variables go first
     if (filter == VariablesNamed && (start + count > ref.namedVariables || count == 0))
@@ -188,21 +998,156 @@ HRESULT Variables::AddVariableReference(Variable &variable, FrameId frameId, ICo
 {
     std::lock_guard<std::recursive_mutex> lock(m_referencesMutex);
 
-    if (m_references.size() == std::numeric_limits<uint32_t>::max())
+    if (m_references.size() >= MaxReferencesPerStop)
+        return E_FAIL;
+
+    int numChild = 0;
+    GetNumChild(m_sharedEvaluator.get(), m_sharedEvalHelpers.get(), pValue, numChild, valueKind == ValueIsClass, valueKind == ValueIsVariable, m_groupHugeArrays);
+    if (numChild == 0)
+        return S_OK;
+
+    variable.namedVariables = numChild;
+    variable.variablesReference = GetNextReferenceId();
+
+    // Provide array data address for memory view (see DAP `readMemory` request).
+    CorElementType elemType;
+    ULONG32 elemSize;
+    CORDB_ADDRESS elemAddress;
+    if (valueKind == ValueIsVariable && SUCCEEDED(GetPrimitiveArrayElementAddress(pValue, 0, elemType, elemSize, elemAddress)))
+        variable.memoryReference = elemAddress;
+
+    pValue->AddRef();
+    VariableReference variableReference(variable, frameId, pValue, valueKind);
+    m_references.emplace_back(std::move(variableReference));
+
+    return S_OK;
+}
+
+HRESULT Variables::AddLazyPropertyReference(Variable &variable, VariableReference &ref, int memberIndex, bool memberIsStatic)
+{
+    std::lock_guard<std::recursive_mutex> lock(m_referencesMutex);
+
+    if (m_references.size() >= MaxReferencesPerStop)
         return E_FAIL;
 
-    int numChild = 0;
-    GetNumChild(m_sharedEvaluator.get(), pValue, numChild, valueKind == ValueIsClass);
-    if (numChild == 0)
-        return S_OK;
+    // Only one child - property value itself.
+    variable.namedVariables = 1;
+    variable.variablesReference = GetNextReferenceId();
+    ref.iCorValue->AddRef();
+    VariableReference variableReference(variable, ref.frameId, ref.iCorValue, ValueIsLazyProperty);
+    variableReference.memberIndex = memberIndex;
+    variableReference.memberIsStatic = memberIsStatic;
+    m_references.emplace_back(std::move(variableReference));
+
+    return S_OK;
+}
+
+HRESULT Variables::AddArrayRangeReference(Variable &variable, VariableReference &ref, ULONG32 rangeStart, ULONG32 rangeEnd)
+{
+    std::lock_guard<std::recursive_mutex> lock(m_referencesMutex);
+
+    if (m_references.size() >= MaxReferencesPerStop)
+        return E_FAIL;
+
+    variable.namedVariables = (int)GetArrayRangeNumChild(rangeEnd - rangeStart, m_groupHugeArrays);
+    variable.variablesReference = GetNextReferenceId();
+    ref.iCorValue->AddRef();
+    VariableReference variableReference(variable, ref.frameId, ref.iCorValue, ValueIsArrayRange);
+    // Group itself can't be evaluated, but its elements should be evaluated as array elements.
+    variableReference.evaluateName = ref.evaluateName;
+    variableReference.arrayRangeStart = rangeStart;
+    variableReference.arrayRangeEnd = rangeEnd;
+    m_references.emplace_back(std::move(variableReference));
+
+    return S_OK;
+}
+
+HRESULT Variables::AddCollectionRangeReference(Variable &variable, VariableReference &ref, ULONG32 rangeStart, ULONG32 rangeEnd)
+{
+    std::lock_guard<std::recursive_mutex> lock(m_referencesMutex);
+
+    if (m_references.size() >= MaxReferencesPerStop)
+        return E_FAIL;
+
+    variable.namedVariables = (int)GetArrayRangeNumChild(rangeEnd - rangeStart, m_groupHugeArrays);
+    variable.variablesReference = GetNextReferenceId();
+    ref.iCorValue->AddRef();
+    VariableReference variableReference(variable, ref.frameId, ref.iCorValue, ValueIsCollectionRange);
+    // Group have collection's evaluateName, since its elements evaluateName built from collection backing array.
+    variableReference.evaluateName = ref.evaluateName;
+    variableReference.arrayRangeStart = rangeStart;
+    variableReference.arrayRangeEnd = rangeEnd;
+    variableReference.collectionPositions = ref.collectionPositions;
+    m_references.emplace_back(std::move(variableReference));
+
+    return S_OK;
+}
+
+struct SnapshotBudget
+{
+    size_t &bytes;
+    std::chrono::steady_clock::time_point deadline;
+
+    bool Consume(size_t size)
+    {
+        if (size > bytes || std::chrono::steady_clock::now() > deadline)
+        {
+            bytes = 0;
+            return false;
+        }
+        bytes -= size;
+        return true;
+    }
+};
+
+static HRESULT CaptureSnapshotValue(Evaluator *pEvaluator, ICorDebugValue *pValue, const std::string &name, unsigned depth,
+                                    SnapshotBudget &budget, std::vector<Variable> &variables)
+{
+    Variable var;
+    var.name = name;
+    PrintValue(pValue, var.value);
+    TypePrinter::GetTypeOfValue(pValue, var.type);
+    if (!budget.Consume(var.name.size() + var.value.size() + var.type.size()))
+        return E_ABORT;
+
+    variables.push_back(std::move(var));
+    if (depth == 0)
+        return S_OK;
+
+    // Note, thread is not provided, so, no static constructors or properties getters will be called.
+    return pEvaluator->WalkMembers(pValue, nullptr, FrameLevel{0}, false,
+        [&](ICorDebugType *, bool is_static, const std::string &memberName, Evaluator::GetValueCallback getValue, Evaluator::SetterData *) -> HRESULT
+    {
+        if (is_static || memberName.empty())
+            return S_OK;
+
+        ToRelease<ICorDebugValue> pMemberValue;
+        if (FAILED(getValue(&pMemberValue, EVAL_NOFUNCEVAL)))
+            return S_OK; // property
+
+        std::string memberPath = memberName[0] == '[' ? name + memberName : name + "." + memberName;
+        return CaptureSnapshotValue(pEvaluator, pMemberValue, memberPath, depth - 1, budget, variables);
+    });
+}
+
+HRESULT Variables::CaptureSnapshotVariables(ICorDebugThread *pThread, FrameLevel frameLevel, unsigned depth, size_t &bytesBudget,
+                                            std::chrono::steady_clock::time_point deadline, std::vector<Variable> &variables)
+{
+    SnapshotBudget budget{bytesBudget, deadline};
+    HRESULT Status = m_sharedEvaluator->WalkStackVars(pThread, frameLevel,
+        [&](const std::string &name, Evaluator::GetValueCallback getValue) -> HRESULT
+    {
+        ToRelease<ICorDebugValue> pValue;
+        if (FAILED(getValue(&pValue, EVAL_NOFUNCEVAL)))
+            return S_OK;
+
+        return CaptureSnapshotValue(m_sharedEvaluator.get(), pValue, name, depth, budget, variables);
+    });
 
-    variable.namedVariables = numChild;
-    variable.variablesReference = (uint32_t)m_references.size() + 1;
-    pValue->AddRef();
-    VariableReference variableReference(variable, frameId, pValue, valueKind);
-    m_references.emplace(std::make_pair(variable.variablesReference, std::move(variableReference)));
+    if (Status == E_ABORT)
+        return S_FALSE;
 
-    return S_OK;
+    return Status;
 }
 
 HRESULT Variables::GetExceptionVariable(FrameId frameId, ICorDebugThread *pThread, Variable &var)
@@ -254,8 +1199,7 @@ HRESULT Variables::GetStackVariables(
         var.evaluateName = var.name;
         ToRelease<ICorDebugValue> iCorValue;
         IfFailRet(getValue(&iCorValue, var.evalFlags));
-        IfFailRet(PrintValue(iCorValue, var.value));
-        IfFailRet(TypePrinter::GetTypeOfValue(iCorValue, var.type));
+        IfFailRet(PrintValueAndType(frameId, iCorValue, var, PrintStringMaxLength));
         IfFailRet(AddVariableReference(var, frameId, iCorValue, ValueIsVariable));
         variables.push_back(var);
         return S_OK;
@@ -294,12 +1238,12 @@ HRESULT Variables::GetScopes(ICorDebugProcess *pProcess, FrameId frameId, std::v
     {
         std::lock_guard<std::recursive_mutex> lock(m_referencesMutex);
 
-        if (m_references.size() == std::numeric_limits<uint32_t>::max())
+        if (m_references.size() >= MaxReferencesPerStop)
             return E_FAIL;
 
-        variablesReference = (uint32_t)m_references.size() + 1;
+        variablesReference = GetNextReferenceId();
         VariableReference scopeReference(variablesReference, frameId, namedVariables);
-        m_references.emplace(std::make_pair(variablesReference, std::move(scopeReference)));
+        m_references.emplace_back(std::move(scopeReference));
     }
 
     scopes.emplace_back(variablesReference, "Locals", namedVariables);
@@ -333,13 +1277,40 @@ HRESULT Variables::GetChildren(
     if (!ref.iCorValue)
         return S_OK;
 
+    if (ref.valueKind == ValueIsArrayRange)
+        return GetArrayChildren(ref, pThread, ref.arrayRangeStart, ref.arrayRangeEnd, start, count, variables);
+
+    if (ref.valueKind == ValueIsLazyProperty)
+        return start == 0 ? GetLazyPropertyValue(ref, pThread, variables) : S_OK;
+
+    if (ref.valueKind == ValueIsCollectionRange)
+    {
+        HRESULT Status;
+        CollectionView view;
+        IfFailRet(GetCollectionView(m_sharedEvaluator.get(), ref.iCorValue, view));
+        return GetCollectionElements(ref, pThread, view, ref.arrayRangeStart, ref.arrayRangeEnd, start, count, variables);
+    }
+
+    ULONG32 arrayLength = 0;
+    if (ref.valueKind == ValueIsVariable && SUCCEEDED(GetArrayLength(ref.iCorValue, arrayLength)))
+        return GetArrayChildren(ref, pThread, 0, arrayLength, start, count, variables);
+
+    CollectionView view;
+    if (ref.valueKind == ValueIsVariable && SUCCEEDED(GetCollectionView(m_sharedEvaluator.get(), ref.iCorValue, view)))
+        return GetCollectionChildren(ref, pThread, view, start, count, variables);
+
     HRESULT Status;
     std::vector<VariableMember> members;
     bool hasStaticMembers = false;
 
+    // Read whole object data at once, in case of fail all fields will be read by COM path.
+    RawObjectData rawData(m_sharedEvalHelpers.get());
+    bool useRawData = ref.valueKind != ValueIsClass && SUCCEEDED(ReadRawObjectData(pThread, ref.iCorValue, rawData));
+
     IfFailRet(FetchFieldsAndProperties(m_sharedEvaluator.get(), ref.iCorValue, pThread, ref.frameId.getLevel(),
                                        members, ref.valueKind == ValueIsClass, hasStaticMembers, start,
-                                       count == 0 ? INT_MAX : start + count, ref.evalFlags));
+                                       count == 0 ? INT_MAX : start + count, ref.evalFlags, m_lazyProperties,
+                                       useRawData ? &rawData : nullptr));
 
     FixupInheritedFieldNames(members);
 
@@ -350,12 +1321,19 @@ HRESULT Variables::GetChildren(
         bool isIndex = !it.name.empty() && it.name.at(0) == '[';
         if (var.name.find('(') == std::string::npos) // expression evaluator does not support typecasts
             var.evaluateName = ref.evaluateName + (isIndex ? "" : ".") + var.name;
-        FillValueAndType(it, var);
+        if (it.lazy)
+        {
+            var.presentationHint.lazy = true;
+            IfFailRet(AddLazyPropertyReference(var, ref, it.index, ref.valueKind == ValueIsClass));
+            variables.push_back(var);
+            continue;
+        }
+        FillValueAndType(it, var, ref.frameId);
         IfFailRet(AddVariableReference(var, ref.frameId, it.value, ValueIsVariable));
         variables.push_back(var);
     }
 
-    if (ref.valueKind == ValueIsVariable && hasStaticMembers)
+    if ((ref.valueKind == ValueIsVariable || ref.valueKind == ValueIsRawView) && hasStaticMembers)
     {
         bool staticsInRange = start < ref.namedVariables && (count == 0 || start + count >= ref.namedVariables);
         if (staticsInRange)
@@ -379,12 +1357,417 @@ HRESULT Variables::GetChildren(
     return S_OK;
 }
 
+HRESULT Variables::GetLazyPropertyValue(VariableReference &ref, ICorDebugThread *pThread, std::vector<Variable> &variables)
+{
+    HRESULT Status;
+    std::vector<VariableMember> members;
+    bool hasStaticMembers = false;
+
+    // Walk object members again, but evaluate only this property.
+    IfFailRet(FetchFieldsAndProperties(m_sharedEvaluator.get(), ref.iCorValue, pThread, ref.frameId.getLevel(),
+                                       members, ref.memberIsStatic, hasStaticMembers, ref.memberIndex,
+                                       ref.memberIndex + 1, ref.evalFlags));
+    if (members.empty())
+        return E_FAIL;
+
+    Variable var(ref.evalFlags);
+    var.name = members[0].name;
+    var.evaluateName = ref.evaluateName;
+    FillValueAndType(members[0], var, ref.frameId);
+    IfFailRet(AddVariableReference(var, ref.frameId, members[0].value, ValueIsVariable));
+    variables.push_back(var);
+
+    return S_OK;
+}
+
+// Get collection's backing array element value and its field (for HashSet and Dictionary entries).
+static HRESULT GetStorageElement(Evaluator *pEvaluator, ICorDebugArrayValue *pStorage, ULONG32 position, const char *fieldName, ICorDebugValue **ppResultValue)
+{
+    HRESULT Status;
+    if (!fieldName)
+        return pStorage->GetElementAtPosition(position, ppResultValue);
+
+    ToRelease<ICorDebugValue> pElementValue;
+    IfFailRet(pStorage->GetElementAtPosition(position, &pElementValue));
+    return GetFieldValueByName(pEvaluator, pElementValue, fieldName, ppResultValue);
+}
+
+// Collect HashSet and Dictionary used entries positions, free entries are detected by `next` or `hashCode` field (see GetEntriesLayout()).
+// Note, fields are decoded from backing array data, read by chunks, in case of fail each entry field is read by COM path.
+static HRESULT GetCollectionPositions(Evaluator *pEvaluator, EvalHelpers *pEvalHelpers, ICorDebugThread *pThread,
+                                      ICorDebugArrayValue *pStorage, const CollectionView &view, std::vector<ULONG32> &positions)
+{
+    HRESULT Status;
+    // Used entry have `next` >= -1 (.NET 5+) or `hashCode` >= 0 (.NET Core 3.x).
+    const std::string freeMarkField = view.freeByHashCode ? "hashCode" : (view.kind == CollectionKind::HashSet ? "Next" : "next");
+    const int32_t usedMinValue = view.freeByHashCode ? 0 : -1;
+    positions.clear();
+    positions.reserve(view.count);
+    if (view.size == 0)
+        return S_OK;
+
+    auto readRaw = [&]() -> HRESULT
+    {
+        ToRelease<ICorDebugValue> pFirstEntry;
+        IfFailRet(pStorage->GetElementAtPosition(0, &pFirstEntry));
+        CORDB_ADDRESS address = 0;
+        ULONG32 stride = 0;
+        IfFailRet(pFirstEntry->GetAddress(&address));
+        IfFailRet(pFirstEntry->GetSize(&stride));
+        if (address == 0 || stride == 0)
+            return E_FAIL;
+
+        ToRelease<ICorDebugValue2> pEntryValue2;
+        IfFailRet(pFirstEntry->QueryInterface(IID_ICorDebugValue2, (LPVOID *) &pEntryValue2));
+        ToRelease<ICorDebugType> pEntryType;
+        IfFailRet(pEntryValue2->GetExactType(&pEntryType));
+        ToRelease<ICorDebugProcess> pProcess;
+        IfFailRet(pThread->GetProcess(&pProcess));
+        ToRelease<ICorDebugProcess5> pProcess5;
+        IfFailRet(pProcess->QueryInterface(IID_ICorDebugProcess5, (LPVOID *) &pProcess5));
+        std::shared_ptr<EvalHelpers::TypeLayout> typeLayout;
+        IfFailRet(pEvalHelpers->GetTypeLayout(pProcess5, pEntryType, typeLayout));
+
+        // Array element have unboxed value type data.
+        ULONG32 fieldOffset = 0;
+        auto it = std::find_if(typeLayout->fields.begin(), typeLayout->fields.end(),
+                               [&](const EvalHelpers::FieldLayout &field) { return field.name == freeMarkField; });
+        if (it == typeLayout->fields.end() || it->elemType != ELEMENT_TYPE_I4 ||
+            it->offset < typeLayout->boxOffset || it->offset - typeLayout->boxOffset + sizeof(int32_t) > stride)
+            return E_FAIL;
+        fieldOffset = it->offset - typeLayout->boxOffset;
+
+        static const ULONG32 chunkEntries = 64 * 1024;
+        std::vector<BYTE> data;
+        for (ULONG32 chunkStart = 0; chunkStart < view.size; chunkStart += chunkEntries)
+        {
+            ULONG32 chunkSize = std::min(chunkEntries, view.size - chunkStart);
+            data.resize((size_t)chunkSize * stride);
+            SIZE_T read = 0;
+            IfFailRet(pProcess->ReadMemory(address + (CORDB_ADDRESS)chunkStart * stride, (DWORD)data.size(), data.data(), &read));
+            if (read != data.size())
+                return E_FAIL;
+
+            for (ULONG32 i = 0; i < chunkSize; i++)
+            {
+                int32_t fieldValue = 0;
+                memcpy(&fieldValue, &data[(size_t)i * stride + fieldOffset], sizeof(fieldValue));
+                if (fieldValue >= usedMinValue)
+                    positions.push_back(chunkStart + i);
+            }
+        }
+        return S_OK;
+    };
+
+    if (SUCCEEDED(readRaw()))
+        return S_OK;
+
+    positions.clear();
+    for (ULONG32 i = 0; i < view.size; i++)
+    {
+        int32_t fieldValue = 0;
+        ToRelease<ICorDebugValue> pEntryValue;
+        IfFailRet(pStorage->GetElementAtPosition(i, &pEntryValue));
+        IfFailRet(GetIntFieldValue(pEvaluator, pEntryValue, freeMarkField, fieldValue));
+        if (fieldValue >= usedMinValue)
+            positions.push_back(i);
+    }
+    return S_OK;
+}
+
+HRESULT Variables::GetCollectionChildren(
+    VariableReference &ref,
+    ICorDebugThread *pThread,
+    CollectionView &view,
+    int start,
+    int count,
+    std::vector<Variable> &variables)
+{
+    if (start < 0)
+        return S_OK;
+
+    HRESULT Status;
+    ULONG32 elementsNumChild = GetCollectionElementsNumChild(view, m_groupHugeArrays);
+    ULONG32 endChild = (count == 0) ? elementsNumChild + 1 : std::min(elementsNumChild + 1, (ULONG32)start + (ULONG32)count);
+    ULONG32 endElement = std::min(endChild, elementsNumChild);
+    std::string storageEvaluateName = ref.evaluateName + "." + view.storageName;
+
+    if ((ULONG32)start < endElement)
+    {
+        if (view.kind == CollectionKind::List || view.kind == CollectionKind::ImmutableArray)
+        {
+            // Elements are first `count` elements of backing array, reuse array routine (including groups for huge collections).
+            Variable storageVar(ref.evalFlags);
+            storageVar.evaluateName = storageEvaluateName;
+            view.storage->AddRef();
+            VariableReference storageRef(storageVar, ref.frameId, view.storage, ValueIsVariable);
+            IfFailRet(GetArrayChildren(storageRef, pThread, 0, view.count, start, endElement - start, variables));
+        }
+        else
+        {
+            IfFailRet(GetCollectionElements(ref, pThread, view, 0, view.count, start, endElement - start, variables));
+        }
+    }
+
+    if (endChild > elementsNumChild)
+    {
+        Variable var(ref.evalFlags);
+        var.name = "Raw View";
+        var.evaluateName = ref.evaluateName;
+        IfFailRet(AddVariableReference(var, ref.frameId, ref.iCorValue, ValueIsRawView));
+        variables.push_back(var);
+    }
+
+    return S_OK;
+}
+
+// Dictionary element named by its key, only in case key printed value is unique (for example, not "{SomeType}" for object keys).
+static bool IsUniquelyPrintedKey(ICorDebugValue *pKeyValue)
+{
+    BOOL isNull = FALSE;
+    ToRelease<ICorDebugValue> pValue;
+    if (FAILED(DereferenceAndUnboxValue(pKeyValue, &pValue, &isNull)) || isNull || !pValue.GetPtr())
+        return false;
+
+    CorElementType elemType;
+    if (FAILED(pValue->GetType(&elemType)))
+        return false;
+
+    return elemType == ELEMENT_TYPE_STRING || IsPrimitiveElementType(elemType);
+}
+
+// Element name is "[key]" for Dictionary element with uniquely printed key (not used by previous elements), "[index]" otherwise.
+static std::string GetCollectionElementName(Evaluator *pEvaluator, ICorDebugArrayValue *pStorage, const CollectionView &view,
+                                            ULONG32 index, ULONG32 position, std::unordered_set<std::string> &keyNames)
+{
+    ToRelease<ICorDebugValue> pKeyValue;
+    if (view.kind == CollectionKind::Dictionary &&
+        SUCCEEDED(GetStorageElement(pEvaluator, pStorage, position, "key", &pKeyValue)) &&
+        IsUniquelyPrintedKey(pKeyValue))
+    {
+        std::string key;
+        if (SUCCEEDED(PrintValue(pKeyValue, key, true, PrintStringMaxLength)) && keyNames.insert(key).second)
+            return "[" + key + "]";
+    }
+    return "[" + std::to_string(index) + "]";
+}
+
+// Get HashSet, Dictionary or Queue backing array, for HashSet and Dictionary used entries positions are collected too.
+HRESULT Variables::GetCollectionStorage(VariableReference &ref, ICorDebugThread *pThread, CollectionView &view, ICorDebugArrayValue **ppStorage)
+{
+    HRESULT Status;
+    BOOL isNull = FALSE;
+    ToRelease<ICorDebugValue> pStorageValue;
+    IfFailRet(DereferenceAndUnboxValue(view.storage, &pStorageValue, &isNull));
+    ToRelease<ICorDebugArrayValue> pStorage;
+    IfFailRet(pStorageValue->QueryInterface(IID_ICorDebugArrayValue, (LPVOID *) &pStorage));
+
+    // Note, positions collected at first request only, so, next pages and groups don't rescan backing array.
+    if (view.kind != CollectionKind::Queue && !ref.collectionPositions)
+    {
+        auto positions = std::make_shared<std::vector<ULONG32>>();
+        IfFailRet(GetCollectionPositions(m_sharedEvaluator.get(), m_sharedEvalHelpers.get(), pThread, pStorage, view, *positions));
+        ref.collectionPositions = positions;
+    }
+    if (view.kind != CollectionKind::Queue && ref.collectionPositions->size() < view.count)
+        return E_FAIL;
+
+    *ppStorage = pStorage.Detach();
+    return S_OK;
+}
+
+// Fetch HashSet, Dictionary or Queue elements in [rangeStart, rangeEnd) logical indexes range (or groups in case of huge range).
+HRESULT Variables::GetCollectionElements(
+    VariableReference &ref,
+    ICorDebugThread *pThread,
+    CollectionView &view,
+    ULONG32 rangeStart,
+    ULONG32 rangeEnd,
+    int start,
+    int count,
+    std::vector<Variable> &variables)
+{
+    HRESULT Status;
+    if (start < 0 || rangeEnd <= rangeStart || rangeEnd > view.count)
+        return S_OK;
+
+    ToRelease<ICorDebugArrayValue> pStorage;
+    IfFailRet(GetCollectionStorage(ref, pThread, view, &pStorage));
+
+    ULONG32 groupElements = GetArrayGroupElements(rangeEnd - rangeStart, m_groupHugeArrays);
+    if (groupElements > 1)
+    {
+        ULONG32 numGroups = GetArrayRangeNumChild(rangeEnd - rangeStart, m_groupHugeArrays);
+        ULONG32 endGroup = (count == 0) ? numGroups : std::min(numGroups, (ULONG32)start + (ULONG32)count);
+        for (ULONG32 i = (ULONG32)start; i < endGroup; ++i)
+        {
+            ULONG32 groupStart = rangeStart + i * groupElements;
+            ULONG32 groupEnd = std::min(rangeEnd, groupStart + groupElements);
+
+            Variable var(ref.evalFlags);
+            var.name = "[" + std::to_string(groupStart) + ".." + std::to_string(groupEnd - 1) + "]";
+            IfFailRet(AddCollectionRangeReference(var, ref, groupStart, groupEnd));
+            variables.push_back(var);
+        }
+        return S_OK;
+    }
+
+    ULONG32 elementsStart = rangeStart + (ULONG32)start;
+    ULONG32 elementsEnd = (count == 0) ? rangeEnd : std::min(rangeEnd, elementsStart + (ULONG32)count);
+
+    std::string storageEvaluateName = ref.evaluateName + "." + view.storageName;
+    const char *valueField = nullptr;
+    const char *valueFieldName = "";
+    if (view.kind != CollectionKind::Queue)
+    {
+        valueField = view.kind == CollectionKind::HashSet ? "Value" : "value";
+        valueFieldName = view.kind == CollectionKind::HashSet ? ".Value" : ".value";
+    }
+
+    std::unordered_set<std::string> keyNames;
+    for (ULONG32 index = elementsStart; index < elementsEnd; index++)
+    {
+        ULONG32 position = view.kind == CollectionKind::Queue ? (view.head + index) % view.storageLength
+                                                             : (*ref.collectionPositions)[index];
+
+        ToRelease<ICorDebugValue> pElementValue;
+        if (FAILED(GetStorageElement(m_sharedEvaluator.get(), pStorage, position, valueField, &pElementValue)))
+            pElementValue.Free();
+
+        VariableMember member("", "", pElementValue.Detach());
+        Variable var(ref.evalFlags);
+        var.name = GetCollectionElementName(m_sharedEvaluator.get(), pStorage, view, index, position, keyNames);
+        var.evaluateName = storageEvaluateName + "[" + std::to_string(position) + "]" + valueFieldName;
+        FillValueAndType(member, var, ref.frameId);
+        IfFailRet(AddVariableReference(var, ref.frameId, member.value, ValueIsVariable));
+        variables.push_back(var);
+    }
+
+    return S_OK;
+}
+
+static HRESULT GetArrayRangeName(Evaluator *pEvaluator, ICorDebugValue *pValue, ULONG32 rangeStart, ULONG32 rangeEnd, std::string &name)
+{
+    HRESULT Status;
+    std::string firstName;
+    std::string lastName;
+    auto getName = [](std::string &elementName) -> Evaluator::WalkMembersCallback
+    {
+        return [&elementName](ICorDebugType*, bool, const std::string &name, Evaluator::GetValueCallback, Evaluator::SetterData*)
+        {
+            elementName = name;
+            return S_OK;
+        };
+    };
+    IfFailRet(pEvaluator->WalkArrayElements(pValue, rangeStart, rangeStart + 1, getName(firstName)));
+    IfFailRet(pEvaluator->WalkArrayElements(pValue, rangeEnd - 1, rangeEnd, getName(lastName)));
+    if (firstName.empty() || lastName.empty())
+        return E_FAIL;
+
+    // Elements have "[indexes]" names, group have "[first indexes..last indexes]" name.
+    name = firstName.substr(0, firstName.size() - 1) + ".." + lastName.substr(1);
+    return S_OK;
+}
+
+// Fetch only requested elements by position, instead of walk through all array elements.
+HRESULT Variables::GetArrayChildren(
+    VariableReference &ref,
+    ICorDebugThread *pThread,
+    ULONG32 rangeStart,
+    ULONG32 rangeEnd,
+    int start,
+    int count,
+    std::vector<Variable> &variables)
+{
+    HRESULT Status;
+    if (start < 0 || rangeEnd <= rangeStart)
+        return S_OK;
+
+    ULONG32 groupElements = GetArrayGroupElements(rangeEnd - rangeStart, m_groupHugeArrays);
+    if (groupElements > 1)
+    {
+        ULONG32 numGroups = GetArrayRangeNumChild(rangeEnd - rangeStart, m_groupHugeArrays);
+        ULONG32 endGroup = (count == 0) ? numGroups : std::min(numGroups, (ULONG32)start + (ULONG32)count);
+        for (ULONG32 i = (ULONG32)start; i < endGroup; ++i)
+        {
+            ULONG32 groupStart = rangeStart + i * groupElements;
+            ULONG32 groupEnd = std::min(rangeEnd, groupStart + groupElements);
+
+            Variable var(ref.evalFlags);
+            IfFailRet(GetArrayRangeName(m_sharedEvaluator.get(), ref.iCorValue, groupStart, groupEnd, var.name));
+            IfFailRet(AddArrayRangeReference(var, ref, groupStart, groupEnd));
+            variables.push_back(var);
+        }
+        return S_OK;
+    }
+
+    ULONG32 elementsStart = rangeStart + (ULONG32)start;
+    ULONG32 elementsEnd = (count == 0) ? rangeEnd : std::min(rangeEnd, elementsStart + (ULONG32)count);
+    if (elementsStart >= elementsEnd)
+        return S_OK;
+
+    // Fast path for primitive type elements, all requested elements data read by one memory read, elements don't have children.
+    CorElementType elemType;
+    std::string elemTypeName;
+    ULONG32 elemSize = 0;
+    std::vector<BYTE> data;
+    if (SUCCEEDED(ReadPrimitiveArrayData(pThread, ref.iCorValue, elementsStart, elementsEnd, elemType, elemTypeName, elemSize, data)))
+    {
+        size_t dataOffset = 0;
+        // Note, getValue is not called here, walk used for elements names only.
+        return m_sharedEvaluator->WalkArrayElements(ref.iCorValue, elementsStart, elementsEnd, [&](
+            ICorDebugType*,
+            bool,
+            const std::string &name,
+            Evaluator::GetValueCallback,
+            Evaluator::SetterData*) -> HRESULT
+        {
+            if (dataOffset + elemSize > data.size())
+                return E_FAIL;
+
+            Variable var(ref.evalFlags);
+            var.name = name;
+            var.evaluateName = ref.evaluateName + var.name;
+            var.type = elemTypeName;
+            IfFailRet(PrintBasicValue(elemType, &data[dataOffset], var.value));
+            MarkChangedValue(ref.frameId, var);
+            dataOffset += elemSize;
+            variables.push_back(var);
+            return S_OK;
+        });
+    }
+
+    return m_sharedEvaluator->WalkArrayElements(ref.iCorValue, elementsStart, elementsEnd, [&](
+        ICorDebugType*,
+        bool,
+        const std::string &name,
+        Evaluator::GetValueCallback getValue,
+        Evaluator::SetterData*) -> HRESULT
+    {
+        // Note, in this case error is not fatal, but if protocol side need cancel command execution, stop walk and return error to caller.
+        ToRelease<ICorDebugValue> iCorResultValue;
+        if (getValue(&iCorResultValue, ref.evalFlags) == COR_E_OPERATIONCANCELED)
+            return COR_E_OPERATIONCANCELED;
+
+        VariableMember member(name, "", iCorResultValue.Detach());
+        Variable var(ref.evalFlags);
+        var.name = member.name;
+        var.evaluateName = ref.evaluateName + var.name;
+        FillValueAndType(member, var, ref.frameId);
+        IfFailRet(AddVariableReference(var, ref.frameId, member.value, ValueIsVariable));
+        variables.push_back(var);
+        return S_OK;
+    });
+}
+
 HRESULT Variables::Evaluate(
     ICorDebugProcess *pProcess,
     FrameId frameId,
     const std::string &expression,
     Variable &variable,
-    std::string &output)
+    std::string &output,
+    bool truncateStrings,
+    bool internalEval)
 {
     ThreadId threadId = frameId.getThread();
     if (!threadId)
@@ -398,12 +1781,68 @@ HRESULT Variables::Evaluate(
     FrameLevel frameLevel = frameId.getLevel();
     IfFailRet(m_sharedEvalStackMachine->EvaluateExpression(pThread, frameLevel, variable.evalFlags, expression, &pResultValue, output, &variable.editable));
 
+    // Note, internal evaluation result (for example, breakpoint condition) is not shown to user,
+    // so, values history should not be changed and reference is not needed.
+    if (internalEval)
+    {
+        IfFailRet(TypePrinter::GetTypeOfValue(pResultValue, variable.type));
+        return PrintValue(pResultValue, variable.value);
+    }
+
+    UpdateFrameMethodKey(pThread, frameId);
     variable.evaluateName = expression;
-    IfFailRet(PrintValue(pResultValue, variable.value));
-    IfFailRet(TypePrinter::GetTypeOfValue(pResultValue, variable.type));
+    IfFailRet(PrintValueAndType(frameId, pResultValue, variable, truncateStrings ? PrintStringMaxLength : std::numeric_limits<ULONG32>::max()));
     return AddVariableReference(variable, frameId, pResultValue, ValueIsVariable);
 }
 
+// Read part of string value, since variable view show only first PrintStringMaxLength chars of string.
+HRESULT Variables::ReadStringValue(
+    ICorDebugProcess *pProcess,
+    FrameId frameId,
+    const std::string &expression,
+    int offset,
+    int count,
+    std::string &value,
+    int &totalLength,
+    int &readLength,
+    std::string &output)
+{
+    ThreadId threadId = frameId.getThread();
+    if (!threadId || offset < 0 || count < 0)
+        return E_INVALIDARG;
+
+    HRESULT Status;
+    ToRelease<ICorDebugThread> pThread;
+    IfFailRet(pProcess->GetThread(int(threadId), &pThread));
+
+    ToRelease<ICorDebugValue> pResultValue;
+    IfFailRet(m_sharedEvalStackMachine->EvaluateExpression(pThread, frameId.getLevel(), defaultEvalFlags, expression, &pResultValue, output));
+
+    BOOL isNull = FALSE;
+    ToRelease<ICorDebugValue> pValue;
+    IfFailRet(DereferenceAndUnboxValue(pResultValue, &pValue, &isNull));
+    if (isNull)
+    {
+        output = "'" + expression + "' is null";
+        return E_INVALIDARG;
+    }
+
+    CorElementType corType;
+    IfFailRet(pValue->GetType(&corType));
+    if (corType != ELEMENT_TYPE_STRING)
+    {
+        output = "'" + expression + "' is not a string";
+        return E_INVALIDARG;
+    }
+
+    ULONG32 length = 0;
+    ULONG32 read = 0;
+    IfFailRet(netcoredbg::ReadStringValue(pProcess, pValue, (ULONG32)offset, count == 0 ? PrintStringMaxLength : (ULONG32)count, value, &length, &read));
+    totalLength = (int)length;
+    readLength = (int)read;
+    return S_OK;
+}
+
 HRESULT Variables::SetVariable(
     ICorDebugProcess *pProcess,
     const std::string &name,
@@ -413,11 +1852,11 @@ HRESULT Variables::SetVariable(
 {
     std::lock_guard<std::recursive_mutex> lock(m_referencesMutex);
 
-    auto it = m_references.find(ref);
-    if (it == m_references.end())
+    VariableReference *pRef = FindReference(ref);
+    if (!pRef)
         return E_FAIL;
 
-    VariableReference &varRef = it->second;
+    VariableReference &varRef = *pRef;
     HRESULT Status;
 
     ToRelease<ICorDebugThread> pThread;
@@ -478,6 +1917,28 @@ HRESULT Variables::SetChild(
 
     HRESULT Status;
 
+    CollectionView view;
+    if ((ref.valueKind == ValueIsVariable || ref.valueKind == ValueIsCollectionRange) &&
+        SUCCEEDED(GetCollectionView(m_sharedEvaluator.get(), ref.iCorValue, view)))
+        return SetCollectionElement(ref, pThread, view, name, value, output);
+
+    // Index array element directly, since walk through all members is O(N) for huge arrays.
+    ULONG32 arrayLength = 0;
+    if ((ref.valueKind == ValueIsVariable || ref.valueKind == ValueIsArrayRange) && SUCCEEDED(GetArrayLength(ref.iCorValue, arrayLength)))
+    {
+        ULONG32 position = 0;
+        ToRelease<ICorDebugValue> iCorValue;
+        if (FAILED(GetArrayElementByName(ref.iCorValue, name, position, &iCorValue)) ||
+            (ref.valueKind == ValueIsArrayRange && (position < ref.arrayRangeStart || position >= ref.arrayRangeEnd)))
+        {
+            output = "'" + name + "' cannot be assigned to";
+            return E_INVALIDARG;
+        }
+
+        IfFailRet(m_sharedEvaluator->SetValue(pThread, ref.frameId.getLevel(), iCorValue, nullptr, value, ref.evalFlags, output));
+        return PrintValue(iCorValue, output);
+    }
+
     if (FAILED(Status = m_sharedEvaluator->WalkMembers(ref.iCorValue, pThread, ref.frameId.getLevel(), true, [&](
         ICorDebugType*,
         bool is_static,
@@ -504,6 +1965,66 @@ HRESULT Variables::SetChild(
     return S_OK;
 }
 
+// Collection view show elements instead of collection fields, so, element name is resolved to backing array element.
+HRESULT Variables::SetCollectionElement(
+    VariableReference &ref,
+    ICorDebugThread *pThread,
+    CollectionView &view,
+    const std::string &name,
+    const std::string &value,
+    std::string &output)
+{
+    HRESULT Status;
+    ULONG32 rangeStart = ref.valueKind == ValueIsCollectionRange ? ref.arrayRangeStart : 0;
+    ULONG32 rangeEnd = ref.valueKind == ValueIsCollectionRange ? ref.arrayRangeEnd : view.count;
+
+    const std::string cannotAssign = "'" + name + "' cannot be assigned to";
+
+    // Note, HashSet element can't be changed in place, since element position depends on its hash code.
+    if (view.kind == CollectionKind::HashSet || rangeEnd <= rangeStart || rangeEnd > view.count ||
+        GetArrayGroupElements(rangeEnd - rangeStart, m_groupHugeArrays) > 1)
+    {
+        output = cannotAssign;
+        return E_INVALIDARG;
+    }
+
+    ToRelease<ICorDebugValue> pElementValue;
+    if (view.kind == CollectionKind::List || view.kind == CollectionKind::ImmutableArray)
+    {
+        // Elements are first `count` elements of backing array (see GetCollectionChildren()).
+        ULONG32 position = 0;
+        if (FAILED(GetArrayElementByName(view.storage, name, position, &pElementValue)) || position >= view.count)
+            pElementValue.Free();
+    }
+    else
+    {
+        ToRelease<ICorDebugArrayValue> pStorage;
+        IfFailRet(GetCollectionStorage(ref, pThread, view, &pStorage));
+
+        std::unordered_set<std::string> keyNames;
+        for (ULONG32 index = rangeStart; index < rangeEnd; index++)
+        {
+            ULONG32 position = view.kind == CollectionKind::Queue ? (view.head + index) % view.storageLength
+                                                                 : (*ref.collectionPositions)[index];
+            if (GetCollectionElementName(m_sharedEvaluator.get(), pStorage, view, index, position, keyNames) != name)
+                continue;
+
+            IfFailRet(GetStorageElement(m_sharedEvaluator.get(), pStorage, position,
+                                        view.kind == CollectionKind::Queue ? nullptr : "value", &pElementValue));
+            break;
+        }
+    }
+
+    if (pElementValue == nullptr)
+    {
+        output = cannotAssign;
+        return E_INVALIDARG;
+    }
+
+    IfFailRet(m_sharedEvaluator->SetValue(pThread, ref.frameId.getLevel(), pElementValue, nullptr, value, ref.evalFlags, output));
+    return PrintValue(pElementValue, output);
+}
+
 HRESULT Variables::SetExpression(ICorDebugProcess *pProcess, FrameId frameId, const std::string &expression,
                                  int evalFlags, const std::string &value, std::string &output)
 {
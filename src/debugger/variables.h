@@ -6,8 +6,13 @@
 #include "cor.h"
 #include "cordebug.h"
 
+#include <chrono>
+#include <cstdint>
 #include <mutex>
+#include <deque>
+#include <memory>
 #include <unordered_map>
+#include <vector>
 #include "interfaces/types.h"
 #include "utils/torelease.h"
 
@@ -18,6 +23,8 @@ class Evaluator;
 class EvalHelpers;
 class EvalWaiter;
 class EvalStackMachine;
+struct CollectionView;
+struct VariableMember;
 
 class Variables
 {
@@ -28,7 +35,11 @@ public:
               std::shared_ptr<EvalStackMachine> &sharedEvalStackMachine) :
         m_sharedEvalHelpers(sharedEvalHelpers),
         m_sharedEvaluator(sharedEvaluator),
-        m_sharedEvalStackMachine(sharedEvalStackMachine)
+        m_sharedEvalStackMachine(sharedEvalStackMachine),
+        m_referencesBase(0),
+        m_stopCount(0),
+        m_lazyProperties(false),
+        m_groupHugeArrays(false)
     {}
 
     int GetNamedVariables(uint32_t variablesReference);
@@ -66,6 +77,19 @@ public:
         FrameId frameId,
         const std::string &expression,
         Variable &variable,
+        std::string &output,
+        bool truncateStrings,
+        bool internalEval = false);
+
+    HRESULT ReadStringValue(
+        ICorDebugProcess *pProcess,
+        FrameId frameId,
+        const std::string &expression,
+        int offset,
+        int count,
+        std::string &value,
+        int &totalLength,
+        int &readLength,
         std::string &output);
 
     HRESULT GetExceptionVariable(
@@ -73,12 +97,30 @@ public:
         ICorDebugThread *pThread,
         Variable &variable);
 
-    void Clear()
-    {
-        m_referencesMutex.lock();
-        m_references.clear();
-        m_referencesMutex.unlock();
-    }
+    // Capture variables of frame for snapshot breakpoint. Note, no func-eval here (properties and static members are skipped),
+    // S_FALSE returned in case capture was truncated by `bytesBudget` or `deadline`.
+    HRESULT CaptureSnapshotVariables(
+        ICorDebugThread *pThread,
+        FrameLevel frameLevel,
+        unsigned depth,
+        size_t &bytesBudget,
+        std::chrono::steady_clock::time_point deadline,
+        std::vector<Variable> &variables);
+
+    // In lazy mode properties are not evaluated during object expansion, but returned as placeholders
+    // with own variablesReference, getter is called only when user expand placeholder.
+    void SetLazyProperties(bool enable) { m_lazyProperties = enable; }
+
+    // Show huge arrays and collections elements as "[0..999]"-like groups. Note, protocol must support paged
+    // elements request, so, this is enabled for VSCode protocol only, MI/CLI frontends expect elements.
+    void SetGroupHugeArrays(bool enable) { m_groupHugeArrays = enable; }
+
+    // Invalidate all references. Note, references data (include COM objects) released before return,
+    // so, caller must call it before process continue.
+    void Clear();
+
+    // Drop values printed at previous stops (see m_valuesHistory), should be called at debug session end.
+    void ClearValuesHistory();
 
 private:
 
@@ -86,7 +128,11 @@ private:
     {
         ValueIsScope,
         ValueIsClass,
-        ValueIsVariable
+        ValueIsVariable,
+        ValueIsArrayRange, // "[0..999]"-like group of elements of huge array
+        ValueIsLazyProperty, // not evaluated yet property of object
+        ValueIsRawView, // collection object members, instead of collection elements view
+        ValueIsCollectionRange // "[0..999]"-like group of elements of huge collection
     };
 
     struct VariableReference
@@ -102,6 +148,17 @@ private:
         ToRelease<ICorDebugValue> iCorValue;
         FrameId frameId;
 
+        // Elements positions range for ValueIsArrayRange, logical elements indexes range for ValueIsCollectionRange.
+        ULONG32 arrayRangeStart;
+        ULONG32 arrayRangeEnd;
+
+        // HashSet and Dictionary used entries positions in backing array, collected once and shared with groups.
+        std::shared_ptr<std::vector<ULONG32>> collectionPositions;
+
+        // Member position in object members walk and its kind for ValueIsLazyProperty.
+        int memberIndex;
+        bool memberIsStatic;
+
         VariableReference(const Variable &variable, FrameId frameId, ICorDebugValue *pValue, ValueKind valueKind) :
             variablesReference(variable.variablesReference),
             namedVariables(variable.namedVariables),
@@ -110,7 +167,11 @@ private:
             evaluateName(variable.evaluateName),
             valueKind(valueKind),
             iCorValue(pValue),
-            frameId(frameId)
+            frameId(frameId),
+            arrayRangeStart(0),
+            arrayRangeEnd(0),
+            memberIndex(0),
+            memberIsStatic(false)
         {}
 
         VariableReference(uint32_t variablesReference, FrameId frameId, int namedVariables) :
@@ -120,7 +181,11 @@ private:
             evalFlags(0), // unused in this case, not involved into GetScopes routine
             valueKind(ValueIsScope),
             iCorValue(nullptr),
-            frameId(frameId)
+            frameId(frameId),
+            arrayRangeStart(0),
+            arrayRangeEnd(0),
+            memberIndex(0),
+            memberIsStatic(false)
         {}
 
         bool IsScope() const { return valueKind == ValueIsScope; }
@@ -133,10 +198,52 @@ private:
     std::shared_ptr<Evaluator> m_sharedEvaluator;
     std::shared_ptr<EvalStackMachine> m_sharedEvalStackMachine;
 
+    // Reference id = m_referencesBase + position in m_references + 1, base moved behind all ids of previous stop
+    // at each Clear() call, so, ids are not reused by next stops until base wrap around.
+    static const uint32_t MaxReferenceId = INT32_MAX; // DAP protocol use signed 32 bit int for reference
+    static const size_t MaxReferencesPerStop = (1u << 24) - 1;
+
     std::recursive_mutex m_referencesMutex;
-    std::unordered_map<uint32_t, VariableReference> m_references;
+    // Note, std::deque used in order to keep VariableReference references valid during new elements add.
+    std::deque<VariableReference> m_references;
+    uint32_t m_referencesBase;
+
+    uint32_t GetNextReferenceId();
+    VariableReference *FindReference(uint32_t variablesReference);
+
+    // Printed values from previous stops, in order to reuse printing for unchanged primitives and strings
+    // and mark values changed since previous stop. Key is thread, frame level, frame method identity and evaluateName.
+    struct PrintedValue
+    {
+        CorElementType elemType;
+        std::vector<BYTE> rawData; // primitive value data or string chars, empty in case value can't be compared by raw data
+        std::string value;
+        std::string type;
+        uint64_t stopCount; // stop, at which value was printed last time
+        bool changed; // value was changed since previous stop
+    };
+    static const size_t MaxValuesHistorySize = 10000;
+
+    std::mutex m_valuesHistoryMutex;
+    std::unordered_map<std::string, PrintedValue> m_valuesHistory;
+    uint64_t m_stopCount;
+    // Frame method identity (module, method token and code version) by frame id, collected for current stop only.
+    std::unordered_map<int, std::string> m_frameMethodKeys;
+
+    void UpdateFrameMethodKey(ICorDebugThread *pThread, FrameId frameId);
+    bool GetValuesHistoryKey(FrameId frameId, const std::string &evaluateName, std::string &key);
+    void UpdateValuesHistory(const std::string &key, const Variable &var, CorElementType elemType, std::vector<BYTE> &&rawData, bool &changed);
+    HRESULT PrintValueAndType(FrameId frameId, ICorDebugValue *pValue, Variable &var, ULONG32 maxStringLength);
+    void MarkChangedValue(FrameId frameId, Variable &var);
+    void FillValueAndType(VariableMember &member, Variable &var, FrameId frameId);
+
+    bool m_lazyProperties;
+    bool m_groupHugeArrays;
 
     HRESULT AddVariableReference(Variable &variable, FrameId frameId, ICorDebugValue *pValue, ValueKind valueKind);
+    HRESULT AddArrayRangeReference(Variable &variable, VariableReference &ref, ULONG32 rangeStart, ULONG32 rangeEnd);
+    HRESULT AddLazyPropertyReference(Variable &variable, VariableReference &ref, int memberIndex, bool memberIsStatic);
+    HRESULT AddCollectionRangeReference(Variable &variable, VariableReference &ref, ULONG32 rangeStart, ULONG32 rangeEnd);
 
     HRESULT GetStackVariables(
         FrameId frameId,
@@ -152,6 +259,44 @@ private:
         int count,
         std::vector<Variable> &variables);
 
+    HRESULT GetCollectionChildren(
+        VariableReference &ref,
+        ICorDebugThread *pThread,
+        CollectionView &view,
+        int start,
+        int count,
+        std::vector<Variable> &variables);
+
+    HRESULT GetCollectionElements(
+        VariableReference &ref,
+        ICorDebugThread *pThread,
+        CollectionView &view,
+        ULONG32 rangeStart,
+        ULONG32 rangeEnd,
+        int start,
+        int count,
+        std::vector<Variable> &variables);
+
+    HRESULT GetCollectionStorage(
+        VariableReference &ref,
+        ICorDebugThread *pThread,
+        CollectionView &view,
+        ICorDebugArrayValue **ppStorage);
+
+    HRESULT GetLazyPropertyValue(
+        VariableReference &ref,
+        ICorDebugThread *pThread,
+        std::vector<Variable> &variables);
+
+    HRESULT GetArrayChildren(
+        VariableReference &ref,
+        ICorDebugThread *pThread,
+        ULONG32 rangeStart,
+        ULONG32 rangeEnd,
+        int start,
+        int count,
+        std::vector<Variable> &variables);
+
     HRESULT SetStackVariable(
         VariableReference &ref,
         ICorDebugThread *pThread,
@@ -166,6 +311,14 @@ private:
         const std::string &value,
         std::string &output);
 
+    HRESULT SetCollectionElement(
+        VariableReference &ref,
+        ICorDebugThread *pThread,
+        CollectionView &view,
+        const std::string &name,
+        const std::string &value,
+        std::string &output);
+
 };
 
 } // namespace netcoredbg
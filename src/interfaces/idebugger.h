@@ -73,6 +73,10 @@ public:
     virtual void SetJustMyCode(bool enable) = 0;
     virtual bool IsStepFiltering() const = 0;
     virtual void SetStepFiltering(bool enable) = 0;
+    virtual bool IsLazyProperties() const = 0;
+    virtual void SetLazyProperties(bool enable) = 0;
+    virtual void SetGroupHugeArrays(bool enable) = 0;
+    virtual HRESULT SetTypeObjectCacheCapacity(unsigned capacity) = 0;
     virtual bool IsHotReload() const = 0;
     virtual HRESULT SetHotReload(bool enable) = 0;
     virtual HRESULT Initialize() = 0;
@@ -91,12 +95,29 @@ public:
     virtual HRESULT BreakpointActivate(int id, bool act) = 0;
     virtual void EnumerateBreakpoints(std::function<bool (const BreakpointInfo&)>&& callback) = 0;
     virtual HRESULT AllBreakpointsActivate(bool act) = 0;
+    // Note, in case `maxFrames` is not 0, stack is not unwound after requested frames and `totalFrames` is -1 (unknown)
+    // in case more frames exist after requested range.
     virtual HRESULT GetStackTrace(ThreadId threadId, FrameLevel startFrame, unsigned maxFrames, std::vector<StackFrame> &stackFrames, int &totalFrames, bool hotReloadAwareCaller = false) = 0;
+    // Stack traces of all threads by one call, threads with identical stacks are grouped (callback called once for each group,
+    // frames ids belong to first thread of group). Note, `maxFrames` 0 means all frames.
+    // Note, groups are not streamed, callback is called after all threads walk, since grouping and order need all stacks.
+    typedef std::function<void(const std::vector<ThreadId> &threads, const std::vector<StackFrame> &stackFrames)> ThreadsStackCallback;
+    virtual HRESULT GetThreadsStackTraces(unsigned maxFrames, ThreadsStackCallback cb) = 0;
+    // Sampling profiler, process is stopped each `intervalMs` for managed stacks of all threads capture.
+    virtual HRESULT StartSampling(unsigned intervalMs) = 0;
+    virtual HRESULT StopSampling(SamplingFormat format, std::string &profile, SamplingStats &stats) = 0;
+    // Stop events latency statistics (time spent by debugger from step request or debuggee event till stop event emitted).
+    virtual HRESULT EnableLatencyStats(bool enable) = 0;
+    virtual HRESULT GetLatencyStats(bool reset, std::vector<StopLatencyStats> &stats, CallbacksQueueStats &queueStats,
+                                    TypeObjectCacheStats &typeObjectCacheStats) = 0;
     virtual HRESULT StepCommand(ThreadId threadId, StepType stepType) = 0;
     virtual HRESULT GetScopes(FrameId frameId, std::vector<Scope> &scopes) = 0;
     virtual HRESULT GetVariables(uint32_t variablesReference, VariablesFilter filter, int start, int count, std::vector<Variable> &variables) = 0;
     virtual int GetNamedVariables(uint32_t variablesReference) = 0;
-    virtual HRESULT Evaluate(FrameId frameId, const std::string &expression, Variable &variable, std::string &output) = 0;
+    // Note, long strings are printed truncated (see PrintStringMaxLength) in case `truncateStrings` is true, for example, for hover.
+    virtual HRESULT Evaluate(FrameId frameId, const std::string &expression, Variable &variable, std::string &output, bool truncateStrings) = 0;
+    virtual HRESULT ReadStringValue(FrameId frameId, const std::string &expression, int offset, int count, std::string &value, int &totalLength, int &readLength, std::string &output) = 0;
+    virtual HRESULT ReadMemory(uint64_t address, uint32_t count, std::vector<uint8_t> &data, uint32_t &unreadableBytes) = 0;
     virtual void CancelEvalRunning() = 0;
     virtual HRESULT SetVariable(const std::string &name, const std::string &value, uint32_t ref, std::string &output) = 0;
     virtual HRESULT SetExpression(FrameId frameId, const std::string &expression, int evalFlags, const std::string &value, std::string &output) = 0;
@@ -375,6 +375,9 @@ struct VariablePresentationHint
     std::string kind;
     std::vector<std::string> attributes;
     std::string visibility;
+    bool lazy; // value should be fetched by separate `variables` request (see variablesReference)
+
+    VariablePresentationHint() : lazy(false) {}
 };
 
 // https://docs.microsoft.com/en-us/visualstudio/extensibility/debugger/reference/evalflags
@@ -402,8 +405,10 @@ struct Variable
     int indexedVariables;
     int evalFlags;
     bool editable;
+    uint64_t memoryReference; // address of array data for memory view, 0 if not available
+    bool changed; // value was changed since previous stop
 
-    Variable(int flags = defaultEvalFlags) : variablesReference(0), namedVariables(0), indexedVariables(0), evalFlags(flags), editable(false) {}
+    Variable(int flags = defaultEvalFlags) : variablesReference(0), namedVariables(0), indexedVariables(0), evalFlags(flags), editable(false), memoryReference(0), changed(false) {}
 };
 
 enum VariablesFilter
@@ -413,11 +418,43 @@ enum VariablesFilter
     VariablesBoth
 };
 
+// Snapshot breakpoint don't stop process, but capture stack and variables of top frames (without func-eval) and
+// continue process at once. Captured data is limited by time and size budgets, in order to keep pause short.
+struct SnapshotOptions
+{
+    unsigned frames; // top frames with captured variables, 0 - regular (stopping) breakpoint
+    unsigned depth; // levels of captured object fields, 0 - only variables values
+    unsigned maxBytes; // captured names, values and types total size
+    unsigned maxTimeMs; // capture time
+
+    SnapshotOptions() : frames(0), depth(1), maxBytes(64 * 1024), maxTimeMs(5) {}
+
+    bool IsEnabled() const { return frames != 0; }
+};
+
+struct SnapshotFrame
+{
+    StackFrame frame;
+    std::vector<Variable> variables; // `name` is full path to value, for example, "obj.field"
+};
+
+struct SnapshotEvent
+{
+    uint32_t breakpointId;
+    ThreadId threadId;
+    std::vector<SnapshotFrame> frames;
+    bool truncated; // time or size budget was exceeded
+    uint64_t captureUs;
+
+    SnapshotEvent(uint32_t breakpointId, ThreadId threadId) : breakpointId(breakpointId), threadId(threadId), truncated(false), captureUs(0) {}
+};
+
 struct LineBreakpoint
 {
     std::string module;
     int line;
     std::string condition;
+    SnapshotOptions snapshot;
 
     LineBreakpoint(const std::string &module,
                    int linenum,
@@ -524,4 +561,80 @@ struct ExceptionBreakpoint
     }
 };
 
+enum class SamplingFormat
+{
+    Collapsed, // Brendan Gregg's collapsed stacks, "frame;frame;frame count" lines
+    Speedscope // speedscope JSON file format
+};
+
+// Sampling profiler overhead, time while process was stopped in order to capture stacks.
+struct SamplingStats
+{
+    unsigned samples;
+    uint64_t pauseTotalUs;
+    uint64_t pauseMaxUs;
+
+    SamplingStats() : samples(0), pauseTotalUs(0), pauseMaxUs(0) {}
+};
+
+// Stop event latency percentiles for one processing phase, in microseconds.
+struct LatencyPercentiles
+{
+    uint64_t p50;
+    uint64_t p90;
+    uint64_t p99;
+    uint64_t max;
+
+    LatencyPercentiles() : p50(0), p90(0), p99(0), max(0) {}
+};
+
+// Debugger side latency of stop events for one operation ("stepOver", "stepIn", "stepOut" or stop reason
+// "breakpoint", "pause", "exception", "entry" for other stop events):
+// request - step command processing (step setup) before process continue;
+// queue - debugger callback waiting in callbacks queue;
+// callback - debugger callback processing (breakpoints and steppers checks);
+// symbols - stop location lookup;
+// emit - protocol event emission;
+// total - sum of all phases.
+struct StopLatencyStats
+{
+    std::string operation;
+    unsigned count;
+    LatencyPercentiles request;
+    LatencyPercentiles queue;
+    LatencyPercentiles callback;
+    LatencyPercentiles symbols;
+    LatencyPercentiles emit;
+    LatencyPercentiles total;
+
+    StopLatencyStats(const std::string &operation) : operation(operation), count(0) {}
+};
+
+// Type objects cache (static members access) statistics, see EvalHelpers.
+struct TypeObjectCacheStats
+{
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t evictions;
+    unsigned size;
+    unsigned capacity;
+
+    TypeObjectCacheStats() : hits(0), misses(0), evictions(0), size(0), capacity(0) {}
+
+    // Each cached type object holds GC handle, so, capacity is limited (see IDebugger::SetTypeObjectCacheCapacity()).
+    static const unsigned MaxCapacity = 10000;
+};
+
+// Managed callbacks queue statistics for all dispatched callbacks (not only stop events):
+// maxDepth - max queue depth observed at dispatch;
+// delay - time between callback arrival and dispatch.
+struct CallbacksQueueStats
+{
+    unsigned count;
+    unsigned maxDepth;
+    LatencyPercentiles delay;
+
+    CallbacksQueueStats() : count(0), maxDepth(0) {}
+};
+
 } // namespace netcoredbg
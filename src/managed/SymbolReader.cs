@@ -391,49 +391,6 @@ namespace NetCoreDbg
             return RetCode.OK;
         }
 
-        /// <summary>
-        /// Find IL offset for next close user code sequence point by IL offset.
-        /// </summary>
-        /// <param name="symbolReaderHandle">symbol reader handle returned by LoadSymbolsForModule</param>
-        /// <param name="methodToken">method token</param>
-        /// <param name="ilOffset">IL offset</param>
-        /// <param name="sequencePoint">sequence point return</param>
-        /// <param name="noUserCodeFound">return 1 in case all sequence points checked and no user code was found, otherwise return 0</param>
-        /// <returns>"Ok" if information is available</returns>
-        private static RetCode GetNextUserCodeILOffset(IntPtr symbolReaderHandle, int methodToken, uint ilOffset, out uint ilNextOffset, out int noUserCodeFound)
-        {
-            Debug.Assert(symbolReaderHandle != IntPtr.Zero);
-            ilNextOffset = 0;
-            noUserCodeFound = 0;
-
-            try
-            {
-                GCHandle gch = GCHandle.FromIntPtr(symbolReaderHandle);
-                MetadataReader reader = ((OpenedReader)gch.Target).Reader;
-
-                SequencePointCollection sequencePoints = GetSequencePointCollection(methodToken, reader);
-
-                foreach (SequencePoint point in sequencePoints)
-                {
-                    if (point.StartLine == 0 || point.StartLine == SequencePoint.HiddenLine)
-                        continue;
-
-                    if (point.Offset >= ilOffset)
-                    {
-                        ilNextOffset = (uint)point.Offset;
-                        return RetCode.OK;
-                    }
-                }
-
-                noUserCodeFound = 1;
-                return RetCode.Fail;
-            }
-            catch
-            {
-                return RetCode.Exception;
-            }
-        }
-
         [StructLayout(LayoutKind.Sequential)]
         internal struct method_data_t
         {
@@ -768,66 +725,67 @@ namespace NetCoreDbg
             return RetCode.OK;
         }
 
-        internal static RetCode GetStepRangesFromIP(IntPtr symbolReaderHandle, int ip, int methodToken, out uint ilStartOffset, out uint ilEndOffset)
+        [StructLayout(LayoutKind.Sequential)]
+        internal struct SequencePointOffset
+        {
+            public uint offset;
+            public int userCode; // 0 - hidden sequence point (no user code)
+        }
+
+        /// <summary>
+        /// Helper method to return IL offsets of all method's sequence points (ordered by IL offset), in order to build stepping table on native side.
+        /// </summary>
+        /// <param name="symbolReaderHandle">symbol reader handle returned by LoadSymbolsForModule</param>
+        /// <param name="methodToken">method token</param>
+        /// <param name="points">array of SequencePointOffset structures, must be freed by CoTaskMemFree()</param>
+        /// <param name="pointsCount">points count</param>
+        /// <returns>"Ok" if information is available</returns>
+        internal static RetCode GetSequencePointsOffsets(IntPtr symbolReaderHandle, int methodToken, out IntPtr points, out int pointsCount)
         {
             Debug.Assert(symbolReaderHandle != IntPtr.Zero);
-            ilStartOffset = 0;
-            ilEndOffset = 0;
+            points = IntPtr.Zero;
+            pointsCount = 0;
 
             try
             {
                 GCHandle gch = GCHandle.FromIntPtr(symbolReaderHandle);
                 MetadataReader reader = ((OpenedReader)gch.Target).Reader;
 
-                var list = new List<SequencePoint>();
+                var list = new List<SequencePointOffset>();
                 foreach (SequencePoint p in GetSequencePointCollection(methodToken, reader))
-                    list.Add(p);
-
-                var pointsArray = list.ToArray();
-
-                for (int i = 1; i < pointsArray.Length; i++)
                 {
-                    SequencePoint p = pointsArray[i];
-
-                    if (p.Offset > ip && p.StartLine != 0 && p.StartLine != SequencePoint.HiddenLine)
-                    {
-                        ilStartOffset = (uint)pointsArray[0].Offset;
-                        for (int j = i - 1; j > 0; j--)
-                        {
-                            if (pointsArray[j].Offset <= ip)
-                            {
-                                ilStartOffset = (uint)pointsArray[j].Offset;
-                                break;
-                            }
-                        }
-                        ilEndOffset = (uint)p.Offset;
-                        return RetCode.OK;
-                    }
+                    list.Add(new SequencePointOffset() {
+                        offset = (uint)p.Offset,
+                        userCode = (p.StartLine == 0 || p.StartLine == SequencePoint.HiddenLine) ? 0 : 1
+                    });
                 }
 
-                // let's handle correctly last step range from last sequence point till
-                // end of the method.
-                if (pointsArray.Length > 0)
-                {
-                    ilStartOffset = (uint)pointsArray[0].Offset;
-                    for (int j = pointsArray.Length - 1; j > 0; j--)
-                    {
-                        if (pointsArray[j].Offset <= ip)
-                        {
-                            ilStartOffset = (uint)pointsArray[j].Offset;
-                            break;
-                        }
-                    }
-                    ilEndOffset = ilStartOffset; // Should set this to IL code size in calling code
+                if (list.Count == 0)
                     return RetCode.OK;
+
+                int structSize = Marshal.SizeOf<SequencePointOffset>();
+                points = Marshal.AllocCoTaskMem(list.Count * structSize);
+                IntPtr currentPtr = points;
+
+                foreach (var p in list)
+                {
+                    Marshal.StructureToPtr(p, currentPtr, false);
+                    currentPtr = currentPtr + structSize;
                 }
+
+                pointsCount = list.Count;
             }
             catch
             {
+                if (points != IntPtr.Zero)
+                    Marshal.FreeCoTaskMem(points);
+
+                points = IntPtr.Zero;
+                pointsCount = 0;
                 return RetCode.Exception;
             }
 
-            return RetCode.Fail;
+            return RetCode.OK;
         }
 
         internal static RetCode GetLocalVariableNameAndScope(IntPtr symbolReaderHandle, int methodToken, int localIndex, out IntPtr localVarName, out int ilStartOffset, out int ilEndOffset)
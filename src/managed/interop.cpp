@@ -61,8 +61,7 @@ typedef  void (*DisposeDelegate)(PVOID);
 typedef  RetCode (*GetLocalVariableNameAndScope)(PVOID, int32_t, int32_t, BSTR*, uint32_t*, uint32_t*);
 typedef  RetCode (*GetHoistedLocalScopes)(PVOID, int32_t, PVOID*, int32_t*);
 typedef  RetCode (*GetSequencePointByILOffsetDelegate)(PVOID, mdMethodDef, uint32_t, PVOID);
-typedef  RetCode (*GetNextUserCodeILOffsetDelegate)(PVOID, mdMethodDef, uint32_t, uint32_t*, int32_t*);
-typedef  RetCode (*GetStepRangesFromIPDelegate)(PVOID, int32_t, mdMethodDef, uint32_t*, uint32_t*);
+typedef  RetCode (*GetSequencePointsOffsetsDelegate)(PVOID, mdMethodDef, PVOID*, int32_t*);
 typedef  RetCode (*GetModuleMethodsRangesDelegate)(PVOID, uint32_t, PVOID, uint32_t, PVOID, PVOID*);
 typedef  RetCode (*ResolveBreakPointsDelegate)(PVOID[], int32_t, PVOID, int32_t, int32_t, int32_t*, const WCHAR*, PVOID*);
 typedef  RetCode (*GetAsyncMethodSteppingInfoDelegate)(PVOID, mdMethodDef, PVOID*, int32_t*, uint32_t*);
@@ -83,8 +82,7 @@ DisposeDelegate disposeDelegate = nullptr;
 GetLocalVariableNameAndScope getLocalVariableNameAndScopeDelegate = nullptr;
 GetHoistedLocalScopes getHoistedLocalScopesDelegate = nullptr;
 GetSequencePointByILOffsetDelegate getSequencePointByILOffsetDelegate = nullptr;
-GetNextUserCodeILOffsetDelegate getNextUserCodeILOffsetDelegate = nullptr;
-GetStepRangesFromIPDelegate getStepRangesFromIPDelegate = nullptr;
+GetSequencePointsOffsetsDelegate getSequencePointsOffsetsDelegate = nullptr;
 GetModuleMethodsRangesDelegate getModuleMethodsRangesDelegate = nullptr;
 ResolveBreakPointsDelegate resolveBreakPointsDelegate = nullptr;
 GetAsyncMethodSteppingInfoDelegate getAsyncMethodSteppingInfoDelegate = nullptr;
@@ -227,8 +225,7 @@ void Init(const std::string &coreClrPath)
         SUCCEEDED(Status = createDelegate(hostHandle, domainId, ManagedPartDllName, SymbolReaderClassName, "GetLocalVariableNameAndScope", (void **)&getLocalVariableNameAndScopeDelegate)) &&
         SUCCEEDED(Status = createDelegate(hostHandle, domainId, ManagedPartDllName, SymbolReaderClassName, "GetHoistedLocalScopes", (void **)&getHoistedLocalScopesDelegate)) &&
         SUCCEEDED(Status = createDelegate(hostHandle, domainId, ManagedPartDllName, SymbolReaderClassName, "GetSequencePointByILOffset", (void **)&getSequencePointByILOffsetDelegate)) &&
-        SUCCEEDED(Status = createDelegate(hostHandle, domainId, ManagedPartDllName, SymbolReaderClassName, "GetNextUserCodeILOffset", (void **)&getNextUserCodeILOffsetDelegate)) &&
-        SUCCEEDED(Status = createDelegate(hostHandle, domainId, ManagedPartDllName, SymbolReaderClassName, "GetStepRangesFromIP", (void **)&getStepRangesFromIPDelegate)) &&
+        SUCCEEDED(Status = createDelegate(hostHandle, domainId, ManagedPartDllName, SymbolReaderClassName, "GetSequencePointsOffsets", (void **)&getSequencePointsOffsetsDelegate)) &&
         SUCCEEDED(Status = createDelegate(hostHandle, domainId, ManagedPartDllName, SymbolReaderClassName, "GetModuleMethodsRanges", (void **)&getModuleMethodsRangesDelegate)) &&
         SUCCEEDED(Status = createDelegate(hostHandle, domainId, ManagedPartDllName, SymbolReaderClassName, "ResolveBreakPoints", (void **)&resolveBreakPointsDelegate)) &&
         SUCCEEDED(Status = createDelegate(hostHandle, domainId, ManagedPartDllName, SymbolReaderClassName, "GetAsyncMethodSteppingInfo", (void **)&getAsyncMethodSteppingInfoDelegate)) &&
@@ -252,8 +249,7 @@ void Init(const std::string &coreClrPath)
                               getLocalVariableNameAndScopeDelegate &&
                               getHoistedLocalScopesDelegate &&
                               getSequencePointByILOffsetDelegate &&
-                              getNextUserCodeILOffsetDelegate &&
-                              getStepRangesFromIPDelegate &&
+                              getSequencePointsOffsetsDelegate &&
                               getModuleMethodsRangesDelegate &&
                               resolveBreakPointsDelegate &&
                               getAsyncMethodSteppingInfoDelegate &&
@@ -291,8 +287,7 @@ void Shutdown()
     getLocalVariableNameAndScopeDelegate = nullptr;
     getHoistedLocalScopesDelegate = nullptr;
     getSequencePointByILOffsetDelegate = nullptr;
-    getNextUserCodeILOffsetDelegate = nullptr;
-    getStepRangesFromIPDelegate = nullptr;
+    getSequencePointsOffsetsDelegate = nullptr;
     getModuleMethodsRangesDelegate = nullptr;
     resolveBreakPointsDelegate = nullptr;
     getAsyncMethodSteppingInfoDelegate = nullptr;
@@ -318,31 +313,32 @@ HRESULT GetSequencePointByILOffset(PVOID pSymbolReaderHandle, mdMethodDef method
     return retCode == RetCode::OK ? S_OK : E_FAIL;
 }
 
-HRESULT GetNextUserCodeILOffset(PVOID pSymbolReaderHandle, mdMethodDef methodToken, ULONG32 ilOffset, ULONG32 &ilNextOffset, bool *noUserCodeFound)
+HRESULT GetSequencePointsOffsets(PVOID pSymbolReaderHandle, mdMethodDef methodToken, std::vector<SequencePointOffset> &points)
 {
     std::unique_lock<Utility::RWLock::Reader> read_lock(CLRrwlock.reader);
-    if (!getNextUserCodeILOffsetDelegate || !pSymbolReaderHandle)
+    if (!getSequencePointsOffsetsDelegate || !pSymbolReaderHandle)
         return E_FAIL;
 
-    int32_t NoUserCodeFound = 0;
+    SequencePointOffset *allocatedPoints = nullptr;
+    int32_t pointsCount = 0;
 
-    // Sequence points with startLine equal to 0xFEEFEE marker are filtered out on the managed side.
-    RetCode retCode = getNextUserCodeILOffsetDelegate(pSymbolReaderHandle, methodToken, ilOffset, &ilNextOffset, &NoUserCodeFound);
+    RetCode retCode = getSequencePointsOffsetsDelegate(pSymbolReaderHandle, methodToken, (PVOID*)&allocatedPoints, &pointsCount);
+    read_lock.unlock();
 
-    if (noUserCodeFound)
-        *noUserCodeFound = NoUserCodeFound == 1;
+    if (retCode != RetCode::OK)
+        return E_FAIL;
 
-    return retCode == RetCode::OK ? S_OK : E_FAIL;
-}
+    if (pointsCount == 0)
+    {
+        assert(allocatedPoints == nullptr);
+        points.clear();
+        return S_OK;
+    }
 
-HRESULT GetStepRangesFromIP(PVOID pSymbolReaderHandle, ULONG32 ip, mdMethodDef MethodToken, ULONG32 *ilStartOffset, ULONG32 *ilEndOffset)
-{
-    std::unique_lock<Utility::RWLock::Reader> read_lock(CLRrwlock.reader);
-    if (!getStepRangesFromIPDelegate || !pSymbolReaderHandle || !ilStartOffset || !ilEndOffset)
-        return E_FAIL;
+    points.assign(allocatedPoints, allocatedPoints + pointsCount);
 
-    RetCode retCode = getStepRangesFromIPDelegate(pSymbolReaderHandle, ip, MethodToken, ilStartOffset, ilEndOffset);
-    return retCode == RetCode::OK ? S_OK : E_FAIL;
+    Interop::CoTaskMemFree(allocatedPoints);
+    return S_OK;
 }
 
 HRESULT GetNamedLocalVariableAndScope(PVOID pSymbolReaderHandle, mdMethodDef methodToken, ULONG localIndex,
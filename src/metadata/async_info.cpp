@@ -5,42 +5,80 @@
 #include "metadata/async_info.h"
 #include "metadata/modules.h"
 #include "managed/interop.h"
+#include <algorithm>
 
 
 namespace netcoredbg
 {
 
 // Caller must care about m_asyncMethodSteppingInfoMutex.
-HRESULT AsyncInfo::GetAsyncMethodSteppingInfo(CORDB_ADDRESS modAddress, mdMethodDef methodToken, ULONG32 methodVersion)
+HRESULT AsyncInfo::GetAsyncMethodSteppingInfo(CORDB_ADDRESS modAddress, mdMethodDef methodToken, ULONG32 methodVersion, AsyncMethodInfo **ppAsyncInfo)
 {
-    if (asyncMethodSteppingInfo.modAddress == modAddress &&
-        asyncMethodSteppingInfo.methodToken == methodToken &&
-        asyncMethodSteppingInfo.methodVersion == methodVersion)
-        return S_OK;
+    const method_key_t key(modAddress, methodToken, methodVersion);
+    auto find = m_asyncMethodsCacheIndex.find(key);
+    if (find != m_asyncMethodsCacheIndex.end())
+    {
+        // Move data to begin, so, last used will be on front.
+        if (find->second != m_asyncMethodsCache.begin())
+            m_asyncMethodsCache.splice(m_asyncMethodsCache.begin(), m_asyncMethodsCache, find->second);
+
+        *ppAsyncInfo = &m_asyncMethodsCache.front();
+        return m_asyncMethodsCache.front().status;
+    }
 
-    if (!asyncMethodSteppingInfo.awaits.empty())
-        asyncMethodSteppingInfo.awaits.clear();
+    AsyncMethodInfo asyncInfo;
+    asyncInfo.modAddress = modAddress;
+    asyncInfo.methodToken = methodToken;
+    asyncInfo.methodVersion = methodVersion;
 
-    return m_sharedModules->GetModuleInfo(modAddress, [&](Modules::ModuleInfo &mdInfo) -> HRESULT
+    // Note, don't cache result in case module was not found.
+    bool moduleFound = false;
+    asyncInfo.status = m_sharedModules->GetModuleInfo(modAddress, [&](Modules::ModuleInfo &mdInfo) -> HRESULT
     {
+        moduleFound = true;
+
         if (mdInfo.m_symbolReaderHandles.empty() || mdInfo.m_symbolReaderHandles.size() < methodVersion)
             return E_FAIL;
 
         HRESULT Status;
         std::vector<Interop::AsyncAwaitInfoBlock> AsyncAwaitInfo;
-        IfFailRet(Interop::GetAsyncMethodSteppingInfo(mdInfo.m_symbolReaderHandles[methodVersion - 1], methodToken, AsyncAwaitInfo, &asyncMethodSteppingInfo.lastIlOffset));
+        IfFailRet(Interop::GetAsyncMethodSteppingInfo(mdInfo.m_symbolReaderHandles[methodVersion - 1], methodToken, AsyncAwaitInfo, &asyncInfo.lastIlOffset));
 
+        asyncInfo.awaits.reserve(AsyncAwaitInfo.size());
         for (const auto &entry : AsyncAwaitInfo)
         {
-            asyncMethodSteppingInfo.awaits.emplace_back(entry.yield_offset, entry.resume_offset);
+            asyncInfo.awaits.emplace_back(entry.yield_offset, entry.resume_offset);
         }
 
-        asyncMethodSteppingInfo.modAddress = modAddress;
-        asyncMethodSteppingInfo.methodToken = methodToken;
-        asyncMethodSteppingInfo.methodVersion = methodVersion;
-
         return S_OK;
     });
+
+    if (!moduleFound)
+        return asyncInfo.status;
+
+    std::stable_sort(asyncInfo.awaits.begin(), asyncInfo.awaits.end(), [](const AwaitInfo &a, const AwaitInfo &b)
+    {
+        return a.yield_offset < b.yield_offset;
+    });
+    asyncInfo.maxResumeOffsets.reserve(asyncInfo.awaits.size());
+    for (const auto &await : asyncInfo.awaits)
+    {
+        asyncInfo.maxResumeOffsets.emplace_back(asyncInfo.maxResumeOffsets.empty() ? await.resume_offset
+                                                                                   : std::max(asyncInfo.maxResumeOffsets.back(), await.resume_offset));
+    }
+
+    if (m_asyncMethodsCache.size() >= m_asyncMethodsCacheCapacity)
+    {
+        const AsyncMethodInfo &last = m_asyncMethodsCache.back();
+        m_asyncMethodsCacheIndex.erase(method_key_t(last.modAddress, last.methodToken, last.methodVersion));
+        m_asyncMethodsCache.pop_back();
+    }
+
+    m_asyncMethodsCache.emplace_front(std::move(asyncInfo));
+    m_asyncMethodsCacheIndex.emplace(key, m_asyncMethodsCache.begin());
+
+    *ppAsyncInfo = &m_asyncMethodsCache.front();
+    return m_asyncMethodsCache.front().status;
 }
 
 // Check if method have await block. In this way we detect async method with awaits.
@@ -50,7 +88,8 @@ bool AsyncInfo::IsMethodHaveAwait(CORDB_ADDRESS modAddress, mdMethodDef methodTo
 {
     const std::lock_guard<std::mutex> lock(m_asyncMethodSteppingInfoMutex);
 
-    return SUCCEEDED(GetAsyncMethodSteppingInfo(modAddress, methodToken, methodVersion));
+    AsyncMethodInfo *asyncInfo = nullptr;
+    return SUCCEEDED(GetAsyncMethodSteppingInfo(modAddress, methodToken, methodVersion, &asyncInfo));
 }
 
 // Find await block after IL offset in particular async method and return await info, if present.
@@ -63,25 +102,26 @@ bool AsyncInfo::FindNextAwaitInfo(CORDB_ADDRESS modAddress, mdMethodDef methodTo
 {
     const std::lock_guard<std::mutex> lock(m_asyncMethodSteppingInfoMutex);
 
-    if (FAILED(GetAsyncMethodSteppingInfo(modAddress, methodToken, methodVersion)))
+    AsyncMethodInfo *asyncInfo = nullptr;
+    if (FAILED(GetAsyncMethodSteppingInfo(modAddress, methodToken, methodVersion, &asyncInfo)))
         return false;
 
-    for (auto &await : asyncMethodSteppingInfo.awaits)
+    // First await with yield offset not less than IP.
+    auto it = std::lower_bound(asyncInfo->awaits.begin(), asyncInfo->awaits.end(), ipOffset, [](const AwaitInfo &await, ULONG32 offset)
     {
-        if (ipOffset <= await.yield_offset)
-        {
-            if (awaitInfo)
-                *awaitInfo = &await;
-            return true;
-        }
-        // Stop search, if IP inside 'await' routine.
-        else if (ipOffset < await.resume_offset)
-        {
-            break;
-        }
-    }
+        return await.yield_offset < offset;
+    });
+    if (it == asyncInfo->awaits.end())
+        return false;
 
-    return false;
+    // Stop search, if IP inside 'await' routine.
+    size_t index = it - asyncInfo->awaits.begin();
+    if (index > 0 && ipOffset < asyncInfo->maxResumeOffsets[index - 1])
+        return false;
+
+    if (awaitInfo)
+        *awaitInfo = &(*it);
+    return true;
 }
 
 // Find last IL offset for user code in async method, if present.
@@ -94,11 +134,19 @@ bool AsyncInfo::FindLastIlOffsetAwaitInfo(CORDB_ADDRESS modAddress, mdMethodDef
 {
     const std::lock_guard<std::mutex> lock(m_asyncMethodSteppingInfoMutex);
 
-    if (FAILED(GetAsyncMethodSteppingInfo(modAddress, methodToken, methodVersion)))
+    AsyncMethodInfo *asyncInfo = nullptr;
+    if (FAILED(GetAsyncMethodSteppingInfo(modAddress, methodToken, methodVersion, &asyncInfo)))
         return false;
 
-    lastIlOffset = asyncMethodSteppingInfo.lastIlOffset;
+    lastIlOffset = asyncInfo->lastIlOffset;
     return true;
 }
 
+void AsyncInfo::Clear()
+{
+    const std::lock_guard<std::mutex> lock(m_asyncMethodSteppingInfoMutex);
+    m_asyncMethodsCacheIndex.clear();
+    m_asyncMethodsCache.clear();
+}
+
 } // namespace netcoredbg
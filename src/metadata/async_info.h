@@ -5,6 +5,10 @@
 #pragma once
 
 #include <memory>
+#include <mutex>
+#include <list>
+#include <map>
+#include <tuple>
 
 #include "metadata/modules.h"
 
@@ -37,6 +41,8 @@ public:
     bool IsMethodHaveAwait(CORDB_ADDRESS modAddress, mdMethodDef methodToken, ULONG32 methodVersion);
     bool FindNextAwaitInfo(CORDB_ADDRESS modAddress, mdMethodDef methodToken, ULONG32 methodVersion, ULONG32 ipOffset, AwaitInfo **awaitInfo);
     bool FindLastIlOffsetAwaitInfo(CORDB_ADDRESS modAddress, mdMethodDef methodToken, ULONG32 methodVersion, ULONG32 &lastIlOffset);
+    // Note, cache keyed by module address, that could be reused by other module after unload.
+    void Clear();
 
 private:
 
@@ -47,20 +53,31 @@ private:
         CORDB_ADDRESS modAddress;
         mdMethodDef methodToken;
         ULONG32 methodVersion;
+        // Cached result, in case method don't have async stepping info we don't ask symbol reader again.
+        HRESULT status;
 
+        // Sorted by yield offset.
         std::vector<AwaitInfo> awaits;
+        // Max resume offset for awaits [0, i], need for "IP inside 'await' routine" check during binary search.
+        std::vector<uint32_t> maxResumeOffsets;
         // Part of NotifyDebuggerOfWaitCompletion magic, see ManagedDebugger::SetupAsyncStep().
         ULONG32 lastIlOffset;
 
         AsyncMethodInfo() :
-            modAddress(0), methodToken(mdMethodDefNil), methodVersion(0), awaits(), lastIlOffset(0)
+            modAddress(0), methodToken(mdMethodDefNil), methodVersion(0), status(E_FAIL), awaits(), maxResumeOffsets(), lastIlOffset(0)
         {};
     };
 
-    AsyncMethodInfo asyncMethodSteppingInfo;
+    typedef std::tuple<CORDB_ADDRESS, mdMethodDef, ULONG32> method_key_t;
+
+    static const size_t m_asyncMethodsCacheCapacity = 64;
     std::mutex m_asyncMethodSteppingInfoMutex;
-    // Note, result stored into asyncMethodSteppingInfo.
-    HRESULT GetAsyncMethodSteppingInfo(CORDB_ADDRESS modAddress, mdMethodDef methodToken, ULONG32 methodVersion);
+    // Last used on front.
+    std::list<AsyncMethodInfo> m_asyncMethodsCache;
+    // Index for fast search in LRU list by module address, method token and method version.
+    std::map<method_key_t, std::list<AsyncMethodInfo>::iterator> m_asyncMethodsCacheIndex;
+    // Caller must care about m_asyncMethodSteppingInfoMutex.
+    HRESULT GetAsyncMethodSteppingInfo(CORDB_ADDRESS modAddress, mdMethodDef methodToken, ULONG32 methodVersion, AsyncMethodInfo **ppAsyncInfo);
 
 };
 
@@ -7,6 +7,7 @@
 #include <sstream>
 #include <vector>
 #include <iomanip>
+#include <algorithm>
 
 #include "managed/interop.h"
 #include "utils/platform.h"
@@ -181,6 +182,8 @@ void Modules::CleanupAllModules()
     std::lock_guard<std::mutex> lock(m_modulesInfoMutex);
     m_modulesInfo.clear();
     m_modulesAppUpdate.Clear();
+    InvalidateTypeLookupCache();
+    InvalidateFrameLocationCache();
 }
 
 std::string GetModuleFileName(ICorDebugModule *pModule)
@@ -352,6 +355,72 @@ HRESULT Modules::GetFrameILAndSequencePoint(
     });
 }
 
+HRESULT Modules::GetStepTable(ModuleInfo &mdInfo, mdMethodDef methodToken, ULONG32 methodVersion, const StepTable **ppStepTable)
+{
+    if (methodVersion == 0 || mdInfo.m_symbolReaderHandles.size() < methodVersion)
+        return E_FAIL;
+
+    uint64_t key = ((uint64_t)methodVersion << 32) | methodToken;
+    auto find = mdInfo.m_stepTables.find(key);
+    if (find != mdInfo.m_stepTables.end())
+    {
+        *ppStepTable = &find->second;
+        return S_OK;
+    }
+
+    HRESULT Status;
+    std::vector<Interop::SequencePointOffset> points;
+    IfFailRet(Interop::GetSequencePointsOffsets(mdInfo.m_symbolReaderHandles[methodVersion - 1], methodToken, points));
+
+    StepTable stepTable;
+    stepTable.offsets.reserve(points.size());
+    for (const auto &point : points)
+    {
+        stepTable.offsets.push_back(point.offset);
+    }
+    stepTable.nextUserCode.resize(points.size() + 1);
+    stepTable.nextUserCode[points.size()] = points.size();
+    for (size_t i = points.size(); i > 0; i--)
+    {
+        stepTable.nextUserCode[i - 1] = points[i - 1].userCode ? i - 1 : stepTable.nextUserCode[i];
+    }
+
+    *ppStepTable = &mdInfo.m_stepTables.emplace(key, std::move(stepTable)).first->second;
+    return S_OK;
+}
+
+// Step range starts at closest sequence point before IP and ends at
+// first user code sequence point after IP. In case no user code after IP, range end is equal to range start.
+static HRESULT GetStepRangeFromTable(const Modules::StepTable &stepTable, ULONG32 ip, ULONG32 &ilStartOffset, ULONG32 &ilEndOffset)
+{
+    if (stepTable.offsets.empty())
+        return E_FAIL;
+
+    size_t next = std::upper_bound(stepTable.offsets.begin(), stepTable.offsets.end(), ip) - stepTable.offsets.begin();
+    ilStartOffset = stepTable.offsets[next > 0 ? next - 1 : 0];
+
+    // Note, first sequence point can't be range end.
+    size_t end = stepTable.nextUserCode[std::max<size_t>(next, 1)];
+    ilEndOffset = end < stepTable.offsets.size() ? stepTable.offsets[end] : ilStartOffset;
+    return S_OK;
+}
+
+// Find IL offset of first user code sequence point at or after `ilOffset`.
+static HRESULT GetNextUserCodeILOffsetFromTable(const Modules::StepTable &stepTable, ULONG32 ilOffset, ULONG32 &ilNextOffset, bool *noUserCodeFound)
+{
+    size_t first = std::lower_bound(stepTable.offsets.begin(), stepTable.offsets.end(), ilOffset) - stepTable.offsets.begin();
+    size_t next = stepTable.nextUserCode[first];
+
+    if (noUserCodeFound)
+        *noUserCodeFound = next == stepTable.offsets.size();
+
+    if (next == stepTable.offsets.size())
+        return E_FAIL;
+
+    ilNextOffset = stepTable.offsets[next];
+    return S_OK;
+}
+
 HRESULT Modules::GetFrameILAndNextUserCodeILOffset(
     ICorDebugFrame *pFrame,
     ULONG32 &ilOffset,
@@ -420,10 +489,9 @@ HRESULT Modules::GetStepRangeFromCurrentIP(ICorDebugThread *pThread, COR_DEBUG_S
 
     IfFailRet(GetModuleInfo(modAddress, [&](ModuleInfo &mdInfo) -> HRESULT
     {
-        if (mdInfo.m_symbolReaderHandles.empty() || mdInfo.m_symbolReaderHandles.size() < methodVersion)
-            return E_FAIL;
-
-        return Interop::GetStepRangesFromIP(mdInfo.m_symbolReaderHandles[methodVersion - 1], nOffset, methodToken, &ilStartOffset, &ilEndOffset);
+        const StepTable *pStepTable = nullptr;
+        IfFailRet(GetStepTable(mdInfo, methodToken, methodVersion, &pStepTable));
+        return GetStepRangeFromTable(*pStepTable, nOffset, ilStartOffset, ilEndOffset);
     }));
 
     if (ilStartOffset == ilEndOffset)
@@ -564,6 +632,8 @@ HRESULT Modules::TryLoadModuleSymbols(ICorDebugModule *pModule, Module &module,
     ModuleInfo mdInfo { pSymbolReaderHandle, pModule };
     std::lock_guard<std::mutex> lock(m_modulesInfoMutex);
     m_modulesInfo.insert(std::make_pair(baseAddress, std::move(mdInfo)));
+    // New module could provide type, that was not found before, or type with same name.
+    InvalidateTypeLookupCache();
 
     if (needHotReload)
         IfFailRet(m_modulesAppUpdate.AddUpdateHandlerTypesForModule(pModule, pMDImport));
@@ -657,10 +727,9 @@ HRESULT Modules::GetNextUserCodeILOffsetInMethod(
 
     return GetModuleInfo(modAddress, [&](ModuleInfo &mdInfo) -> HRESULT
     {
-        if (mdInfo.m_symbolReaderHandles.empty() || mdInfo.m_symbolReaderHandles.size() < methodVersion)
-            return E_FAIL;
-
-        return Interop::GetNextUserCodeILOffset(mdInfo.m_symbolReaderHandles[methodVersion - 1], methodToken, ilOffset, ilNextOffset, noUserCodeFound);
+        const StepTable *pStepTable = nullptr;
+        IfFailRet(GetStepTable(mdInfo, methodToken, methodVersion, &pStepTable));
+        return GetNextUserCodeILOffsetFromTable(*pStepTable, ilOffset, ilNextOffset, noUserCodeFound);
     });
 }
 
@@ -715,6 +784,82 @@ HRESULT Modules::ForEachModule(std::function<HRESULT(ICorDebugModule *pModule)>
     return S_OK;
 }
 
+bool Modules::GetTypeLookupFromCache(const std::string &typeKey, TypeLookup &typeLookup, uint64_t &cacheGeneration)
+{
+    std::lock_guard<std::mutex> lock(m_typeLookupCacheMutex);
+    cacheGeneration = m_typeLookupCacheGeneration;
+    auto find = m_typeLookupCache.find(typeKey);
+    if (find != m_typeLookupCache.end())
+    {
+        typeLookup = find->second;
+        return true;
+    }
+
+    if (m_typeLookupNegativeCache.find(typeKey) == m_typeLookupNegativeCache.end())
+        return false;
+
+    typeLookup.modAddress = 0;
+    typeLookup.typeToken = mdTypeDefNil;
+    typeLookup.identifiersUsed = 0;
+    return true;
+}
+
+void Modules::AddTypeLookupToCache(const std::string &typeKey, const TypeLookup &typeLookup, uint64_t cacheGeneration)
+{
+    std::lock_guard<std::mutex> lock(m_typeLookupCacheMutex);
+    if (cacheGeneration != m_typeLookupCacheGeneration)
+        return;
+
+    if (typeLookup.typeToken != mdTypeDefNil)
+    {
+        m_typeLookupCache[typeKey] = typeLookup;
+        return;
+    }
+
+    // Note, key includes members part of expression (for example, `Instance.Value`), so, each failed evaluation
+    // could add new entry, drop all negative results in case limit reached.
+    if (m_typeLookupNegativeCache.size() >= m_typeLookupNegativeCacheCapacity)
+        m_typeLookupNegativeCache.clear();
+
+    m_typeLookupNegativeCache.insert(typeKey);
+}
+
+void Modules::InvalidateTypeLookupCache()
+{
+    std::lock_guard<std::mutex> lock(m_typeLookupCacheMutex);
+    m_typeLookupCache.clear();
+    m_typeLookupNegativeCache.clear();
+    m_typeLookupCacheGeneration++;
+}
+
+bool Modules::GetFrameLocationFromCache(const FrameLocationKey &key, FrameLocation &location, uint64_t &cacheGeneration)
+{
+    std::lock_guard<std::mutex> lock(m_frameLocationCacheMutex);
+    cacheGeneration = m_frameLocationCacheGeneration;
+    auto find = m_frameLocationCache.find(key);
+    if (find == m_frameLocationCache.end())
+        return false;
+
+    location = find->second;
+    return true;
+}
+
+void Modules::AddFrameLocationToCache(const FrameLocationKey &key, const FrameLocation &location, uint64_t cacheGeneration)
+{
+    std::lock_guard<std::mutex> lock(m_frameLocationCacheMutex);
+    if (cacheGeneration != m_frameLocationCacheGeneration)
+        return;
+
+    m_frameLocationCache[key] = location;
+}
+
+void Modules::InvalidateFrameLocationCache()
+{
+    std::lock_guard<std::mutex> lock(m_frameLocationCacheMutex);
+    m_frameLocationCache.clear();
+    m_frameLocationCacheGeneration++;
+}
+
 HRESULT Modules::ResolveBreakpoint(/*in*/ CORDB_ADDRESS modAddress, /*in*/ std::string filename, /*out*/ unsigned &fullname_index,
                                    /*in*/ int sourceLine, /*out*/ std::vector<ModulesSources::resolved_bp_t> &resolvedPoints)
 {
@@ -731,7 +876,12 @@ HRESULT Modules::ResolveBreakpoint(/*in*/ CORDB_ADDRESS modAddress, /*in*/ std::
 HRESULT Modules::ApplyPdbDeltaAndLineUpdates(ICorDebugModule *pModule, bool needJMC, const std::string &deltaPDB,
                                              const std::string &lineUpdates, std::unordered_set<mdMethodDef> &methodTokens)
 {
-    return m_modulesSources.ApplyPdbDeltaAndLineUpdates(this, pModule, needJMC, deltaPDB, lineUpdates, methodTokens);
+    // Metadata delta could add new types.
+    InvalidateTypeLookupCache();
+    HRESULT Status = m_modulesSources.ApplyPdbDeltaAndLineUpdates(this, pModule, needJMC, deltaPDB, lineUpdates, methodTokens);
+    // Line updates change sequence points of already executed methods versions.
+    InvalidateFrameLocationCache();
+    return Status;
 }
 
 HRESULT Modules::GetSourceFullPathByIndex(unsigned index, std::string &fullPath)
@@ -9,6 +9,7 @@
 
 #include <functional>
 #include <unordered_map>
+#include <unordered_set>
 #include <mutex>
 #include <memory>
 #include "interfaces/types.h"
@@ -29,12 +30,24 @@ class Modules
 {
 public:
 
+    // Stepping table for method version, IL offsets of all method's sequence points (ordered by IL offset) with
+    // precomputed position of next user code sequence point, so, steps don't call symbol reader again.
+    struct StepTable
+    {
+        std::vector<ULONG32> offsets;
+        // Index of first user code (not hidden) sequence point at same or bigger position, offsets.size() if none.
+        // Note, have offsets.size() + 1 elements, last is sentinel.
+        std::vector<size_t> nextUserCode;
+    };
+
     struct ModuleInfo
     {
         std::vector<PVOID> m_symbolReaderHandles;
         ToRelease<ICorDebugModule> m_iCorModule;
         // Cache for LineUpdates data for all methods in this module (Hot Reload related).
         method_block_updates_t m_methodBlockUpdates;
+        // Cache for stepping tables, key is method version (high 32 bits) and method token (low 32 bits).
+        std::unordered_map<uint64_t, StepTable> m_stepTables;
 
         ModuleInfo(PVOID Handle, ICorDebugModule *Module) :
             m_iCorModule(Module)
@@ -48,7 +61,8 @@ public:
 
         ModuleInfo(ModuleInfo&& other) noexcept :
             m_symbolReaderHandles(std::move(other.m_symbolReaderHandles)),
-            m_iCorModule(std::move(other.m_iCorModule))
+            m_iCorModule(std::move(other.m_iCorModule)),
+            m_stepTables(std::move(other.m_stepTables))
         {
         }
         ModuleInfo(const ModuleInfo&) = delete;
@@ -156,6 +170,45 @@ public:
 
     HRESULT ForEachModule(std::function<HRESULT(ICorDebugModule *pModule)> cb);
 
+    // Cache for type lookup across all modules (see EvalUtils::FindType()), key is type name without generic params.
+    // Note, negative lookup results are stored too (typeToken is mdTypeDefNil), in separate cache with limited size.
+    struct TypeLookup
+    {
+        CORDB_ADDRESS modAddress;
+        mdTypeDef typeToken;
+        int identifiersUsed;
+    };
+    bool GetTypeLookupFromCache(const std::string &typeKey, TypeLookup &typeLookup, uint64_t &cacheGeneration);
+    void AddTypeLookupToCache(const std::string &typeKey, const TypeLookup &typeLookup, uint64_t cacheGeneration);
+    void InvalidateTypeLookupCache();
+
+    // Cache for managed frame location (see InternalGetFrameLocation()), that is pure function of
+    // module, method token, method version and IL offset. Note, methodName is empty in case frame have
+    // generic arguments (name depends on instantiation and can't be cached this way).
+    struct FrameLocationKey
+    {
+        CORDB_ADDRESS modAddress;
+        mdMethodDef methodToken;
+        ULONG32 methodVersion;
+        ULONG32 ilOffset;
+
+        bool operator==(const FrameLocationKey &other) const
+        {
+            return modAddress == other.modAddress && methodToken == other.methodToken &&
+                   methodVersion == other.methodVersion && ilOffset == other.ilOffset;
+        }
+    };
+    struct FrameLocation
+    {
+        bool hasSequencePoint;
+        SequencePoint sequencePoint;
+        std::string moduleId;
+        std::string methodName;
+    };
+    bool GetFrameLocationFromCache(const FrameLocationKey &key, FrameLocation &location, uint64_t &cacheGeneration);
+    void AddFrameLocationToCache(const FrameLocationKey &key, const FrameLocation &location, uint64_t cacheGeneration);
+    void InvalidateFrameLocationCache();
+
     void FindFileNames(Utility::string_view pattern, unsigned limit, std::function<void(const char *)> cb);
     void FindFunctions(Utility::string_view pattern, unsigned limit, std::function<void(const char *)> cb);
     HRESULT GetSource(ICorDebugModule *pModule, const std::string &sourcePath, char** fileBuf, int* fileLen);
@@ -169,12 +222,39 @@ private:
     // Note, m_modulesSources have its own mutex for private data state sync.
     ModulesSources m_modulesSources;
 
+    std::mutex m_typeLookupCacheMutex;
+    std::unordered_map<std::string, TypeLookup> m_typeLookupCache;
+    static const size_t m_typeLookupNegativeCacheCapacity = 1024;
+    std::unordered_set<std::string> m_typeLookupNegativeCache;
+    // Changed on each cache invalidation, prevent store of lookup result that was started before module load/unload or Hot Reload.
+    uint64_t m_typeLookupCacheGeneration = 0;
+
+    struct frame_location_key_hash
+    {
+        size_t operator()(const FrameLocationKey &key) const
+        {
+            return std::hash<CORDB_ADDRESS>()(key.modAddress) ^ (std::hash<mdMethodDef>()(key.methodToken) << 1) ^
+                   (std::hash<ULONG32>()(key.methodVersion) << 2) ^ (std::hash<ULONG32>()(key.ilOffset) << 3);
+        }
+    };
+    std::mutex m_frameLocationCacheMutex;
+    std::unordered_map<FrameLocationKey, FrameLocation, frame_location_key_hash> m_frameLocationCache;
+    // Changed on each cache invalidation, prevent store of location that was calculated before module unload or Hot Reload.
+    uint64_t m_frameLocationCacheGeneration = 0;
+
     HRESULT GetSequencePointByILOffset(
         PVOID pSymbolReaderHandle,
         mdMethodDef methodToken,
         ULONG32 ilOffset,
         SequencePoint *sequencePoint);
 
+    // Must be called with m_modulesInfoMutex locked (from GetModuleInfo() callback).
+    HRESULT GetStepTable(
+        ModuleInfo &mdInfo,
+        mdMethodDef methodToken,
+        ULONG32 methodVersion,
+        const StepTable **ppStepTable);
+
 };
 
 } // namespace netcoredbg
@@ -6,7 +6,10 @@
 
 #include <sstream>
 #include <unordered_map>
+#include <unordered_set>
 #include <memory>
+#include <mutex>
+#include <tuple>
 
 #include "utils/torelease.h"
 #include "utils/utf.h"
@@ -18,6 +21,106 @@ namespace netcoredbg
 namespace TypePrinter
 {
 
+namespace
+{
+    // Note, type names are requested for every variable, stack frame and evaluation result, but set of
+    // loaded types is small and stable, so all resolved names are cached and interned (each unique name
+    // stored only once, caches hold pointers to interned strings).
+    // Definitions are keyed by (module, token), where module is identified by its metadata import interface.
+    // Constructed types (generic instantiations, arrays, pointers) are keyed by exact COR_TYPEID.
+    // Cache must be invalidated on module unload (metadata interface address could be reused) and Hot Reload.
+    struct TokenNameKey
+    {
+        IMetaDataImport *pImport;
+        mdToken token;
+        bool bClassName;
+
+        bool operator==(const TokenNameKey &other) const
+        {
+            return pImport == other.pImport && token == other.token && bClassName == other.bClassName;
+        }
+    };
+
+    struct token_name_key_hash
+    {
+        size_t operator()(const TokenNameKey &key) const
+        {
+            return std::hash<void*>()(key.pImport) ^ (std::hash<mdToken>()(key.token) << 1) ^ (key.bClassName ? 1 : 0);
+        }
+    };
+
+    struct type_id_hash
+    {
+        size_t operator()(const COR_TYPEID &typeID) const
+        {
+            return std::hash<UINT64>()(typeID.token1) ^ (std::hash<UINT64>()(typeID.token2) << 1);
+        }
+    };
+
+    struct type_id_equal
+    {
+        bool operator()(const COR_TYPEID &lhs, const COR_TYPEID &rhs) const
+        {
+            return lhs.token1 == rhs.token1 && lhs.token2 == rhs.token2;
+        }
+    };
+
+    struct TypeOfValueNames
+    {
+        const std::string *elementType;
+        const std::string *arrayType;
+    };
+
+    std::mutex g_namesCacheMutex;
+    std::unordered_set<std::string> g_internedNames;
+    std::unordered_map<TokenNameKey, const std::string*, token_name_key_hash> g_tokenNamesCache;
+    std::unordered_map<COR_TYPEID, TypeOfValueNames, type_id_hash, type_id_equal> g_typeNamesCache;
+
+    // Caller must hold g_namesCacheMutex. Note, pointers to unordered_set elements stay valid on rehash.
+    const std::string *InternName(const std::string &name)
+    {
+        return &(*g_internedNames.insert(name).first);
+    }
+
+    // Names that depend on provided generic args can't be cached by token (args are consumed during name resolve).
+    bool IsTokenNameCacheable(std::list<std::string> *args)
+    {
+        return args == nullptr || args->empty();
+    }
+
+    bool GetTokenNameFromCache(const TokenNameKey &key, std::string &mdName)
+    {
+        std::lock_guard<std::mutex> lock(g_namesCacheMutex);
+        auto find = g_tokenNamesCache.find(key);
+        if (find == g_tokenNamesCache.end())
+            return false;
+
+        mdName = *find->second;
+        return true;
+    }
+
+    void AddTokenNameToCache(const TokenNameKey &key, const std::string &mdName)
+    {
+        std::lock_guard<std::mutex> lock(g_namesCacheMutex);
+        g_tokenNamesCache[key] = InternName(mdName);
+    }
+
+    bool GetTypeID(ICorDebugType *pType, COR_TYPEID &typeID)
+    {
+        ToRelease<ICorDebugType2> iCorType2;
+        return SUCCEEDED(pType->QueryInterface(IID_ICorDebugType2, (LPVOID*) &iCorType2)) &&
+               SUCCEEDED(iCorType2->GetTypeID(&typeID));
+    }
+}
+
+void InvalidateCache()
+{
+    std::lock_guard<std::mutex> lock(g_namesCacheMutex);
+    g_tokenNamesCache.clear();
+    g_typeNamesCache.clear();
+    g_internedNames.clear();
+}
+
 static std::string ConsumeGenericArgs(const std::string &name, std::list<std::string> &args)
 {
     if (args.empty())
@@ -276,11 +379,11 @@ HRESULT NameForTypeByValue(ICorDebugValue *pValue, std::string &mdName)
     return NameForTypeByType(iCorType, mdName);
 }
 
-HRESULT NameForToken(mdToken mb,
-                                  IMetaDataImport *pImport,
-                                  std::string &mdName,
-                                  bool bClassName,
-                                  std::list<std::string> *args)
+static HRESULT NameForTokenUncached(mdToken mb,
+                                    IMetaDataImport *pImport,
+                                    std::string &mdName,
+                                    bool bClassName,
+                                    std::list<std::string> *args)
 {
     mdName[0] = L'\0';
     if (TypeFromToken(mb) != mdtTypeDef
@@ -375,6 +478,25 @@ HRESULT NameForToken(mdToken mb,
     return hr;
 }
 
+HRESULT NameForToken(mdToken mb,
+                     IMetaDataImport *pImport,
+                     std::string &mdName,
+                     bool bClassName,
+                     std::list<std::string> *args)
+{
+    if (!IsTokenNameCacheable(args))
+        return NameForTokenUncached(mb, pImport, mdName, bClassName, args);
+
+    TokenNameKey key{pImport, mb, bClassName};
+    if (GetTokenNameFromCache(key, mdName))
+        return S_OK;
+
+    HRESULT Status;
+    IfFailRet(NameForTokenUncached(mb, pImport, mdName, bClassName, args));
+    AddTokenNameToCache(key, mdName);
+    return S_OK;
+}
+
 HRESULT GetTypeOfValue(ICorDebugValue *pValue, std::string &output)
 {
     ToRelease<ICorDebugType> pType;
@@ -389,7 +511,7 @@ HRESULT GetTypeOfValue(ICorDebugValue *pValue, std::string &output)
 
 // From strike.cpp
 
-HRESULT GetTypeOfValue(ICorDebugType *pType, std::string &elementType, std::string &arrayType)
+static HRESULT GetTypeOfValueUncached(ICorDebugType *pType, std::string &elementType, std::string &arrayType)
 {
     if (pType == nullptr)
         return E_INVALIDARG;
@@ -777,6 +899,35 @@ void NameForTypeSig(
     typeName = out + appendix;
 }
 
+HRESULT GetTypeOfValue(ICorDebugType *pType, std::string &elementType, std::string &arrayType)
+{
+    if (pType == nullptr)
+        return E_INVALIDARG;
+
+    COR_TYPEID typeID;
+    if (!GetTypeID(pType, typeID))
+        return GetTypeOfValueUncached(pType, elementType, arrayType);
+
+    {
+        std::lock_guard<std::mutex> lock(g_namesCacheMutex);
+        auto find = g_typeNamesCache.find(typeID);
+        if (find != g_typeNamesCache.end())
+        {
+            elementType = *find->second.elementType;
+            arrayType = *find->second.arrayType;
+            return S_OK;
+        }
+    }
+
+    // Note, mutex can't be held here, since name resolve recursively request names for element type and generic args.
+    HRESULT Status;
+    IfFailRet(GetTypeOfValueUncached(pType, elementType, arrayType));
+
+    std::lock_guard<std::mutex> lock(g_namesCacheMutex);
+    g_typeNamesCache[typeID] = TypeOfValueNames{InternName(elementType), InternName(arrayType)};
+    return S_OK;
+}
+
 HRESULT GetTypeOfValue(ICorDebugType *pType, std::string &output)
 {
     HRESULT Status;
@@ -32,6 +32,8 @@ namespace TypePrinter
     HRESULT GetTypeAndMethod(ICorDebugFrame *pFrame, std::string &typeName, std::string &methodName);
     std::string RenameToSystem(const std::string &typeName);
     std::string RenameToCSharp(const std::string &typeName);
+    // Drop cached type names, must be called on module unload and Hot Reload.
+    void InvalidateCache();
 
 } // namespace TypePrinter
 
@@ -218,7 +218,7 @@ constexpr static const CLIParams::CommandInfo help_commands[] =
 constexpr static const CLIParams::CommandInfo commands_list[] =
 {
     {CommandTag::Backtrace, {}, {}, {{"backtrace", "bt"}},
-        {{}, "Print backtrace info."}},
+        {{}, "Print backtrace info, --all for all threads."}},
 
     {CommandTag::Break, {}, {{{1, CompletionTag::Break}}}, {{"break", "b"}},
         {"<loc>", "Set breakpoint at specified location, where the\n"
@@ -757,6 +757,43 @@ HRESULT CLIProtocol::PrintFrames(ThreadId threadId, std::string &output, FrameLe
     return S_OK;
 }
 
+HRESULT CLIProtocol::PrintThreadsFrames(std::string &output)
+{
+    HRESULT Status;
+    std::ostringstream ss;
+
+    // Threads with identical stacks are printed as one group.
+    IfFailRet(m_sharedDebugger->GetThreadsStackTraces(0, [&](const std::vector<ThreadId> &threads, const std::vector<StackFrame> &stackFrames)
+    {
+        ss << (threads.size() > 1 ? "Threads " : "Thread ");
+        const char *sep = "";
+        for (const ThreadId &threadId : threads)
+        {
+            ss << sep << int(threadId);
+            sep = ", ";
+        }
+        ss << ":\n";
+
+        int currentFrame = 0;
+        for (const StackFrame &stackFrame : stackFrames)
+        {
+            ss << "#" << currentFrame;
+
+            std::string frameLocation;
+            PrintFrameLocation(stackFrame, frameLocation);
+            if (!frameLocation.empty())
+                ss << " " << frameLocation;
+            ss << "\n";
+            currentFrame++;
+        }
+        ss << "\n";
+    }));
+
+    output = ss.str();
+
+    return S_OK;
+}
+
 void CLIProtocol::Cleanup()
 {
     m_breakpointsHandle.Cleanup();
@@ -942,6 +979,10 @@ HRESULT CLIProtocol::doCommand<CommandTag::Backtrace>(const std::vector<std::str
         return E_FAIL;
     }
 
+    std::vector<std::string> args = args_orig;
+    if (ProtocolUtils::FindAndEraseArg(args, "--all"))
+        return PrintThreadsFrames(output);
+
     // assuming call of m_sharedDebugger->GetAnything() with locked mutex not lead to deadlock
     ThreadId tid = m_sharedDebugger->GetLastStoppedThreadId();
     if (tid == ThreadId::AllThreads)
@@ -950,7 +991,6 @@ HRESULT CLIProtocol::doCommand<CommandTag::Backtrace>(const std::vector<std::str
         return E_FAIL;
     }
 
-    std::vector<std::string> args = args_orig;
     ThreadId threadId{ ProtocolUtils::GetIntArg(args, "--thread", int(tid)) };
     int lowFrame = 0;
     int highFrame = FrameLevel::MaxFrameLevel;
@@ -1553,7 +1593,7 @@ HRESULT CLIProtocol::doCommand<CommandTag::Print>(const std::vector<std::string>
     }
 
     HRESULT Status;
-    IfFailRet(m_sharedDebugger->Evaluate(frameId, m_lastPrintArg, v, output));
+    IfFailRet(m_sharedDebugger->Evaluate(frameId, m_lastPrintArg, v, output, false));
     v.name = m_lastPrintArg;
     PrintVariable (v, ss, true, false);
     output = ss.str();
@@ -94,6 +94,7 @@ public:
     void EmitModuleEvent(const ModuleEvent &event) override;
     void EmitOutputEvent(OutputCategory category, string_view output, string_view source = "") override;
     void EmitBreakpointEvent(const BreakpointEvent &event) override;
+    void EmitSnapshotEvent(const SnapshotEvent &event) override {} // snapshot breakpoints are not supported by CLI
     void Cleanup() override;
     void CommandLoop() override;
 
@@ -177,6 +178,7 @@ private:
                         std::string &output,
                         IDebugger::StepType stepType);
     HRESULT PrintFrames(ThreadId threadId, std::string &output, FrameLevel lowFrame, FrameLevel highFrame);
+    HRESULT PrintThreadsFrames(std::string &output);
     HRESULT PrintVariable(const Variable &v, std::ostringstream &output, bool expand, bool is_static);
     static HRESULT PrintFrameLocation(const StackFrame &stackFrame, std::string &output);
     bool ParseLine(const std::string &str, std::string &token, std::string &cmd, std::vector<std::string> &args);
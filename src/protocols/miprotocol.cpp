@@ -170,15 +170,8 @@ static HRESULT PrintFrameLocation(const StackFrame &stackFrame, std::string &out
     return stackFrame.source.IsNull() ? S_FALSE : S_OK;
 }
 
-static HRESULT PrintFrames(std::shared_ptr<IDebugger> &sharedDebugger, ThreadId threadId, std::string &output, FrameLevel lowFrame, FrameLevel highFrame, bool hotReloadAwareCaller)
+static void PrintFramesList(const std::vector<StackFrame> &stackFrames, FrameLevel lowFrame, std::ostringstream &ss)
 {
-    HRESULT Status;
-    std::ostringstream ss;
-
-    int totalFrames = 0;
-    std::vector<StackFrame> stackFrames;
-    IfFailRet(sharedDebugger->GetStackTrace(threadId, lowFrame, int(highFrame) - int(lowFrame), stackFrames, totalFrames, hotReloadAwareCaller));
-
     int currentFrame = int(lowFrame);
 
     ss << "stack=[";
@@ -200,6 +193,51 @@ static HRESULT PrintFrames(std::shared_ptr<IDebugger> &sharedDebugger, ThreadId
     }
 
     ss << "]";
+}
+
+static HRESULT PrintFrames(std::shared_ptr<IDebugger> &sharedDebugger, ThreadId threadId, std::string &output, FrameLevel lowFrame, FrameLevel highFrame, bool hotReloadAwareCaller)
+{
+    HRESULT Status;
+    std::ostringstream ss;
+
+    int totalFrames = 0;
+    std::vector<StackFrame> stackFrames;
+    IfFailRet(sharedDebugger->GetStackTrace(threadId, lowFrame, int(highFrame) - int(lowFrame), stackFrames, totalFrames, hotReloadAwareCaller));
+
+    PrintFramesList(stackFrames, lowFrame, ss);
+
+    output = ss.str();
+
+    return S_OK;
+}
+
+static HRESULT PrintThreadsFrames(std::shared_ptr<IDebugger> &sharedDebugger, std::string &output, unsigned maxFrames)
+{
+    HRESULT Status;
+    std::ostringstream ss;
+
+    ss << "groups=[";
+    const char *sep = "";
+
+    IfFailRet(sharedDebugger->GetThreadsStackTraces(maxFrames,
+        [&](const std::vector<ThreadId> &threads, const std::vector<StackFrame> &stackFrames)
+    {
+        ss << sep << "group={threads=[";
+        sep = ",";
+
+        const char *threadSep = "";
+        for (const ThreadId &threadId : threads)
+        {
+            ss << threadSep << "\"" << int(threadId) << "\"";
+            threadSep = ",";
+        }
+        ss << "],";
+
+        PrintFramesList(stackFrames, FrameLevel{0}, ss);
+        ss << "}";
+    }));
+
+    ss << "]";
 
     output = ss.str();
 
@@ -227,6 +265,28 @@ static HRESULT PrintVariables(const std::vector<Variable> &variables, std::strin
     return S_OK;
 }
 
+void MIProtocol::EmitSnapshotEvent(const SnapshotEvent &event)
+{
+    LogFuncEntry();
+
+    std::ostringstream ss;
+    ss << "bkptno=\"" << event.breakpointId << "\",thread-id=\"" << int(event.threadId) << "\","
+       << "truncated=\"" << (event.truncated ? 1 : 0) << "\",capture-us=\"" << event.captureUs << "\",frames=[";
+    const char *sep = "";
+    for (const SnapshotFrame &snapshotFrame : event.frames)
+    {
+        std::string frameLocation;
+        std::string variables;
+        PrintFrameLocation(snapshotFrame.frame, frameLocation);
+        PrintVariables(snapshotFrame.variables, variables);
+        ss << sep << "frame={level=\"" << int(snapshotFrame.frame.GetLevel()) << "\"," << frameLocation << "," << variables << "}";
+        sep = ",";
+    }
+    ss << "]";
+
+    MIProtocol::Printf("=breakpoint-snapshot,%s\n", ss.str().c_str());
+}
+
 static void PrintVar(const std::string &varobjName, Variable &v, ThreadId threadId, int print_values, std::string &output)
 {
     std::ostringstream ss;
@@ -281,7 +341,7 @@ HRESULT MIProtocol::VariablesHandle::CreateVar(std::shared_ptr<IDebugger> &share
 
     FrameId frameId(threadId, level);
     Variable variable(evalFlags);
-    IfFailRet(sharedDebugger->Evaluate(frameId, expression, variable, output));
+    IfFailRet(sharedDebugger->Evaluate(frameId, expression, variable, output, false));
 
     int print_values = 1;
     return PrintNewVar(varobjName, variable, threadId, level, print_values, output);
@@ -567,6 +627,11 @@ static HRESULT HandleCommand(std::shared_ptr<IDebugger> &sharedDebugger, Breakpo
         Breakpoint breakpoint;
         std::vector<std::string> args = unmutable_args;
 
+        // Non-stopping snapshot breakpoint, captures variables of top frames, see "=breakpoint-snapshot" async record.
+        SnapshotOptions snapshot;
+        snapshot.frames = unsigned(ProtocolUtils::GetIntArg(args, "--snapshot-frames", 0));
+        snapshot.depth = unsigned(ProtocolUtils::GetIntArg(args, "--snapshot-depth", int(snapshot.depth)));
+
         ProtocolUtils::StripArgs(args);
 
         BreakType bt = ProtocolUtils::GetBreakpointType(args);
@@ -582,7 +647,7 @@ static HRESULT HandleCommand(std::shared_ptr<IDebugger> &sharedDebugger, Breakpo
             struct LineBreak lb;
 
             if (ProtocolUtils::ParseBreakpoint(args, lb)
-                && SUCCEEDED(breakpointsHandle.SetLineBreakpoint(sharedDebugger, lb.module, lb.filename, lb.linenum, lb.condition, breakpoint)))
+                && SUCCEEDED(breakpointsHandle.SetLineBreakpoint(sharedDebugger, lb.module, lb.filename, lb.linenum, lb.condition, breakpoint, snapshot)))
                 Status = S_OK;
         }
         else if (bt == BreakType::FuncBreak)
@@ -737,6 +802,30 @@ static HRESULT HandleCommand(std::shared_ptr<IDebugger> &sharedDebugger, Breakpo
         ProtocolUtils::GetIndices(args, lowFrame, highFrame);
         return PrintFrames(sharedDebugger, threadId, output, FrameLevel{lowFrame}, FrameLevel{highFrame}, hotReloadAwareCaller);
     }},
+    { "stack-list-threads-frames", [&](const std::vector<std::string> &args, std::string &output) -> HRESULT {
+        // Stacks of all threads, threads with identical stacks are grouped. Note, 0 means all frames.
+        unsigned maxFrames = unsigned(ProtocolUtils::GetIntArg(args, "--max-frames", 0));
+        return PrintThreadsFrames(sharedDebugger, output, maxFrames);
+    }},
+    { "sampling-start", [&](const std::vector<std::string> &args, std::string &output) -> HRESULT {
+        return sharedDebugger->StartSampling(unsigned(ProtocolUtils::GetIntArg(args, "--interval", 10)));
+    }},
+    { "sampling-stop", [&](const std::vector<std::string> &args_orig, std::string &output) -> HRESULT {
+        HRESULT Status;
+        std::vector<std::string> args = args_orig;
+        SamplingFormat format = ProtocolUtils::FindAndEraseArg(args, "--speedscope") ? SamplingFormat::Speedscope : SamplingFormat::Collapsed;
+        std::string profile;
+        SamplingStats stats;
+        IfFailRet(sharedDebugger->StopSampling(format, profile, stats));
+
+        std::ostringstream ss;
+        ss << "samples=\"" << stats.samples << "\","
+           << "pause-total-us=\"" << stats.pauseTotalUs << "\","
+           << "pause-max-us=\"" << stats.pauseMaxUs << "\","
+           << "profile=\"" << MIProtocol::EscapeMIValue(profile) << "\"";
+        output = ss.str();
+        return S_OK;
+    }},
     { "stack-list-variables", [&](const std::vector<std::string> &args, std::string &output) -> HRESULT {
         HRESULT Status;
 
@@ -941,7 +1030,7 @@ static HRESULT HandleCommand(std::shared_ptr<IDebugger> &sharedDebugger, Breakpo
         IfFailRet(variablesHandle.FindVar(varName, miVariable));
         FrameId frameId(miVariable.threadId, miVariable.level);
         Variable variable(miVariable.variable.evalFlags);
-        IfFailRet(sharedDebugger->Evaluate(frameId, miVariable.variable.evaluateName, variable, output));
+        IfFailRet(sharedDebugger->Evaluate(frameId, miVariable.variable.evaluateName, variable, output, false));
 
         output = "value=\"" + MIProtocol::EscapeMIValue(variable.value) + "\"";
         return S_OK;
@@ -40,6 +40,7 @@ public:
     void EmitModuleEvent(const ModuleEvent &event) override;
     void EmitOutputEvent(OutputCategory category, string_view output, string_view source = "") override;
     void EmitBreakpointEvent(const BreakpointEvent &event) override;
+    void EmitSnapshotEvent(const SnapshotEvent &event) override;
     void Cleanup() override;
     void CommandLoop() override;
 
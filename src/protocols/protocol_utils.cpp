@@ -25,7 +25,7 @@ void BreakpointsHandle::Cleanup()
 
 HRESULT BreakpointsHandle::SetLineBreakpoint(std::shared_ptr<IDebugger> &sharedDebugger,
                                              const std::string &module, const std::string &filename, int linenum,
-                                             const std::string &condition, Breakpoint &breakpoint)
+                                             const std::string &condition, Breakpoint &breakpoint, const SnapshotOptions &snapshot)
 {
     HRESULT Status;
 
@@ -35,6 +35,7 @@ HRESULT BreakpointsHandle::SetLineBreakpoint(std::shared_ptr<IDebugger> &sharedD
         lineBreakpoints.push_back(it.second);
 
     lineBreakpoints.emplace_back(module, linenum, condition);
+    lineBreakpoints.back().snapshot = snapshot;
 
     std::vector<Breakpoint> breakpoints;
     IfFailRet(sharedDebugger->SetLineBreakpoints(filename, lineBreakpoints, breakpoints));
@@ -426,6 +427,37 @@ std::string AddrToString(uint64_t addr)
     return ss.str();
 }
 
+std::string Base64Encode(const uint8_t *data, size_t size)
+{
+    static const char table[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+    std::string result;
+    result.reserve((size + 2) / 3 * 4);
+    size_t i = 0;
+    for (; i + 2 < size; i += 3)
+    {
+        uint32_t triple = (uint32_t(data[i]) << 16) | (uint32_t(data[i + 1]) << 8) | uint32_t(data[i + 2]);
+        result += table[(triple >> 18) & 0x3F];
+        result += table[(triple >> 12) & 0x3F];
+        result += table[(triple >> 6) & 0x3F];
+        result += table[triple & 0x3F];
+    }
+
+    if (i < size)
+    {
+        uint32_t triple = uint32_t(data[i]) << 16;
+        if (i + 1 < size)
+            triple |= uint32_t(data[i + 1]) << 8;
+
+        result += table[(triple >> 18) & 0x3F];
+        result += table[(triple >> 12) & 0x3F];
+        result += (i + 1 < size) ? table[(triple >> 6) & 0x3F] : '=';
+        result += '=';
+    }
+
+    return result;
+}
+
 } // namespace ProtocolUtils
 
 } // namespace netcoredbg
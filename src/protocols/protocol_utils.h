@@ -43,7 +43,8 @@ private:
 
 public:
     HRESULT SetLineBreakpoint(std::shared_ptr<IDebugger> &sharedDebugger, const std::string &module, const std::string &filename,
-                              int linenum, const std::string &condition, Breakpoint &breakpoints);
+                              int linenum, const std::string &condition, Breakpoint &breakpoints,
+                              const SnapshotOptions &snapshot = SnapshotOptions());
     HRESULT SetFuncBreakpoint(std::shared_ptr<IDebugger> &sharedDebugger, const std::string &module, const std::string &funcname,
                               const std::string &params, const std::string &condition, Breakpoint &breakpoint);
     HRESULT SetExceptionBreakpoints(std::shared_ptr<IDebugger> &sharedDebugger, std::vector<ExceptionBreakpoint> &excBreakpoints,
@@ -68,6 +69,7 @@ namespace ProtocolUtils
     bool ParseBreakpoint(std::vector<std::string> &args, struct LineBreak &lb);
     bool ParseBreakpoint(std::vector<std::string> &args, struct FuncBreak &fb);
     std::string AddrToString(uint64_t addr);
+    std::string Base64Encode(const uint8_t *data, size_t size);
 
 } // namespace ProtocolUtils
 
@@ -24,6 +24,7 @@
 #include "utils/utf.h"
 #include "utils/logger.h"
 #include "protocols/escaped_string.h"
+#include "protocols/protocol_utils.h"
 
 // for convenience
 using json = nlohmann::json;
@@ -44,6 +45,9 @@ namespace
     const std::string LOG_RESPONSE("<- (R) ");
     const std::string LOG_EVENT("<- (E) ");
 
+    // Time window for module and breakpoint events coalescing.
+    const std::chrono::milliseconds EVENTS_BATCH_WINDOW(20);
+
     // Make sure we continue add new commands into queue only after current command execution is finished.
     // Note, configurationDone: prevent deadlock in _dup() call during std::getline() from stdin in main thread.
     const std::unordered_set<std::string> g_syncCommandExecutionSet{
@@ -114,11 +118,71 @@ void to_json(json &j, const Variable &v) {
         {"evaluateName",       v.evaluateName},
         {"variablesReference", v.variablesReference}};
 
+    if (v.presentationHint.lazy)
+        j["presentationHint"] = json{{"kind", "property"}, {"lazy", true}};
+    else if (v.changed)
+        j["presentationHint"] = json{{"attributes", json::array({"changed"})}};
+
     if (v.variablesReference > 0)
     {
         j["namedVariables"] = v.namedVariables;
         // j["indexedVariables"] = v.indexedVariables;
     }
+
+    if (v.memoryReference != 0)
+        j["memoryReference"] = ProtocolUtils::AddrToString(v.memoryReference);
+}
+
+void to_json(json &j, const LatencyPercentiles &p) {
+    j = json{
+        {"p50", p.p50},
+        {"p90", p.p90},
+        {"p99", p.p99},
+        {"max", p.max}};
+}
+
+void to_json(json &j, const StopLatencyStats &s) {
+    j = json{
+        {"operation", s.operation},
+        {"count",     s.count},
+        {"request",   s.request},
+        {"queue",     s.queue},
+        {"callback",  s.callback},
+        {"symbols",   s.symbols},
+        {"emit",      s.emit},
+        {"total",     s.total}};
+}
+
+void to_json(json &j, const TypeObjectCacheStats &s) {
+    j = json{
+        {"hits",      s.hits},
+        {"misses",    s.misses},
+        {"evictions", s.evictions},
+        {"size",      s.size},
+        {"capacity",  s.capacity}};
+}
+
+void to_json(json &j, const CallbacksQueueStats &s) {
+    j = json{
+        {"count",    s.count},
+        {"maxDepth", s.maxDepth},
+        {"delay",    s.delay}};
+}
+
+// Optional launch and attach argument, reject out of range value, instead of silent debugger start with other capacity.
+static HRESULT SetTypeObjectCacheSize(std::shared_ptr<IDebugger> &sharedDebugger, const json &arguments, json &body)
+{
+    auto typeObjectCacheSize = arguments.find("typeObjectCacheSize");
+    if (typeObjectCacheSize == arguments.end())
+        return S_OK;
+
+    if (!typeObjectCacheSize->is_number_unsigned() || typeObjectCacheSize->get<uint64_t>() > TypeObjectCacheStats::MaxCapacity ||
+        FAILED(sharedDebugger->SetTypeObjectCacheCapacity(typeObjectCacheSize->get<unsigned>())))
+    {
+        body["message"] = "typeObjectCacheSize must be in range [0, " + std::to_string(TypeObjectCacheStats::MaxCapacity) + "]";
+        return E_INVALIDARG;
+    }
+    return S_OK;
 }
 
 static json FormJsonForExceptionDetails(const ExceptionDetails &details)
@@ -270,7 +334,7 @@ void VSCodeProtocol::EmitModuleEvent(const ModuleEvent &event)
             break;
     }
 
-    EmitEvent("module", body);
+    EmitBatchedEvent("module", body);
 }
 
 
@@ -330,6 +394,7 @@ void VSCodeProtocol::EmitOutputEvent(OutputCategory category, string_view output
     EscapedString<JSON_escape_rules> escaped_source(source);
 
     std::lock_guard<std::mutex> lock(m_outMutex);
+    FlushPendingEvents();
 
     // compute size of headers without text (text could be huge, no reason parse it for size, that we already know)
     CountingStream count;
@@ -365,7 +430,35 @@ void VSCodeProtocol::EmitBreakpointEvent(const BreakpointEvent &event)
 
     body["breakpoint"] = event.breakpoint;
 
-    EmitEvent("breakpoint", body);
+    EmitBatchedEvent("breakpoint", body);
+}
+
+// Custom event, snapshot breakpoint hit (process was not stopped).
+void VSCodeProtocol::EmitSnapshotEvent(const SnapshotEvent &event)
+{
+    LogFuncEntry();
+    json body;
+
+    json frames = json::array();
+    for (const SnapshotFrame &snapshotFrame : event.frames)
+    {
+        json variables = json::array();
+        for (const Variable &var : snapshotFrame.variables)
+            variables.push_back(json{{"name", var.name}, {"value", var.value}, {"type", var.type}});
+
+        // Note, process was not stopped, so, frame id can't be used in requests.
+        json frame = snapshotFrame.frame;
+        frame.erase("id");
+        frames.push_back(json{{"frame", frame}, {"variables", variables}});
+    }
+
+    body["breakpointId"] = event.breakpointId;
+    body["threadId"] = int(event.threadId);
+    body["frames"] = frames;
+    body["truncated"] = event.truncated;
+    body["captureTimeMs"] = double(event.captureUs) / 1000;
+
+    EmitEvent("snapshot", body);
 }
 
 void VSCodeProtocol::EmitInitializedEvent()
@@ -396,6 +489,7 @@ static void AddCapabilitiesTo(json &capabilities)
     capabilities["supportsSetExpression"] = true;
     capabilities["supportsTerminateRequest"] = true;
     capabilities["supportsCancelRequest"] = true;
+    capabilities["supportsReadMemoryRequest"] = true;
 
     capabilities["supportsExceptionInfoRequest"] = true;
     capabilities["supportsExceptionFilterOptions"] = true;
@@ -432,6 +526,7 @@ void VSCodeProtocol::Cleanup()
 // Caller must care about m_outMutex.
 void VSCodeProtocol::EmitMessage(nlohmann::json &message, std::string &output)
 {
+    FlushPendingEvents();
     message["seq"] = std::to_string(m_seqCounter);
     ++m_seqCounter;
     output = message.dump();
@@ -456,6 +551,71 @@ void VSCodeProtocol::EmitEvent(const std::string &name, const nlohmann::json &bo
     EmitMessageWithLog(LOG_EVENT, message);
 }
 
+void VSCodeProtocol::EmitBatchedEvent(const std::string &name, const nlohmann::json &body)
+{
+    std::unique_lock<std::mutex> lock(m_outMutex);
+    if (!m_eventsBatching)
+    {
+        lock.unlock();
+        EmitEvent(name, body);
+        return;
+    }
+
+    if (m_pendingEvents.empty())
+    {
+        m_pendingEventsDeadline = std::chrono::steady_clock::now() + EVENTS_BATCH_WINDOW;
+        m_pendingEventsCV.notify_one();
+    }
+
+    m_pendingEvents.emplace_back(json{{"type", "event"}, {"event", name}, {"body", body}});
+}
+
+// Caller must care about m_outMutex.
+void VSCodeProtocol::FlushPendingEvents()
+{
+    if (m_pendingEvents.empty())
+        return;
+
+    std::string buffer;
+    std::vector<std::string> outputs;
+    outputs.reserve(m_pendingEvents.size());
+    for (json &message : m_pendingEvents)
+    {
+        message["seq"] = std::to_string(m_seqCounter);
+        ++m_seqCounter;
+        outputs.emplace_back(message.dump());
+        buffer += CONTENT_LENGTH;
+        buffer += std::to_string(outputs.back().size());
+        buffer += TWO_CRLF;
+        buffer += outputs.back();
+    }
+    // Note, must be cleared before Log() call, since in case of console logging Log() emit messages too.
+    m_pendingEvents.clear();
+
+    cout << buffer;
+    cout.flush();
+
+    for (const std::string &output : outputs)
+        Log(LOG_EVENT, output);
+}
+
+void VSCodeProtocol::EventsFlushWorker()
+{
+    std::unique_lock<std::mutex> lock(m_outMutex);
+
+    while (m_eventsBatching)
+    {
+        if (m_pendingEvents.empty())
+            m_pendingEventsCV.wait(lock);
+        else if (std::chrono::steady_clock::now() >= m_pendingEventsDeadline)
+            FlushPendingEvents();
+        else
+            m_pendingEventsCV.wait_until(lock, m_pendingEventsDeadline);
+    }
+
+    FlushPendingEvents();
+}
+
 static HRESULT HandleCommand(std::shared_ptr<IDebugger> &sharedDebugger, std::string &fileExec, std::vector<std::string> &execArgs,
                              const std::string &command, const json &arguments, json &body)
 {
@@ -548,8 +708,21 @@ static HRESULT HandleCommand(std::shared_ptr<IDebugger> &sharedDebugger, std::st
 
         std::vector<LineBreakpoint> lineBreakpoints;
         for (auto &b : arguments.at("breakpoints"))
+        {
             lineBreakpoints.emplace_back(std::string(), b.at("line"), b.value("condition", std::string()));
 
+            // Custom field, non-stopping snapshot breakpoint, see "snapshot" event.
+            auto snapshotIt = b.find("snapshot");
+            if (snapshotIt == b.end() || !snapshotIt->is_object())
+                continue;
+
+            SnapshotOptions &snapshot = lineBreakpoints.back().snapshot;
+            snapshot.frames = snapshotIt->value("frames", 1u);
+            snapshot.depth = snapshotIt->value("depth", snapshot.depth);
+            snapshot.maxBytes = snapshotIt->value("maxBytes", snapshot.maxBytes);
+            snapshot.maxTimeMs = snapshotIt->value("maxTimeMs", snapshot.maxTimeMs);
+        }
+
         std::vector<Breakpoint> breakpoints;
         IfFailRet(sharedDebugger->SetLineBreakpoints(arguments.at("source").at("path"), lineBreakpoints, breakpoints));
 
@@ -558,6 +731,7 @@ static HRESULT HandleCommand(std::shared_ptr<IDebugger> &sharedDebugger, std::st
         return S_OK;
     } },
     { "launch", [&](const json &arguments, json &body){
+        HRESULT Status;
         auto cwdIt = arguments.find("cwd");
         const std::string cwd(cwdIt != arguments.end() ? cwdIt.value().get<std::string>() : std::string{});
         std::map<std::string, std::string> env;
@@ -574,6 +748,9 @@ static HRESULT HandleCommand(std::shared_ptr<IDebugger> &sharedDebugger, std::st
 
         sharedDebugger->SetJustMyCode(arguments.value("justMyCode", true)); // MS vsdbg have "justMyCode" enabled by default.
         sharedDebugger->SetStepFiltering(arguments.value("enableStepFiltering", true)); // MS vsdbg have "enableStepFiltering" enabled by default.
+        sharedDebugger->SetLazyProperties(arguments.value("lazyProperties", false));
+        sharedDebugger->SetGroupHugeArrays(true); // `variables` request have `start` and `count` for paging.
+        IfFailRet(SetTypeObjectCacheSize(sharedDebugger, arguments, body));
 
         if (!fileExec.empty())
             return sharedDebugger->Launch(fileExec, execArgs, env, cwd, arguments.value("stopAtEntry", false));
@@ -624,8 +801,60 @@ static HRESULT HandleCommand(std::shared_ptr<IDebugger> &sharedDebugger, std::st
             ));
 
         body["stackFrames"] = stackFrames;
-        body["totalFrames"] = totalFrames;
+        // Note, in case totalFrames is omitted, client request frames until response contain less frames than requested.
+        if (totalFrames >= 0)
+            body["totalFrames"] = totalFrames;
+
+        return S_OK;
+    } },
+    // Custom request, stack traces of all threads by one request, threads with identical stacks are grouped.
+    { "threadsStackTrace", [&](const json &arguments, json &body){
+        HRESULT Status;
+
+        json groups = json::array();
+        IfFailRet(sharedDebugger->GetThreadsStackTraces(unsigned(arguments.value("levels", 0)),
+            [&](const std::vector<ThreadId> &threads, const std::vector<StackFrame> &stackFrames)
+        {
+            json threadIds = json::array();
+            for (const ThreadId &threadId : threads)
+                threadIds.push_back(int(threadId));
+            groups.push_back(json{{"threadIds", threadIds}, {"stackFrames", stackFrames}});
+        }));
+
+        body["groups"] = groups;
+        return S_OK;
+    } },
+    // Custom requests, sampling profiler with collapsed stacks (flame graph) or speedscope output.
+    { "startSampling", [&](const json &arguments, json &body){
+        return sharedDebugger->StartSampling(unsigned(arguments.value("interval", 10)));
+    } },
+    { "stopSampling", [&](const json &arguments, json &body){
+        SamplingFormat format = arguments.value("format", "collapsed") == "speedscope" ? SamplingFormat::Speedscope : SamplingFormat::Collapsed;
+        std::string profile;
+        SamplingStats stats;
+        HRESULT Status;
+        IfFailRet(sharedDebugger->StopSampling(format, profile, stats));
 
+        body["profile"] = profile;
+        body["samples"] = stats.samples;
+        body["averagePauseMs"] = stats.samples == 0 ? 0.0 : double(stats.pauseTotalUs) / stats.samples / 1000;
+        body["maxPauseMs"] = double(stats.pauseMaxUs) / 1000;
+        return S_OK;
+    } },
+    { "latencyStats", [&](const json &arguments, json &body){
+        // Note, latency in microseconds, see StopLatencyStats and CallbacksQueueStats for description.
+        HRESULT Status;
+        auto enable = arguments.find("enable");
+        if (enable != arguments.end())
+            IfFailRet(sharedDebugger->EnableLatencyStats(enable->get<bool>()));
+
+        std::vector<StopLatencyStats> stats;
+        CallbacksQueueStats queueStats;
+        TypeObjectCacheStats typeObjectCacheStats;
+        IfFailRet(sharedDebugger->GetLatencyStats(arguments.value("reset", false), stats, queueStats, typeObjectCacheStats));
+        body["stops"] = stats;
+        body["callbacksQueue"] = queueStats;
+        body["typeObjectCache"] = typeObjectCacheStats;
         return S_OK;
     } },
     { "continue", [&](const json &arguments, json &body){
@@ -700,7 +929,8 @@ static HRESULT HandleCommand(std::shared_ptr<IDebugger> &sharedDebugger, std::st
         // https://github.com/OmniSharp/omnisharp-vscode/issues/3173
         Variable variable;
         std::string output;
-        Status = sharedDebugger->Evaluate(frameId, expression, variable, output);
+        // Note, hover show value in the same way as variables view, so, long strings are truncated.
+        Status = sharedDebugger->Evaluate(frameId, expression, variable, output, arguments.value("context", "") == "hover");
         if (FAILED(Status))
         {
             if (output.empty())
@@ -723,6 +953,81 @@ static HRESULT HandleCommand(std::shared_ptr<IDebugger> &sharedDebugger, std::st
             body["namedVariables"] = variable.namedVariables;
             // indexedVariables
         }
+        if (variable.memoryReference != 0)
+            body["memoryReference"] = ProtocolUtils::AddrToString(variable.memoryReference);
+        if (variable.changed)
+            body["presentationHint"] = json{{"attributes", json::array({"changed"})}};
+        return S_OK;
+    } },
+    // Custom request, since "variables" and "evaluate" responses contain only first part of huge string.
+    { "readString", [&](const json &arguments, json &body){
+        HRESULT Status;
+        std::string expression = arguments.at("expression");
+        FrameId frameId([&](){
+            auto frameIdIter = arguments.find("frameId");
+            if (frameIdIter == arguments.end())
+            {
+                ThreadId threadId = sharedDebugger->GetLastStoppedThreadId();
+                return FrameId{threadId, FrameLevel{0}};
+            }
+            else {
+                return FrameId{int(frameIdIter.value())};
+            }
+        }());
+        int offset = arguments.value("offset", 0);
+
+        std::string value;
+        int totalLength = 0;
+        int readLength = 0;
+        std::string output;
+        Status = sharedDebugger->ReadStringValue(frameId, expression, offset, arguments.value("count", 0), value, totalLength, readLength, output);
+        if (FAILED(Status))
+        {
+            if (output.empty())
+            {
+                std::stringstream stream;
+                stream << "error: 0x" << std::hex << Status;
+                body["message"] = stream.str();
+            }
+            else
+                body["message"] = output;
+
+            return Status;
+        }
+
+        body["value"] = value;
+        body["offset"] = offset;
+        // Note, count of UTF-16 chars read, next part starts at offset + count.
+        body["count"] = readLength;
+        body["totalLength"] = totalLength;
+        return S_OK;
+    } },
+    { "readMemory", [&](const json &arguments, json &body){
+        std::string memoryReference = arguments.at("memoryReference");
+        int64_t offset = arguments.value("offset", 0);
+        int count = arguments.at("count");
+        if (count < 0)
+            return E_INVALIDARG;
+
+        char *end = nullptr;
+        uint64_t address = strtoull(memoryReference.c_str(), &end, 16);
+        if (end == memoryReference.c_str() || *end != '\0')
+        {
+            body["message"] = "invalid memoryReference: " + memoryReference;
+            return E_INVALIDARG;
+        }
+        address += offset;
+
+        std::vector<uint8_t> data;
+        uint32_t unreadableBytes = 0;
+        HRESULT Status;
+        IfFailRet(sharedDebugger->ReadMemory(address, (uint32_t)count, data, unreadableBytes));
+
+        body["address"] = ProtocolUtils::AddrToString(address);
+        if (!data.empty())
+            body["data"] = ProtocolUtils::Base64Encode(data.data(), data.size());
+        if (unreadableBytes > 0)
+            body["unreadableBytes"] = unreadableBytes;
         return S_OK;
     } },
     { "setExpression", [&](const json &arguments, json &body){
@@ -764,6 +1069,7 @@ static HRESULT HandleCommand(std::shared_ptr<IDebugger> &sharedDebugger, std::st
         return S_OK;
     } },
     { "attach", [&](const json &arguments, json &body){
+        HRESULT Status;
         int processId;
 
         const json &processIdArg = arguments.at("processId");
@@ -774,6 +1080,10 @@ static HRESULT HandleCommand(std::shared_ptr<IDebugger> &sharedDebugger, std::st
         else
             return E_INVALIDARG;
 
+        sharedDebugger->SetLazyProperties(arguments.value("lazyProperties", false));
+        sharedDebugger->SetGroupHugeArrays(true); // `variables` request have `start` and `count` for paging.
+        IfFailRet(SetTypeObjectCacheSize(sharedDebugger, arguments, body));
+
         return sharedDebugger->Attach(processId);
     } },
     { "setVariable", [&](const json &arguments, json &body) {
@@ -1017,6 +1327,12 @@ void VSCodeProtocol::CommandLoop()
 {
     std::thread commandsWorker{&VSCodeProtocol::CommandsWorker, this};
 
+    {
+        std::lock_guard<std::mutex> lock(m_outMutex);
+        m_eventsBatching = true;
+    }
+    std::thread eventsFlushWorker{&VSCodeProtocol::EventsFlushWorker, this};
+
     m_exit = false;
 
     while (!m_exit)
@@ -1141,6 +1457,13 @@ void VSCodeProtocol::CommandLoop()
     }
 
     commandsWorker.join();
+
+    {
+        std::lock_guard<std::mutex> lock(m_outMutex);
+        m_eventsBatching = false;
+        m_pendingEventsCV.notify_one(); // notify_one with lock
+    }
+    eventsFlushWorker.join();
 }
 
 void VSCodeProtocol::EngineLogging(const std::string &path)
@@ -7,6 +7,8 @@
 #include <mutex>
 #include <string>
 #include <list>
+#include <vector>
+#include <chrono>
 #include <condition_variable>
 
 #pragma warning (disable:4068)  // Visual Studio should ignore GCC pragmas
@@ -38,6 +40,18 @@ class VSCodeProtocol : public IProtocol
     void EmitMessageWithLog(const std::string &message_prefix, nlohmann::json &message);
     void EmitEvent(const std::string &name, const nlohmann::json &body);
 
+    // Module and breakpoint events are coalesced during short time window and written at once.
+    // Note, all pending events are written before any other message, so, messages order is not changed.
+    // Note, this fields must be covered by m_outMutex.
+    std::vector<nlohmann::json> m_pendingEvents;
+    std::chrono::steady_clock::time_point m_pendingEventsDeadline;
+    bool m_eventsBatching;
+    std::condition_variable m_pendingEventsCV;
+
+    void EmitBatchedEvent(const std::string &name, const nlohmann::json &body);
+    void FlushPendingEvents();
+    void EventsFlushWorker();
+
     void Log(const std::string &prefix, const std::string &text);
 
     struct CommandQueueEntry
@@ -58,7 +72,7 @@ class VSCodeProtocol : public IProtocol
 public:
 
     VSCodeProtocol(std::istream& input, std::ostream& output) :
-        IProtocol(input, output), m_engineLogOutput(LogNone), m_seqCounter(1) {}
+        IProtocol(input, output), m_engineLogOutput(LogNone), m_seqCounter(1), m_eventsBatching(false) {}
     void EngineLogging(const std::string &path);
     void SetLaunchCommand(const std::string &fileExec, const std::vector<std::string> &args) override
     {
@@ -76,6 +90,7 @@ public:
     void EmitModuleEvent(const ModuleEvent &event) override;
     void EmitOutputEvent(OutputCategory category, string_view output, string_view source = "") override;
     void EmitBreakpointEvent(const BreakpointEvent &event) override;
+    void EmitSnapshotEvent(const SnapshotEvent &event) override;
     void Cleanup() override;
     void CommandLoop() override;
 
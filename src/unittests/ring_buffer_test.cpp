@@ -0,0 +1,90 @@
+// Copyright (c) 2026 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include <catch2/catch.hpp>
+#include <string>
+#include "utils/ring_buffer.h"
+
+using ::netcoredbg::Utility::RingBuffer;
+
+TEST_CASE("RingBuffer::default-constructor")
+{
+    RingBuffer<int> rb;
+    CHECK(rb.empty());
+    CHECK(rb.size() == 0);
+    CHECK(rb.capacity() > 0);
+}
+
+TEST_CASE("RingBuffer::fifo-order")
+{
+    RingBuffer<int> rb(4);
+    for (int i = 0; i < 3; i++)
+        rb.push_back() = i;
+
+    CHECK(rb.size() == 3);
+    CHECK(rb.front() == 0);
+    CHECK(rb.back() == 2);
+
+    for (int i = 0; i < 3; i++)
+    {
+        CHECK(rb.front() == i);
+        rb.pop_front();
+    }
+    CHECK(rb.empty());
+}
+
+TEST_CASE("RingBuffer::wrap-around-without-grow")
+{
+    RingBuffer<int> rb(4);
+    int next = 0, expected = 0;
+    for (int n = 0; n < 100; n++)
+    {
+        rb.push_back() = next++;
+        rb.push_back() = next++;
+        CHECK(rb.front() == expected++);
+        rb.pop_front();
+        CHECK(rb.front() == expected++);
+        rb.pop_front();
+    }
+    CHECK(rb.empty());
+    CHECK(rb.capacity() == 4);
+}
+
+TEST_CASE("RingBuffer::grow-keeps-order")
+{
+    RingBuffer<std::string> rb(2);
+    rb.push_back(std::string("a"));
+    rb.push_back(std::string("b"));
+    rb.pop_front();
+    // head is in the middle of storage now
+    rb.push_back(std::string("c"));
+    rb.push_back(std::string("d"));
+    rb.push_back(std::string("e"));
+
+    CHECK(rb.capacity() == 4);
+    CHECK(rb.size() == 4);
+    const char *expected[] = {"b", "c", "d", "e"};
+    for (const char *str : expected)
+    {
+        CHECK(rb.front() == str);
+        rb.pop_front();
+    }
+    CHECK(rb.empty());
+}
+
+TEST_CASE("RingBuffer::slots-reused")
+{
+    RingBuffer<std::string> rb(1);
+    rb.push_back() = "value";
+    const std::string *slot = &rb.front();
+    rb.pop_front();
+
+    std::string &reused = rb.push_back();
+    CHECK(&reused == slot);
+    CHECK(reused == "value"); // not destroyed by pop_front()
+
+    rb.clear();
+    CHECK(rb.empty());
+    CHECK(rb.capacity() == 1);
+}
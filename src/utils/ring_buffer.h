@@ -0,0 +1,111 @@
+// Copyright (c) 2026 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+/// \file ring_buffer.h  This file contains definition of `RingBuffer' class, FIFO queue with pooled storage.
+
+#pragma once
+#include <cstddef>
+#include <utility>
+#include <vector>
+#include <assert.h>
+
+namespace netcoredbg
+{
+
+namespace Utility
+{
+
+/// FIFO queue which keeps elements in preallocated slots, that reused by next push_back() calls.
+/// Storage grows (twice) only in case all slots are in use, so, no heap allocations are made
+/// by push/pop cycles on queue with stable depth.
+///
+/// Note, pop_front() don't destroy element, slot keeps its value until it will be reused,
+/// if element holds resources, caller should release them before pop_front() call.
+/// Element type must be default constructible and move assignable.
+template <typename T> class RingBuffer
+{
+public:
+    typedef T value_type;
+    typedef T& reference;
+    typedef const T& const_reference;
+    typedef size_t size_type;
+
+    explicit RingBuffer(size_type capacity = 16) : m_slots(capacity > 0 ? capacity : 1), m_head(0), m_size(0) {}
+
+    RingBuffer(const RingBuffer&) = delete;
+    RingBuffer& operator=(const RingBuffer&) = delete;
+
+    bool empty() const noexcept { return m_size == 0; }
+    size_type size() const noexcept { return m_size; }
+    size_type capacity() const noexcept { return m_slots.size(); }
+
+    reference front() noexcept
+    {
+        assert(!empty());
+        return m_slots[m_head];
+    }
+
+    const_reference front() const noexcept
+    {
+        assert(!empty());
+        return m_slots[m_head];
+    }
+
+    reference back() noexcept
+    {
+        assert(!empty());
+        return m_slots[(m_head + m_size - 1) % m_slots.size()];
+    }
+
+    const_reference back() const noexcept
+    {
+        assert(!empty());
+        return m_slots[(m_head + m_size - 1) % m_slots.size()];
+    }
+
+    /// Add slot at the end of queue and return reference to it, slot could contain value left by previous use.
+    reference push_back()
+    {
+        if (m_size == m_slots.size())
+            Grow();
+
+        m_size++;
+        return back();
+    }
+
+    void push_back(T&& value) { push_back() = std::move(value); }
+
+    void pop_front() noexcept
+    {
+        assert(!empty());
+        m_head = (m_head + 1) % m_slots.size();
+        m_size--;
+    }
+
+    /// Remove all elements from queue, allocated slots are kept.
+    void clear() noexcept
+    {
+        m_head = 0;
+        m_size = 0;
+    }
+
+private:
+    std::vector<T> m_slots;
+    size_type m_head;
+    size_type m_size;
+
+    void Grow()
+    {
+        std::vector<T> slots(m_slots.size() * 2);
+        for (size_type i = 0; i < m_size; i++)
+            slots[i] = std::move(m_slots[(m_head + i) % m_slots.size()]);
+
+        m_slots.swap(slots);
+        m_head = 0;
+    }
+};
+
+} // namespace Utility
+
+} // namespace netcoredbg
@@ -53,6 +53,7 @@ namespace NetcoreDbgTest.VSCode
         public bool stopAtEntry;
         public bool ?justMyCode;
         public bool ?enableStepFiltering;
+        public bool ?lazyProperties;
         public string internalConsoleOptions;
         public string __sessionId;
     }
@@ -143,6 +144,15 @@ namespace NetcoreDbgTest.VSCode
         public string condition;
         public string hitCondition;
         public string logMessage;
+        public SnapshotOptions snapshot;
+    }
+
+    // Custom field, non-stopping snapshot breakpoint, see "snapshot" event.
+    public class SnapshotOptions {
+        public int? frames;
+        public int? depth;
+        public int? maxBytes;
+        public int? maxTimeMs;
     }
 
     public class Source {
@@ -382,4 +392,82 @@ namespace NetcoreDbgTest.VSCode
         public int? frameId;
         public ValueFormat? format;
     }
+
+    public class ReadMemoryRequest : Request {
+        public ReadMemoryRequest()
+        {
+            command = "readMemory";
+        }
+        public ReadMemoryArguments arguments = new ReadMemoryArguments();
+    }
+
+    public class ReadMemoryArguments {
+        public string memoryReference;
+        public Int64? offset;
+        public int count;
+    }
+
+    public class ReadStringRequest : Request {
+        public ReadStringRequest()
+        {
+            command = "readString";
+        }
+        public ReadStringArguments arguments = new ReadStringArguments();
+    }
+
+    public class ReadStringArguments {
+        public string expression;
+        public Int64 ?frameId;
+        public int offset;
+        public int count;
+    }
+
+    public class ThreadsStackTraceRequest : Request {
+        public ThreadsStackTraceRequest()
+        {
+            command = "threadsStackTrace";
+        }
+        public ThreadsStackTraceArguments arguments = new ThreadsStackTraceArguments();
+    }
+
+    public class ThreadsStackTraceArguments {
+        public int ?levels;
+    }
+
+    public class LatencyStatsRequest : Request {
+        public LatencyStatsRequest()
+        {
+            command = "latencyStats";
+        }
+        public LatencyStatsArguments arguments = new LatencyStatsArguments();
+    }
+
+    public class LatencyStatsArguments {
+        public bool? enable;
+        public bool? reset;
+    }
+
+    public class StartSamplingRequest : Request {
+        public StartSamplingRequest()
+        {
+            command = "startSampling";
+        }
+        public StartSamplingArguments arguments = new StartSamplingArguments();
+    }
+
+    public class StartSamplingArguments {
+        public int? interval;
+    }
+
+    public class StopSamplingRequest : Request {
+        public StopSamplingRequest()
+        {
+            command = "stopSampling";
+        }
+        public StopSamplingArguments arguments = new StopSamplingArguments();
+    }
+
+    public class StopSamplingArguments {
+        public string format;
+    }
 }
@@ -82,12 +82,14 @@ namespace NetcoreDbgTest.VSCode
         public int variablesReference;
         public int ?namedVariables;
         public int ?indexedVariables;
+        public string memoryReference;
     }
 
     public class VariablePresentationHint {
         public string kind;
         public List<string> attributes;
         public string visibility;
+        public bool ?lazy;
     }
 
     public class EvaluateResponse : Response {
@@ -101,6 +103,52 @@ namespace NetcoreDbgTest.VSCode
         public int variablesReference;
         public int ?namedVariables;
         public int ?indexedVariables;
+        public string memoryReference;
+    }
+
+    public class ReadMemoryResponse : Response {
+        public ReadMemoryResponseBody body;
+    }
+
+    public class ReadMemoryResponseBody {
+        public string address;
+        public int ?unreadableBytes;
+        public string data;
+    }
+
+    public class ReadStringResponse : Response {
+        public ReadStringResponseBody body;
+    }
+
+    public class ReadStringResponseBody {
+        public string value;
+        public int offset;
+        public int count;
+        public int totalLength;
+    }
+
+    public class ThreadsStackTraceResponse : Response {
+        public ThreadsStackTraceResponseBody body;
+    }
+
+    public class ThreadsStackTraceResponseBody {
+        public List<ThreadsStackTraceGroup> groups;
+    }
+
+    public class ThreadsStackTraceGroup {
+        public List<int> threadIds;
+        public List<StackFrame> stackFrames;
+    }
+
+    public class StopSamplingResponse : Response {
+        public StopSamplingResponseBody body;
+    }
+
+    public class StopSamplingResponseBody {
+        public string profile;
+        public int samples;
+        public double averagePauseMs;
+        public double maxPauseMs;
     }
 
     public class SetVariableResponse : Response {
@@ -0,0 +1,322 @@
+using System;
+using System.IO;
+using System.Collections.Generic;
+using System.Diagnostics;
+
+using NetcoreDbgTest;
+using NetcoreDbgTest.VSCode;
+using NetcoreDbgTest.Script;
+
+using Newtonsoft.Json;
+
+// Stepping and stop latency benchmark, not a part of regular test run.
+// Environment variables:
+// NETCOREDBG_BENCH_ITERATIONS - number of measurements for each operation (1000 by default);
+// NETCOREDBG_BENCH_OUTPUT - path to JSON file with results ("VSCodeBenchStepping.json" by default).
+// All latencies in results are in microseconds, "client" - time from request sent till stopped event received,
+// "debugger" - debugger side latency split into phases, "callbacksQueue" - managed callbacks queueing delay,
+// "typeObjectCache" - type objects cache hits/misses (see "latencyStats" request).
+
+namespace NetcoreDbgTest.Script
+{
+    class Context
+    {
+        public void PrepareStart(string caller_trace)
+        {
+            InitializeRequest initializeRequest = new InitializeRequest();
+            initializeRequest.arguments.clientID = "vscode";
+            initializeRequest.arguments.clientName = "Visual Studio Code";
+            initializeRequest.arguments.adapterID = "coreclr";
+            initializeRequest.arguments.pathFormat = "path";
+            initializeRequest.arguments.linesStartAt1 = true;
+            initializeRequest.arguments.columnsStartAt1 = true;
+            initializeRequest.arguments.supportsVariableType = true;
+            initializeRequest.arguments.supportsVariablePaging = true;
+            initializeRequest.arguments.supportsRunInTerminalRequest = true;
+            initializeRequest.arguments.locale = "en-us";
+            Assert.True(VSCodeDebugger.Request(initializeRequest).Success, @"__FILE__:__LINE__"+"\n"+caller_trace);
+
+            LaunchRequest launchRequest = new LaunchRequest();
+            launchRequest.arguments.name = ".NET Core Launch (console) with pipeline";
+            launchRequest.arguments.type = "coreclr";
+            launchRequest.arguments.preLaunchTask = "build";
+            launchRequest.arguments.program = ControlInfo.TargetAssemblyPath;
+            launchRequest.arguments.cwd = "";
+            launchRequest.arguments.console = "internalConsole";
+            launchRequest.arguments.stopAtEntry = true;
+            launchRequest.arguments.internalConsoleOptions = "openOnSessionStart";
+            launchRequest.arguments.__sessionId = Guid.NewGuid().ToString();
+            Assert.True(VSCodeDebugger.Request(launchRequest).Success, @"__FILE__:__LINE__"+"\n"+caller_trace);
+        }
+
+        public void PrepareEnd(string caller_trace)
+        {
+            ConfigurationDoneRequest configurationDoneRequest = new ConfigurationDoneRequest();
+            Assert.True(VSCodeDebugger.Request(configurationDoneRequest).Success, @"__FILE__:__LINE__"+"\n"+caller_trace);
+        }
+
+        public void WasEntryPointHit(string caller_trace)
+        {
+            Func<string, bool> filter = (resJSON) => {
+                if (VSCodeDebugger.isResponseContainProperty(resJSON, "event", "stopped")
+                    && VSCodeDebugger.isResponseContainProperty(resJSON, "reason", "entry")) {
+                    threadId = Convert.ToInt32(VSCodeDebugger.GetResponsePropertyValue(resJSON, "threadId"));
+                    return true;
+                }
+                return false;
+            };
+
+            Assert.True(VSCodeDebugger.IsEventReceived(filter), @"__FILE__:__LINE__"+"\n"+caller_trace);
+        }
+
+        public void WasStopped(string caller_trace, string reason)
+        {
+            Func<string, bool> filter = (resJSON) => {
+                if (VSCodeDebugger.isResponseContainProperty(resJSON, "event", "stopped")
+                    && VSCodeDebugger.isResponseContainProperty(resJSON, "reason", reason)) {
+                    return true;
+                }
+                return false;
+            };
+
+            Assert.True(VSCodeDebugger.IsEventReceived(filter), @"__FILE__:__LINE__"+"\n"+caller_trace);
+        }
+
+        public void DebuggerExit(string caller_trace)
+        {
+            DisconnectRequest disconnectRequest = new DisconnectRequest();
+            disconnectRequest.arguments = new DisconnectArguments();
+            disconnectRequest.arguments.restart = false;
+            Assert.True(VSCodeDebugger.Request(disconnectRequest).Success, @"__FILE__:__LINE__"+"\n"+caller_trace);
+        }
+
+        public void SetBreakpoint(string caller_trace, string bpName)
+        {
+            Breakpoint bp = ControlInfo.Breakpoints[bpName];
+            Assert.Equal(BreakpointType.Line, bp.Type, @"__FILE__:__LINE__"+"\n"+caller_trace);
+            var lbp = (LineBreakpoint)bp;
+
+            SetBreakpointsRequest setBreakpointsRequest = new SetBreakpointsRequest();
+            setBreakpointsRequest.arguments.source.name = lbp.FileName;
+            // NOTE this code works only with one source file
+            setBreakpointsRequest.arguments.source.path = ControlInfo.SourceFilesPath;
+            setBreakpointsRequest.arguments.lines.Add(lbp.NumLine);
+            setBreakpointsRequest.arguments.breakpoints.Add(new SourceBreakpoint(lbp.NumLine));
+            setBreakpointsRequest.arguments.sourceModified = false;
+            Assert.True(VSCodeDebugger.Request(setBreakpointsRequest).Success, @"__FILE__:__LINE__"+"\n"+caller_trace);
+            BreakpointSourceName = lbp.FileName;
+        }
+
+        public void ClearBreakpoints(string caller_trace)
+        {
+            SetBreakpointsRequest setBreakpointsRequest = new SetBreakpointsRequest();
+            setBreakpointsRequest.arguments.source.name = BreakpointSourceName;
+            // NOTE this code works only with one source file
+            setBreakpointsRequest.arguments.source.path = ControlInfo.SourceFilesPath;
+            setBreakpointsRequest.arguments.sourceModified = false;
+            Assert.True(VSCodeDebugger.Request(setBreakpointsRequest).Success, @"__FILE__:__LINE__"+"\n"+caller_trace);
+        }
+
+        public void Continue(string caller_trace)
+        {
+            ContinueRequest continueRequest = new ContinueRequest();
+            continueRequest.arguments.threadId = threadId;
+            Assert.True(VSCodeDebugger.Request(continueRequest).Success, @"__FILE__:__LINE__"+"\n"+caller_trace);
+        }
+
+        public void Pause(string caller_trace)
+        {
+            PauseRequest pauseRequest = new PauseRequest();
+            pauseRequest.arguments.threadId = threadId;
+            Assert.True(VSCodeDebugger.Request(pauseRequest).Success, @"__FILE__:__LINE__"+"\n"+caller_trace);
+        }
+
+        public void StepOver(string caller_trace)
+        {
+            NextRequest nextRequest = new NextRequest();
+            nextRequest.arguments.threadId = threadId;
+            Assert.True(VSCodeDebugger.Request(nextRequest).Success, @"__FILE__:__LINE__"+"\n"+caller_trace);
+        }
+
+        public void StepIn(string caller_trace)
+        {
+            StepInRequest stepInRequest = new StepInRequest();
+            stepInRequest.arguments.threadId = threadId;
+            Assert.True(VSCodeDebugger.Request(stepInRequest).Success, @"__FILE__:__LINE__"+"\n"+caller_trace);
+        }
+
+        public void StepOut(string caller_trace)
+        {
+            StepOutRequest stepOutRequest = new StepOutRequest();
+            stepOutRequest.arguments.threadId = threadId;
+            Assert.True(VSCodeDebugger.Request(stepOutRequest).Success, @"__FILE__:__LINE__"+"\n"+caller_trace);
+        }
+
+        public void EnableLatencyStats(string caller_trace)
+        {
+            LatencyStatsRequest latencyStatsRequest = new LatencyStatsRequest();
+            latencyStatsRequest.arguments.enable = true;
+            latencyStatsRequest.arguments.reset = true;
+            Assert.True(VSCodeDebugger.Request(latencyStatsRequest).Success, @"__FILE__:__LINE__"+"\n"+caller_trace);
+        }
+
+        // Measure time from request till stopped event, `operation` must send request and wait for stopped event.
+        public void Measure(string name, Action operation)
+        {
+            if (!ClientLatency.ContainsKey(name))
+                ClientLatency[name] = new List<long>();
+
+            Stopwatch stopwatch = Stopwatch.StartNew();
+            operation();
+            stopwatch.Stop();
+            ClientLatency[name].Add(stopwatch.ElapsedTicks * 1000000 / Stopwatch.Frequency);
+        }
+
+        static Dictionary<string, long> Percentiles(List<long> values)
+        {
+            values.Sort();
+            Func<int, long> percentile = (p) => {
+                int rank = (values.Count * p + 99) / 100;
+                return values[rank > 0 ? rank - 1 : 0];
+            };
+            return new Dictionary<string, long> {
+                { "p50", percentile(50) },
+                { "p90", percentile(90) },
+                { "p99", percentile(99) },
+                { "max", values[values.Count - 1] }
+            };
+        }
+
+        public void WriteResults(string caller_trace)
+        {
+            LatencyStatsRequest latencyStatsRequest = new LatencyStatsRequest();
+            latencyStatsRequest.arguments.enable = false;
+            latencyStatsRequest.arguments.reset = true;
+            var ret = VSCodeDebugger.Request(latencyStatsRequest);
+            Assert.True(ret.Success, @"__FILE__:__LINE__"+"\n"+caller_trace);
+
+            var client = new Dictionary<string, object>();
+            foreach (var entry in ClientLatency) {
+                client[entry.Key] = new Dictionary<string, object> {
+                    { "count", entry.Value.Count },
+                    { "latency", Percentiles(entry.Value) }
+                };
+            }
+
+            var debuggerStats = Newtonsoft.Json.Linq.JObject.Parse(ret.ResponseStr)["body"];
+            var results = new Dictionary<string, object> {
+                { "iterations", Iterations },
+                { "client", client },
+                { "debugger", debuggerStats["stops"] },
+                { "callbacksQueue", debuggerStats["callbacksQueue"] },
+                { "typeObjectCache", debuggerStats["typeObjectCache"] }
+            };
+
+            string output = Environment.GetEnvironmentVariable("NETCOREDBG_BENCH_OUTPUT");
+            if (String.IsNullOrEmpty(output))
+                output = "VSCodeBenchStepping.json";
+
+            string json = JsonConvert.SerializeObject(results, Formatting.Indented);
+            File.WriteAllText(output, json);
+            Console.WriteLine(json);
+        }
+
+        public Context(ControlInfo controlInfo, NetcoreDbgTestCore.DebuggerClient debuggerClient)
+        {
+            ControlInfo = controlInfo;
+            VSCodeDebugger = new VSCodeDebugger(debuggerClient);
+
+            string iterations = Environment.GetEnvironmentVariable("NETCOREDBG_BENCH_ITERATIONS");
+            if (!String.IsNullOrEmpty(iterations))
+                Iterations = Convert.ToInt32(iterations);
+        }
+
+        ControlInfo ControlInfo;
+        VSCodeDebugger VSCodeDebugger;
+        int threadId = -1;
+        string BreakpointSourceName;
+        Dictionary<string, List<long>> ClientLatency = new Dictionary<string, List<long>>();
+        public int Iterations = 1000;
+    }
+}
+
+namespace VSCodeBenchStepping
+{
+    class Program
+    {
+        static void Main(string[] args)
+        {
+            Label.Checkpoint("init", "bench", (Object context) => {
+                Context Context = (Context)context;
+                Context.PrepareStart(@"__FILE__:__LINE__");
+                Context.SetBreakpoint(@"__FILE__:__LINE__", "bench_loop");
+                Context.PrepareEnd(@"__FILE__:__LINE__");
+                Context.WasEntryPointHit(@"__FILE__:__LINE__");
+                Context.EnableLatencyStats(@"__FILE__:__LINE__");
+            });
+
+            // Note, loop is never finished, debuggee is terminated by disconnect.
+            int sum = 0;
+            for (int i = 0; i < int.MaxValue; i++)
+            {
+                sum = bench_func(sum);                          Label.Breakpoint("bench_loop");
+                sum = sum % 1000;
+            }
+
+            Label.Checkpoint("bench", "finish", (Object context) => {
+                Context Context = (Context)context;
+
+                // Breakpoint hit, step-in into method and step-out back to loop.
+                for (int i = 0; i < Context.Iterations; i++)
+                {
+                    Context.Measure("breakpoint", () => {
+                        Context.Continue(@"__FILE__:__LINE__");
+                        Context.WasStopped(@"__FILE__:__LINE__", "breakpoint");
+                    });
+                    Context.Measure("stepIn", () => {
+                        Context.StepIn(@"__FILE__:__LINE__");
+                        Context.WasStopped(@"__FILE__:__LINE__", "step");
+                    });
+                    Context.Measure("stepOut", () => {
+                        Context.StepOut(@"__FILE__:__LINE__");
+                        Context.WasStopped(@"__FILE__:__LINE__", "step");
+                    });
+                }
+
+                // Step-over through loop lines, breakpoint removed in order to not interfere with steps.
+                Context.ClearBreakpoints(@"__FILE__:__LINE__");
+                for (int i = 0; i < Context.Iterations; i++)
+                {
+                    Context.Measure("stepOver", () => {
+                        Context.StepOver(@"__FILE__:__LINE__");
+                        Context.WasStopped(@"__FILE__:__LINE__", "step");
+                    });
+                }
+
+                // Pause of running loop.
+                for (int i = 0; i < Context.Iterations; i++)
+                {
+                    Context.Continue(@"__FILE__:__LINE__");
+                    System.Threading.Thread.Sleep(5);
+                    Context.Measure("pause", () => {
+                        Context.Pause(@"__FILE__:__LINE__");
+                        Context.WasStopped(@"__FILE__:__LINE__", "pause");
+                    });
+                }
+
+                Context.WriteResults(@"__FILE__:__LINE__");
+            });
+
+            Label.Checkpoint("finish", "", (Object context) => {
+                Context Context = (Context)context;
+                Context.DebuggerExit(@"__FILE__:__LINE__");
+            });
+        }
+
+        static int bench_func(int x)
+        {
+            int y = x + 1;
+            return y * 2;
+        }
+    }
+}
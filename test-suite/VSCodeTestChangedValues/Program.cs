@@ -0,0 +1,326 @@
+using System;
+using System.IO;
+using System.Collections.Generic;
+
+using NetcoreDbgTest;
+using NetcoreDbgTest.VSCode;
+using NetcoreDbgTest.Script;
+
+using Newtonsoft.Json;
+
+namespace NetcoreDbgTest.Script
+{
+    class Context
+    {
+        public void PrepareStart(string caller_trace)
+        {
+            InitializeRequest initializeRequest = new InitializeRequest();
+            initializeRequest.arguments.clientID = "vscode";
+            initializeRequest.arguments.clientName = "Visual Studio Code";
+            initializeRequest.arguments.adapterID = "coreclr";
+            initializeRequest.arguments.pathFormat = "path";
+            initializeRequest.arguments.linesStartAt1 = true;
+            initializeRequest.arguments.columnsStartAt1 = true;
+            initializeRequest.arguments.supportsVariableType = true;
+            initializeRequest.arguments.supportsVariablePaging = true;
+            initializeRequest.arguments.supportsRunInTerminalRequest = true;
+            initializeRequest.arguments.locale = "en-us";
+            Assert.True(VSCodeDebugger.Request(initializeRequest).Success, @"__FILE__:__LINE__"+"\n"+caller_trace);
+
+            LaunchRequest launchRequest = new LaunchRequest();
+            launchRequest.arguments.name = ".NET Core Launch (console) with pipeline";
+            launchRequest.arguments.type = "coreclr";
+            launchRequest.arguments.preLaunchTask = "build";
+            launchRequest.arguments.program = ControlInfo.TargetAssemblyPath;
+            launchRequest.arguments.cwd = "";
+            launchRequest.arguments.console = "internalConsole";
+            launchRequest.arguments.stopAtEntry = true;
+            launchRequest.arguments.internalConsoleOptions = "openOnSessionStart";
+            launchRequest.arguments.__sessionId = Guid.NewGuid().ToString();
+            Assert.True(VSCodeDebugger.Request(launchRequest).Success, @"__FILE__:__LINE__"+"\n"+caller_trace);
+        }
+
+        public void PrepareEnd(string caller_trace)
+        {
+            ConfigurationDoneRequest configurationDoneRequest = new ConfigurationDoneRequest();
+            Assert.True(VSCodeDebugger.Request(configurationDoneRequest).Success, @"__FILE__:__LINE__"+"\n"+caller_trace);
+        }
+
+        public void WasEntryPointHit(string caller_trace)
+        {
+            Func<string, bool> filter = (resJSON) => {
+                if (VSCodeDebugger.isResponseContainProperty(resJSON, "event", "stopped")
+                    && VSCodeDebugger.isResponseContainProperty(resJSON, "reason", "entry")) {
+                    threadId = Convert.ToInt32(VSCodeDebugger.GetResponsePropertyValue(resJSON, "threadId"));
+                    return true;
+                }
+                return false;
+            };
+
+            Assert.True(VSCodeDebugger.IsEventReceived(filter), @"__FILE__:__LINE__"+"\n"+caller_trace);
+        }
+
+        public void WasExit(string caller_trace)
+        {
+            bool wasExited = false;
+            int ?exitCode = null;
+            bool wasTerminated = false;
+
+            Func<string, bool> filter = (resJSON) => {
+                if (VSCodeDebugger.isResponseContainProperty(resJSON, "event", "exited")) {
+                    wasExited = true;
+                    ExitedEvent exitedEvent = JsonConvert.DeserializeObject<ExitedEvent>(resJSON);
+                    exitCode = exitedEvent.body.exitCode;
+                }
+                if (VSCodeDebugger.isResponseContainProperty(resJSON, "event", "terminated")) {
+                    wasTerminated = true;
+                }
+                if (wasExited && exitCode == 0 && wasTerminated)
+                    return true;
+
+                return false;
+            };
+
+            Assert.True(VSCodeDebugger.IsEventReceived(filter), @"__FILE__:__LINE__"+"\n"+caller_trace);
+        }
+
+        public void DebuggerExit(string caller_trace)
+        {
+            DisconnectRequest disconnectRequest = new DisconnectRequest();
+            disconnectRequest.arguments = new DisconnectArguments();
+            disconnectRequest.arguments.restart = false;
+            Assert.True(VSCodeDebugger.Request(disconnectRequest).Success, @"__FILE__:__LINE__"+"\n"+caller_trace);
+        }
+
+        public void AddBreakpoint(string caller_trace, string bpName)
+        {
+            Breakpoint bp = ControlInfo.Breakpoints[bpName];
+            Assert.Equal(BreakpointType.Line, bp.Type, @"__FILE__:__LINE__"+"\n"+caller_trace);
+            var lbp = (LineBreakpoint)bp;
+
+            BreakpointSourceName = lbp.FileName;
+            BreakpointList.Add(new SourceBreakpoint(lbp.NumLine, null));
+            BreakpointLines.Add(lbp.NumLine);
+        }
+
+        public void SetBreakpoints(string caller_trace)
+        {
+            SetBreakpointsRequest setBreakpointsRequest = new SetBreakpointsRequest();
+            setBreakpointsRequest.arguments.source.name = BreakpointSourceName;
+            // NOTE this code works only with one source file
+            setBreakpointsRequest.arguments.source.path = ControlInfo.SourceFilesPath;
+            setBreakpointsRequest.arguments.lines.AddRange(BreakpointLines);
+            setBreakpointsRequest.arguments.breakpoints.AddRange(BreakpointList);
+            setBreakpointsRequest.arguments.sourceModified = false;
+            Assert.True(VSCodeDebugger.Request(setBreakpointsRequest).Success, @"__FILE__:__LINE__"+"\n"+caller_trace);
+        }
+
+        public void WasBreakpointHit(string caller_trace, string bpName)
+        {
+            Func<string, bool> filter = (resJSON) => {
+                if (VSCodeDebugger.isResponseContainProperty(resJSON, "event", "stopped")
+                    && VSCodeDebugger.isResponseContainProperty(resJSON, "reason", "breakpoint")) {
+                    threadId = Convert.ToInt32(VSCodeDebugger.GetResponsePropertyValue(resJSON, "threadId"));
+                    return true;
+                }
+                return false;
+            };
+
+            Assert.True(VSCodeDebugger.IsEventReceived(filter), @"__FILE__:__LINE__"+"\n"+caller_trace);
+
+            StackTraceRequest stackTraceRequest = new StackTraceRequest();
+            stackTraceRequest.arguments.threadId = threadId;
+            stackTraceRequest.arguments.startFrame = 0;
+            stackTraceRequest.arguments.levels = 20;
+            var ret = VSCodeDebugger.Request(stackTraceRequest);
+            Assert.True(ret.Success, @"__FILE__:__LINE__"+"\n"+caller_trace);
+
+            Breakpoint breakpoint = ControlInfo.Breakpoints[bpName];
+            Assert.Equal(BreakpointType.Line, breakpoint.Type, @"__FILE__:__LINE__"+"\n"+caller_trace);
+            var lbp = (LineBreakpoint)breakpoint;
+
+            StackTraceResponse stackTraceResponse =
+                JsonConvert.DeserializeObject<StackTraceResponse>(ret.ResponseStr);
+
+            if (stackTraceResponse.body.stackFrames[0].line == lbp.NumLine
+                && stackTraceResponse.body.stackFrames[0].source.name == lbp.FileName
+                // NOTE this code works only with one source file
+                && stackTraceResponse.body.stackFrames[0].source.path == ControlInfo.SourceFilesPath)
+            {
+                frameId = stackTraceResponse.body.stackFrames[0].id;
+                return;
+            }
+
+            throw new ResultNotSuccessException(@"__FILE__:__LINE__"+"\n"+caller_trace);
+        }
+
+        public void StepOver(string caller_trace)
+        {
+            NextRequest nextRequest = new NextRequest();
+            nextRequest.arguments.threadId = threadId;
+            Assert.True(VSCodeDebugger.Request(nextRequest).Success, @"__FILE__:__LINE__"+"\n"+caller_trace);
+        }
+
+        public void WasStep(string caller_trace, string bpName)
+        {
+            Func<string, bool> filter = (resJSON) => {
+                if (VSCodeDebugger.isResponseContainProperty(resJSON, "event", "stopped")
+                    && VSCodeDebugger.isResponseContainProperty(resJSON, "reason", "step")) {
+                    threadId = Convert.ToInt32(VSCodeDebugger.GetResponsePropertyValue(resJSON, "threadId"));
+                    return true;
+                }
+                return false;
+            };
+
+            Assert.True(VSCodeDebugger.IsEventReceived(filter), @"__FILE__:__LINE__"+"\n"+caller_trace);
+
+            StackTraceRequest stackTraceRequest = new StackTraceRequest();
+            stackTraceRequest.arguments.threadId = threadId;
+            stackTraceRequest.arguments.startFrame = 0;
+            stackTraceRequest.arguments.levels = 20;
+            var ret = VSCodeDebugger.Request(stackTraceRequest);
+            Assert.True(ret.Success, @"__FILE__:__LINE__"+"\n"+caller_trace);
+
+            Breakpoint breakpoint = ControlInfo.Breakpoints[bpName];
+            Assert.Equal(BreakpointType.Line, breakpoint.Type, @"__FILE__:__LINE__"+"\n"+caller_trace);
+            var lbp = (LineBreakpoint)breakpoint;
+
+            StackTraceResponse stackTraceResponse =
+                JsonConvert.DeserializeObject<StackTraceResponse>(ret.ResponseStr);
+
+            if (stackTraceResponse.body.stackFrames[0].line == lbp.NumLine
+                && stackTraceResponse.body.stackFrames[0].source.name == lbp.FileName
+                // NOTE this code works only with one source file
+                && stackTraceResponse.body.stackFrames[0].source.path == ControlInfo.SourceFilesPath)
+            {
+                frameId = stackTraceResponse.body.stackFrames[0].id;
+                return;
+            }
+
+            throw new ResultNotSuccessException(@"__FILE__:__LINE__"+"\n"+caller_trace);
+        }
+
+        public List<Variable> GetLocalVariables(string caller_trace)
+        {
+            ScopesRequest scopesRequest = new ScopesRequest();
+            scopesRequest.arguments.frameId = frameId;
+            var ret = VSCodeDebugger.Request(scopesRequest);
+            Assert.True(ret.Success, @"__FILE__:__LINE__"+"\n"+caller_trace);
+
+            ScopesResponse scopesResponse =
+                JsonConvert.DeserializeObject<ScopesResponse>(ret.ResponseStr);
+
+            foreach (var Scope in scopesResponse.body.scopes) {
+                if (Scope.name != "Locals" || Scope.variablesReference == null)
+                    continue;
+
+                VariablesRequest variablesRequest = new VariablesRequest();
+                variablesRequest.arguments.variablesReference = (int)Scope.variablesReference;
+                ret = VSCodeDebugger.Request(variablesRequest);
+                Assert.True(ret.Success, @"__FILE__:__LINE__"+"\n"+caller_trace);
+
+                return JsonConvert.DeserializeObject<VariablesResponse>(ret.ResponseStr).body.variables;
+            }
+
+            throw new ResultNotSuccessException(@"__FILE__:__LINE__"+"\n"+caller_trace);
+        }
+
+        // Check, that only listed locals are marked by "changed" attribute.
+        public void CheckChangedLocals(string caller_trace, string[] Names, string[] Values)
+        {
+            var changedNames = new List<string>();
+            foreach (var Variable in GetLocalVariables(@"__FILE__:__LINE__"+"\n"+caller_trace)) {
+                int index = Array.IndexOf(Names, Variable.name);
+                if (index >= 0)
+                    Assert.Equal(Values[index], Variable.value, @"__FILE__:__LINE__"+"\n"+caller_trace);
+
+                if (Variable.presentationHint != null
+                    && Variable.presentationHint.attributes != null
+                    && Variable.presentationHint.attributes.Contains("changed"))
+                    changedNames.Add(Variable.name);
+            }
+
+            Assert.Equal(String.Join(",", Names), String.Join(",", changedNames), @"__FILE__:__LINE__"+"\n"+caller_trace);
+        }
+
+        public void Continue(string caller_trace)
+        {
+            ContinueRequest continueRequest = new ContinueRequest();
+            continueRequest.arguments.threadId = threadId;
+            Assert.True(VSCodeDebugger.Request(continueRequest).Success, @"__FILE__:__LINE__"+"\n"+caller_trace);
+        }
+
+        public Context(ControlInfo controlInfo, NetcoreDbgTestCore.DebuggerClient debuggerClient)
+        {
+            ControlInfo = controlInfo;
+            VSCodeDebugger = new VSCodeDebugger(debuggerClient);
+        }
+
+        ControlInfo ControlInfo;
+        VSCodeDebugger VSCodeDebugger;
+        int threadId = -1;
+        Int64 frameId = -1;
+        // NOTE this code works only with one source file
+        string BreakpointSourceName;
+        List<SourceBreakpoint> BreakpointList = new List<SourceBreakpoint>();
+        List<int> BreakpointLines = new List<int>();
+    }
+}
+
+namespace VSCodeTestChangedValues
+{
+    class Program
+    {
+        static void Main(string[] args)
+        {
+            Label.Checkpoint("init", "bp_test", (Object context) => {
+                Context Context = (Context)context;
+                Context.PrepareStart(@"__FILE__:__LINE__");
+                Context.AddBreakpoint(@"__FILE__:__LINE__", "bp");
+                Context.SetBreakpoints(@"__FILE__:__LINE__");
+                Context.PrepareEnd(@"__FILE__:__LINE__");
+                Context.WasEntryPointHit(@"__FILE__:__LINE__");
+                Context.Continue(@"__FILE__:__LINE__");
+            });
+
+            int a = 1;
+            int b = 2;
+            string s = "str";
+
+            b = 5;                                          Label.Breakpoint("bp");
+
+            Label.Checkpoint("bp_test", "step1", (Object context) => {
+                Context Context = (Context)context;
+                Context.WasBreakpointHit(@"__FILE__:__LINE__", "bp");
+                // Nothing is marked at first request, since there is no previous stop values.
+                Context.CheckChangedLocals(@"__FILE__:__LINE__", new string[] {}, new string[] {});
+                Context.StepOver(@"__FILE__:__LINE__");
+            });
+
+            s = "changed";                                  Label.Breakpoint("step1");
+
+            Label.Checkpoint("step1", "step2", (Object context) => {
+                Context Context = (Context)context;
+                Context.WasStep(@"__FILE__:__LINE__", "step1");
+                Context.CheckChangedLocals(@"__FILE__:__LINE__", new string[] { "b" }, new string[] { "5" });
+                Context.StepOver(@"__FILE__:__LINE__");
+            });
+
+            Console.WriteLine(a + b + s);                   Label.Breakpoint("step2");
+
+            Label.Checkpoint("step2", "finish", (Object context) => {
+                Context Context = (Context)context;
+                Context.WasStep(@"__FILE__:__LINE__", "step2");
+                // Previous stop changed value `b` is not changed at this stop.
+                Context.CheckChangedLocals(@"__FILE__:__LINE__", new string[] { "s" }, new string[] { "\"changed\"" });
+                Context.Continue(@"__FILE__:__LINE__");
+            });
+
+            Label.Checkpoint("finish", "", (Object context) => {
+                Context Context = (Context)context;
+                Context.WasExit(@"__FILE__:__LINE__");
+                Context.DebuggerExit(@"__FILE__:__LINE__");
+            });
+        }
+    }
+}
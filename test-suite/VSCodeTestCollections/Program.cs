@@ -0,0 +1,347 @@
+using System;
+using System.IO;
+using System.Collections.Generic;
+
+using NetcoreDbgTest;
+using NetcoreDbgTest.VSCode;
+using NetcoreDbgTest.Script;
+
+using Newtonsoft.Json;
+
+namespace NetcoreDbgTest.Script
+{
+    class Context
+    {
+        public void PrepareStart(string caller_trace)
+        {
+            InitializeRequest initializeRequest = new InitializeRequest();
+            initializeRequest.arguments.clientID = "vscode";
+            initializeRequest.arguments.clientName = "Visual Studio Code";
+            initializeRequest.arguments.adapterID = "coreclr";
+            initializeRequest.arguments.pathFormat = "path";
+            initializeRequest.arguments.linesStartAt1 = true;
+            initializeRequest.arguments.columnsStartAt1 = true;
+            initializeRequest.arguments.supportsVariableType = true;
+            initializeRequest.arguments.supportsVariablePaging = true;
+            initializeRequest.arguments.supportsRunInTerminalRequest = true;
+            initializeRequest.arguments.locale = "en-us";
+            Assert.True(VSCodeDebugger.Request(initializeRequest).Success, @"__FILE__:__LINE__"+"\n"+caller_trace);
+
+            LaunchRequest launchRequest = new LaunchRequest();
+            launchRequest.arguments.name = ".NET Core Launch (console) with pipeline";
+            launchRequest.arguments.type = "coreclr";
+            launchRequest.arguments.preLaunchTask = "build";
+            launchRequest.arguments.program = ControlInfo.TargetAssemblyPath;
+            launchRequest.arguments.cwd = "";
+            launchRequest.arguments.console = "internalConsole";
+            launchRequest.arguments.stopAtEntry = true;
+            launchRequest.arguments.internalConsoleOptions = "openOnSessionStart";
+            launchRequest.arguments.__sessionId = Guid.NewGuid().ToString();
+            Assert.True(VSCodeDebugger.Request(launchRequest).Success, @"__FILE__:__LINE__"+"\n"+caller_trace);
+        }
+
+        public void PrepareEnd(string caller_trace)
+        {
+            ConfigurationDoneRequest configurationDoneRequest = new ConfigurationDoneRequest();
+            Assert.True(VSCodeDebugger.Request(configurationDoneRequest).Success, @"__FILE__:__LINE__"+"\n"+caller_trace);
+        }
+
+        public void WasEntryPointHit(string caller_trace)
+        {
+            Func<string, bool> filter = (resJSON) => {
+                if (VSCodeDebugger.isResponseContainProperty(resJSON, "event", "stopped")
+                    && VSCodeDebugger.isResponseContainProperty(resJSON, "reason", "entry")) {
+                    threadId = Convert.ToInt32(VSCodeDebugger.GetResponsePropertyValue(resJSON, "threadId"));
+                    return true;
+                }
+                return false;
+            };
+
+            Assert.True(VSCodeDebugger.IsEventReceived(filter), @"__FILE__:__LINE__"+"\n"+caller_trace);
+        }
+
+        public void WasExit(string caller_trace)
+        {
+            bool wasExited = false;
+            int ?exitCode = null;
+            bool wasTerminated = false;
+
+            Func<string, bool> filter = (resJSON) => {
+                if (VSCodeDebugger.isResponseContainProperty(resJSON, "event", "exited")) {
+                    wasExited = true;
+                    ExitedEvent exitedEvent = JsonConvert.DeserializeObject<ExitedEvent>(resJSON);
+                    exitCode = exitedEvent.body.exitCode;
+                }
+                if (VSCodeDebugger.isResponseContainProperty(resJSON, "event", "terminated")) {
+                    wasTerminated = true;
+                }
+                if (wasExited && exitCode == 0 && wasTerminated)
+                    return true;
+
+                return false;
+            };
+
+            Assert.True(VSCodeDebugger.IsEventReceived(filter), @"__FILE__:__LINE__"+"\n"+caller_trace);
+        }
+
+        public void DebuggerExit(string caller_trace)
+        {
+            DisconnectRequest disconnectRequest = new DisconnectRequest();
+            disconnectRequest.arguments = new DisconnectArguments();
+            disconnectRequest.arguments.restart = false;
+            Assert.True(VSCodeDebugger.Request(disconnectRequest).Success, @"__FILE__:__LINE__"+"\n"+caller_trace);
+        }
+
+        public void AddBreakpoint(string caller_trace, string bpName)
+        {
+            Breakpoint bp = ControlInfo.Breakpoints[bpName];
+            Assert.Equal(BreakpointType.Line, bp.Type, @"__FILE__:__LINE__"+"\n"+caller_trace);
+            var lbp = (LineBreakpoint)bp;
+
+            BreakpointSourceName = lbp.FileName;
+            BreakpointList.Add(new SourceBreakpoint(lbp.NumLine, null));
+            BreakpointLines.Add(lbp.NumLine);
+        }
+
+        public void SetBreakpoints(string caller_trace)
+        {
+            SetBreakpointsRequest setBreakpointsRequest = new SetBreakpointsRequest();
+            setBreakpointsRequest.arguments.source.name = BreakpointSourceName;
+            // NOTE this code works only with one source file
+            setBreakpointsRequest.arguments.source.path = ControlInfo.SourceFilesPath;
+            setBreakpointsRequest.arguments.lines.AddRange(BreakpointLines);
+            setBreakpointsRequest.arguments.breakpoints.AddRange(BreakpointList);
+            setBreakpointsRequest.arguments.sourceModified = false;
+            Assert.True(VSCodeDebugger.Request(setBreakpointsRequest).Success, @"__FILE__:__LINE__"+"\n"+caller_trace);
+        }
+
+        public void WasBreakpointHit(string caller_trace, string bpName)
+        {
+            Func<string, bool> filter = (resJSON) => {
+                if (VSCodeDebugger.isResponseContainProperty(resJSON, "event", "stopped")
+                    && VSCodeDebugger.isResponseContainProperty(resJSON, "reason", "breakpoint")) {
+                    threadId = Convert.ToInt32(VSCodeDebugger.GetResponsePropertyValue(resJSON, "threadId"));
+                    return true;
+                }
+                return false;
+            };
+
+            Assert.True(VSCodeDebugger.IsEventReceived(filter), @"__FILE__:__LINE__"+"\n"+caller_trace);
+
+            StackTraceRequest stackTraceRequest = new StackTraceRequest();
+            stackTraceRequest.arguments.threadId = threadId;
+            stackTraceRequest.arguments.startFrame = 0;
+            stackTraceRequest.arguments.levels = 20;
+            var ret = VSCodeDebugger.Request(stackTraceRequest);
+            Assert.True(ret.Success, @"__FILE__:__LINE__"+"\n"+caller_trace);
+
+            Breakpoint breakpoint = ControlInfo.Breakpoints[bpName];
+            Assert.Equal(BreakpointType.Line, breakpoint.Type, @"__FILE__:__LINE__"+"\n"+caller_trace);
+            var lbp = (LineBreakpoint)breakpoint;
+
+            StackTraceResponse stackTraceResponse =
+                JsonConvert.DeserializeObject<StackTraceResponse>(ret.ResponseStr);
+
+            if (stackTraceResponse.body.stackFrames[0].line == lbp.NumLine
+                && stackTraceResponse.body.stackFrames[0].source.name == lbp.FileName
+                // NOTE this code works only with one source file
+                && stackTraceResponse.body.stackFrames[0].source.path == ControlInfo.SourceFilesPath)
+            {
+                frameId = stackTraceResponse.body.stackFrames[0].id;
+                return;
+            }
+
+            throw new ResultNotSuccessException(@"__FILE__:__LINE__"+"\n"+caller_trace);
+        }
+
+        public EvaluateResponseBody Evaluate(string caller_trace, string Expression)
+        {
+            EvaluateRequest evaluateRequest = new EvaluateRequest();
+            evaluateRequest.arguments.expression = Expression;
+            evaluateRequest.arguments.frameId = frameId;
+            var ret = VSCodeDebugger.Request(evaluateRequest);
+            Assert.True(ret.Success, @"__FILE__:__LINE__"+"\n"+caller_trace);
+
+            return JsonConvert.DeserializeObject<EvaluateResponse>(ret.ResponseStr).body;
+        }
+
+        public List<Variable> GetVariables(string caller_trace, int variablesReference, int start, int count)
+        {
+            VariablesRequest variablesRequest = new VariablesRequest();
+            variablesRequest.arguments.variablesReference = variablesReference;
+            variablesRequest.arguments.start = start;
+            variablesRequest.arguments.count = count;
+            var ret = VSCodeDebugger.Request(variablesRequest);
+            Assert.True(ret.Success, @"__FILE__:__LINE__"+"\n"+caller_trace);
+
+            return JsonConvert.DeserializeObject<VariablesResponse>(ret.ResponseStr).body.variables;
+        }
+
+        public Variable FindVariable(string caller_trace, List<Variable> variables, string name)
+        {
+            foreach (var Variable in variables) {
+                if (Variable.name == name)
+                    return Variable;
+            }
+
+            throw new ResultNotSuccessException(@"__FILE__:__LINE__"+"\n"+caller_trace);
+        }
+
+        public void CheckElements(string caller_trace, int variablesReference, int start, string[] Names, string[] Values)
+        {
+            var variables = GetVariables(@"__FILE__:__LINE__"+"\n"+caller_trace, variablesReference, start, Names.Length);
+            Assert.Equal(Names.Length, variables.Count, @"__FILE__:__LINE__"+"\n"+caller_trace);
+            for (int i = 0; i < Names.Length; i++)
+            {
+                Assert.Equal(Names[i], variables[i].name, @"__FILE__:__LINE__"+"\n"+caller_trace);
+                if (Values != null)
+                    Assert.Equal(Values[i], variables[i].value, @"__FILE__:__LINE__"+"\n"+caller_trace);
+            }
+        }
+
+        public string SetVariable(string caller_trace, int variablesReference, string Name, string Value)
+        {
+            SetVariableRequest setVariableRequest = new SetVariableRequest();
+            setVariableRequest.arguments.variablesReference = variablesReference;
+            setVariableRequest.arguments.name = Name;
+            setVariableRequest.arguments.value = Value;
+            var ret = VSCodeDebugger.Request(setVariableRequest);
+            Assert.True(ret.Success, @"__FILE__:__LINE__"+"\n"+caller_trace);
+
+            return JsonConvert.DeserializeObject<SetVariableResponse>(ret.ResponseStr).body.value;
+        }
+
+        public void ErrorSetVariable(string caller_trace, int variablesReference, string Name, string Value)
+        {
+            SetVariableRequest setVariableRequest = new SetVariableRequest();
+            setVariableRequest.arguments.variablesReference = variablesReference;
+            setVariableRequest.arguments.name = Name;
+            setVariableRequest.arguments.value = Value;
+            Assert.False(VSCodeDebugger.Request(setVariableRequest).Success, @"__FILE__:__LINE__"+"\n"+caller_trace);
+        }
+
+        public void Continue(string caller_trace)
+        {
+            ContinueRequest continueRequest = new ContinueRequest();
+            continueRequest.arguments.threadId = threadId;
+            Assert.True(VSCodeDebugger.Request(continueRequest).Success, @"__FILE__:__LINE__"+"\n"+caller_trace);
+        }
+
+        public Context(ControlInfo controlInfo, NetcoreDbgTestCore.DebuggerClient debuggerClient)
+        {
+            ControlInfo = controlInfo;
+            VSCodeDebugger = new VSCodeDebugger(debuggerClient);
+        }
+
+        ControlInfo ControlInfo;
+        VSCodeDebugger VSCodeDebugger;
+        int threadId = -1;
+        Int64 frameId = -1;
+        // NOTE this code works only with one source file
+        string BreakpointSourceName;
+        List<SourceBreakpoint> BreakpointList = new List<SourceBreakpoint>();
+        List<int> BreakpointLines = new List<int>();
+    }
+}
+
+namespace VSCodeTestCollections
+{
+    class Program
+    {
+        static void Main(string[] args)
+        {
+            Label.Checkpoint("init", "bp_test", (Object context) => {
+                Context Context = (Context)context;
+                Context.PrepareStart(@"__FILE__:__LINE__");
+                Context.AddBreakpoint(@"__FILE__:__LINE__", "bp");
+                Context.SetBreakpoints(@"__FILE__:__LINE__");
+                Context.PrepareEnd(@"__FILE__:__LINE__");
+                Context.WasEntryPointHit(@"__FILE__:__LINE__");
+                Context.Continue(@"__FILE__:__LINE__");
+            });
+
+            var dict = new Dictionary<int, string>() { { 1, "one" }, { 2, "two" }, { 3, "three" }, { 4, "four" } };
+            dict.Remove(2);
+            var objDict = new Dictionary<object, int>() { { new object(), 1 }, { new object(), 2 } };
+            var hashSet = new HashSet<int>();
+            for (int i = 0; i < 2500; i++)
+                hashSet.Add(i);
+            for (int i = 0; i < 10; i++)
+                hashSet.Remove(i);
+            var queue = new Queue<int>();
+            for (int i = 0; i < 1500; i++)
+                queue.Enqueue(i);
+            queue.Dequeue();
+            var list = new List<int>() { 10, 20, 30 };
+
+            Console.WriteLine("Collections initialized.");              Label.Breakpoint("bp");
+
+            Label.Checkpoint("bp_test", "finish", (Object context) => {
+                Context Context = (Context)context;
+                Context.WasBreakpointHit(@"__FILE__:__LINE__", "bp");
+
+                // Dictionary elements named by keys, free entries are skipped.
+                var dict = Context.Evaluate(@"__FILE__:__LINE__", "dict");
+                Context.CheckElements(@"__FILE__:__LINE__", dict.variablesReference, 0,
+                                      new string[] { "[1]", "[3]", "[4]", "Raw View" },
+                                      new string[] { "\"one\"", "\"three\"", "\"four\"", "" });
+                Context.CheckElements(@"__FILE__:__LINE__", dict.variablesReference, 1,
+                                      new string[] { "[3]", "[4]" }, new string[] { "\"three\"", "\"four\"" });
+
+                // Object keys printed as type name, elements named by index.
+                var objDict = Context.Evaluate(@"__FILE__:__LINE__", "objDict");
+                Context.CheckElements(@"__FILE__:__LINE__", objDict.variablesReference, 0,
+                                      new string[] { "[0]", "[1]", "Raw View" }, new string[] { "1", "2", "" });
+
+                // Huge hashed collections are grouped, groups and pages are built from logical indexes.
+                var hashSet = Context.Evaluate(@"__FILE__:__LINE__", "hashSet");
+                Context.CheckElements(@"__FILE__:__LINE__", hashSet.variablesReference, 0,
+                                      new string[] { "[0..999]", "[1000..1999]", "[2000..2489]", "Raw View" }, null);
+                var groups = Context.GetVariables(@"__FILE__:__LINE__", hashSet.variablesReference, 0, 0);
+                var lastGroup = Context.FindVariable(@"__FILE__:__LINE__", groups, "[2000..2489]");
+                Assert.Equal(490, lastGroup.namedVariables, @"__FILE__:__LINE__");
+                Context.CheckElements(@"__FILE__:__LINE__", lastGroup.variablesReference, 0,
+                                      new string[] { "[2000]", "[2001]" }, new string[] { "2010", "2011" });
+                Context.CheckElements(@"__FILE__:__LINE__", lastGroup.variablesReference, 488,
+                                      new string[] { "[2488]", "[2489]" }, new string[] { "2498", "2499" });
+                var firstGroup = Context.FindVariable(@"__FILE__:__LINE__", groups, "[0..999]");
+                Context.CheckElements(@"__FILE__:__LINE__", firstGroup.variablesReference, 500,
+                                      new string[] { "[500]" }, new string[] { "510" });
+
+                var queue = Context.Evaluate(@"__FILE__:__LINE__", "queue");
+                Context.CheckElements(@"__FILE__:__LINE__", queue.variablesReference, 0,
+                                      new string[] { "[0..999]", "[1000..1498]", "Raw View" }, null);
+                groups = Context.GetVariables(@"__FILE__:__LINE__", queue.variablesReference, 0, 0);
+                lastGroup = Context.FindVariable(@"__FILE__:__LINE__", groups, "[1000..1498]");
+                Context.CheckElements(@"__FILE__:__LINE__", lastGroup.variablesReference, 498,
+                                      new string[] { "[1498]" }, new string[] { "1499" });
+
+                // Collection elements are assigned through backing storage, HashSet elements can't be assigned.
+                var list = Context.Evaluate(@"__FILE__:__LINE__", "list");
+                Assert.Equal("25", Context.SetVariable(@"__FILE__:__LINE__", list.variablesReference, "[1]", "25"), @"__FILE__:__LINE__");
+                Context.CheckElements(@"__FILE__:__LINE__", list.variablesReference, 0,
+                                      new string[] { "[0]", "[1]", "[2]" }, new string[] { "10", "25", "30" });
+                Context.ErrorSetVariable(@"__FILE__:__LINE__", list.variablesReference, "[3]", "40");
+
+                Assert.Equal("\"tres\"", Context.SetVariable(@"__FILE__:__LINE__", dict.variablesReference, "[3]", "\"tres\""), @"__FILE__:__LINE__");
+                Context.CheckElements(@"__FILE__:__LINE__", dict.variablesReference, 0,
+                                      new string[] { "[1]", "[3]", "[4]" }, new string[] { "\"one\"", "\"tres\"", "\"four\"" });
+                Context.ErrorSetVariable(@"__FILE__:__LINE__", dict.variablesReference, "[2]", "\"dos\"");
+
+                Assert.Equal("7", Context.SetVariable(@"__FILE__:__LINE__", lastGroup.variablesReference, "[1498]", "7"), @"__FILE__:__LINE__");
+                Context.CheckElements(@"__FILE__:__LINE__", lastGroup.variablesReference, 498,
+                                      new string[] { "[1498]" }, new string[] { "7" });
+
+                Context.ErrorSetVariable(@"__FILE__:__LINE__", firstGroup.variablesReference, "[500]", "1");
+
+                Context.Continue(@"__FILE__:__LINE__");
+            });
+
+            Label.Checkpoint("finish", "", (Object context) => {
+                Context Context = (Context)context;
+                Context.WasExit(@"__FILE__:__LINE__");
+                Context.DebuggerExit(@"__FILE__:__LINE__");
+            });
+        }
+    }
+}
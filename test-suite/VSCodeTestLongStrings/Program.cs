@@ -0,0 +1,299 @@
+using System;
+using System.IO;
+using System.Collections.Generic;
+
+using NetcoreDbgTest;
+using NetcoreDbgTest.VSCode;
+using NetcoreDbgTest.Script;
+
+using Newtonsoft.Json;
+
+namespace NetcoreDbgTest.Script
+{
+    class Context
+    {
+        public void PrepareStart(string caller_trace)
+        {
+            InitializeRequest initializeRequest = new InitializeRequest();
+            initializeRequest.arguments.clientID = "vscode";
+            initializeRequest.arguments.clientName = "Visual Studio Code";
+            initializeRequest.arguments.adapterID = "coreclr";
+            initializeRequest.arguments.pathFormat = "path";
+            initializeRequest.arguments.linesStartAt1 = true;
+            initializeRequest.arguments.columnsStartAt1 = true;
+            initializeRequest.arguments.supportsVariableType = true;
+            initializeRequest.arguments.supportsVariablePaging = true;
+            initializeRequest.arguments.supportsRunInTerminalRequest = true;
+            initializeRequest.arguments.locale = "en-us";
+            Assert.True(VSCodeDebugger.Request(initializeRequest).Success, @"__FILE__:__LINE__"+"\n"+caller_trace);
+
+            LaunchRequest launchRequest = new LaunchRequest();
+            launchRequest.arguments.name = ".NET Core Launch (console) with pipeline";
+            launchRequest.arguments.type = "coreclr";
+            launchRequest.arguments.preLaunchTask = "build";
+            launchRequest.arguments.program = ControlInfo.TargetAssemblyPath;
+            launchRequest.arguments.cwd = "";
+            launchRequest.arguments.console = "internalConsole";
+            launchRequest.arguments.stopAtEntry = true;
+            launchRequest.arguments.internalConsoleOptions = "openOnSessionStart";
+            launchRequest.arguments.__sessionId = Guid.NewGuid().ToString();
+            Assert.True(VSCodeDebugger.Request(launchRequest).Success, @"__FILE__:__LINE__"+"\n"+caller_trace);
+        }
+
+        public void PrepareEnd(string caller_trace)
+        {
+            ConfigurationDoneRequest configurationDoneRequest = new ConfigurationDoneRequest();
+            Assert.True(VSCodeDebugger.Request(configurationDoneRequest).Success, @"__FILE__:__LINE__"+"\n"+caller_trace);
+        }
+
+        public void WasEntryPointHit(string caller_trace)
+        {
+            Func<string, bool> filter = (resJSON) => {
+                if (VSCodeDebugger.isResponseContainProperty(resJSON, "event", "stopped")
+                    && VSCodeDebugger.isResponseContainProperty(resJSON, "reason", "entry")) {
+                    threadId = Convert.ToInt32(VSCodeDebugger.GetResponsePropertyValue(resJSON, "threadId"));
+                    return true;
+                }
+                return false;
+            };
+
+            Assert.True(VSCodeDebugger.IsEventReceived(filter), @"__FILE__:__LINE__"+"\n"+caller_trace);
+        }
+
+        public void WasExit(string caller_trace)
+        {
+            bool wasExited = false;
+            int ?exitCode = null;
+            bool wasTerminated = false;
+
+            Func<string, bool> filter = (resJSON) => {
+                if (VSCodeDebugger.isResponseContainProperty(resJSON, "event", "exited")) {
+                    wasExited = true;
+                    ExitedEvent exitedEvent = JsonConvert.DeserializeObject<ExitedEvent>(resJSON);
+                    exitCode = exitedEvent.body.exitCode;
+                }
+                if (VSCodeDebugger.isResponseContainProperty(resJSON, "event", "terminated")) {
+                    wasTerminated = true;
+                }
+                if (wasExited && exitCode == 0 && wasTerminated)
+                    return true;
+
+                return false;
+            };
+
+            Assert.True(VSCodeDebugger.IsEventReceived(filter), @"__FILE__:__LINE__"+"\n"+caller_trace);
+        }
+
+        public void DebuggerExit(string caller_trace)
+        {
+            DisconnectRequest disconnectRequest = new DisconnectRequest();
+            disconnectRequest.arguments = new DisconnectArguments();
+            disconnectRequest.arguments.restart = false;
+            Assert.True(VSCodeDebugger.Request(disconnectRequest).Success, @"__FILE__:__LINE__"+"\n"+caller_trace);
+        }
+
+        public void AddBreakpoint(string caller_trace, string bpName)
+        {
+            Breakpoint bp = ControlInfo.Breakpoints[bpName];
+            Assert.Equal(BreakpointType.Line, bp.Type, @"__FILE__:__LINE__"+"\n"+caller_trace);
+            var lbp = (LineBreakpoint)bp;
+
+            BreakpointSourceName = lbp.FileName;
+            BreakpointList.Add(new SourceBreakpoint(lbp.NumLine, null));
+            BreakpointLines.Add(lbp.NumLine);
+        }
+
+        public void SetBreakpoints(string caller_trace)
+        {
+            SetBreakpointsRequest setBreakpointsRequest = new SetBreakpointsRequest();
+            setBreakpointsRequest.arguments.source.name = BreakpointSourceName;
+            // NOTE this code works only with one source file
+            setBreakpointsRequest.arguments.source.path = ControlInfo.SourceFilesPath;
+            setBreakpointsRequest.arguments.lines.AddRange(BreakpointLines);
+            setBreakpointsRequest.arguments.breakpoints.AddRange(BreakpointList);
+            setBreakpointsRequest.arguments.sourceModified = false;
+            Assert.True(VSCodeDebugger.Request(setBreakpointsRequest).Success, @"__FILE__:__LINE__"+"\n"+caller_trace);
+        }
+
+        public void WasBreakpointHit(string caller_trace, string bpName)
+        {
+            Func<string, bool> filter = (resJSON) => {
+                if (VSCodeDebugger.isResponseContainProperty(resJSON, "event", "stopped")
+                    && VSCodeDebugger.isResponseContainProperty(resJSON, "reason", "breakpoint")) {
+                    threadId = Convert.ToInt32(VSCodeDebugger.GetResponsePropertyValue(resJSON, "threadId"));
+                    return true;
+                }
+                return false;
+            };
+
+            Assert.True(VSCodeDebugger.IsEventReceived(filter), @"__FILE__:__LINE__"+"\n"+caller_trace);
+
+            StackTraceRequest stackTraceRequest = new StackTraceRequest();
+            stackTraceRequest.arguments.threadId = threadId;
+            stackTraceRequest.arguments.startFrame = 0;
+            stackTraceRequest.arguments.levels = 20;
+            var ret = VSCodeDebugger.Request(stackTraceRequest);
+            Assert.True(ret.Success, @"__FILE__:__LINE__"+"\n"+caller_trace);
+
+            Breakpoint breakpoint = ControlInfo.Breakpoints[bpName];
+            Assert.Equal(BreakpointType.Line, breakpoint.Type, @"__FILE__:__LINE__"+"\n"+caller_trace);
+            var lbp = (LineBreakpoint)breakpoint;
+
+            StackTraceResponse stackTraceResponse =
+                JsonConvert.DeserializeObject<StackTraceResponse>(ret.ResponseStr);
+
+            if (stackTraceResponse.body.stackFrames[0].line == lbp.NumLine
+                && stackTraceResponse.body.stackFrames[0].source.name == lbp.FileName
+                // NOTE this code works only with one source file
+                && stackTraceResponse.body.stackFrames[0].source.path == ControlInfo.SourceFilesPath)
+            {
+                frameId = stackTraceResponse.body.stackFrames[0].id;
+                return;
+            }
+
+            throw new ResultNotSuccessException(@"__FILE__:__LINE__"+"\n"+caller_trace);
+        }
+
+        public EvaluateResponseBody Evaluate(string caller_trace, string Expression, string EvalContext)
+        {
+            EvaluateRequest evaluateRequest = new EvaluateRequest();
+            evaluateRequest.arguments.expression = Expression;
+            evaluateRequest.arguments.frameId = frameId;
+            evaluateRequest.arguments.context = EvalContext;
+            var ret = VSCodeDebugger.Request(evaluateRequest);
+            Assert.True(ret.Success, @"__FILE__:__LINE__"+"\n"+caller_trace);
+
+            return JsonConvert.DeserializeObject<EvaluateResponse>(ret.ResponseStr).body;
+        }
+
+        public Variable GetLocalVariable(string caller_trace, string name)
+        {
+            ScopesRequest scopesRequest = new ScopesRequest();
+            scopesRequest.arguments.frameId = frameId;
+            var ret = VSCodeDebugger.Request(scopesRequest);
+            Assert.True(ret.Success, @"__FILE__:__LINE__"+"\n"+caller_trace);
+
+            ScopesResponse scopesResponse =
+                JsonConvert.DeserializeObject<ScopesResponse>(ret.ResponseStr);
+            Assert.True(scopesResponse.body.scopes[0].variablesReference != null, @"__FILE__:__LINE__"+"\n"+caller_trace);
+
+            VariablesRequest variablesRequest = new VariablesRequest();
+            variablesRequest.arguments.variablesReference = (int)scopesResponse.body.scopes[0].variablesReference;
+            ret = VSCodeDebugger.Request(variablesRequest);
+            Assert.True(ret.Success, @"__FILE__:__LINE__"+"\n"+caller_trace);
+
+            VariablesResponse variablesResponse =
+                JsonConvert.DeserializeObject<VariablesResponse>(ret.ResponseStr);
+            foreach (var Variable in variablesResponse.body.variables) {
+                if (Variable.name == name)
+                    return Variable;
+            }
+
+            throw new ResultNotSuccessException(@"__FILE__:__LINE__"+"\n"+caller_trace);
+        }
+
+        public void CheckReadString(string caller_trace, string Expression, int offset, int count, string value, int totalLength)
+        {
+            ReadStringRequest readStringRequest = new ReadStringRequest();
+            readStringRequest.arguments.expression = Expression;
+            readStringRequest.arguments.frameId = frameId;
+            readStringRequest.arguments.offset = offset;
+            readStringRequest.arguments.count = count;
+            var ret = VSCodeDebugger.Request(readStringRequest);
+            Assert.True(ret.Success, @"__FILE__:__LINE__"+"\n"+caller_trace);
+
+            var body = JsonConvert.DeserializeObject<ReadStringResponse>(ret.ResponseStr).body;
+            Assert.Equal(value, body.value, @"__FILE__:__LINE__"+"\n"+caller_trace);
+            Assert.Equal(offset, body.offset, @"__FILE__:__LINE__"+"\n"+caller_trace);
+            Assert.Equal(value.Length, body.count, @"__FILE__:__LINE__"+"\n"+caller_trace);
+            Assert.Equal(totalLength, body.totalLength, @"__FILE__:__LINE__"+"\n"+caller_trace);
+        }
+
+        public void ErrorReadString(string caller_trace, string Expression)
+        {
+            ReadStringRequest readStringRequest = new ReadStringRequest();
+            readStringRequest.arguments.expression = Expression;
+            readStringRequest.arguments.frameId = frameId;
+            Assert.False(VSCodeDebugger.Request(readStringRequest).Success, @"__FILE__:__LINE__"+"\n"+caller_trace);
+        }
+
+        public void Continue(string caller_trace)
+        {
+            ContinueRequest continueRequest = new ContinueRequest();
+            continueRequest.arguments.threadId = threadId;
+            Assert.True(VSCodeDebugger.Request(continueRequest).Success, @"__FILE__:__LINE__"+"\n"+caller_trace);
+        }
+
+        public Context(ControlInfo controlInfo, NetcoreDbgTestCore.DebuggerClient debuggerClient)
+        {
+            ControlInfo = controlInfo;
+            VSCodeDebugger = new VSCodeDebugger(debuggerClient);
+        }
+
+        ControlInfo ControlInfo;
+        VSCodeDebugger VSCodeDebugger;
+        int threadId = -1;
+        Int64 frameId = -1;
+        // NOTE this code works only with one source file
+        string BreakpointSourceName;
+        List<SourceBreakpoint> BreakpointList = new List<SourceBreakpoint>();
+        List<int> BreakpointLines = new List<int>();
+    }
+}
+
+namespace VSCodeTestLongStrings
+{
+    class Program
+    {
+        static void Main(string[] args)
+        {
+            Label.Checkpoint("init", "bp_test", (Object context) => {
+                Context Context = (Context)context;
+                Context.PrepareStart(@"__FILE__:__LINE__");
+                Context.AddBreakpoint(@"__FILE__:__LINE__", "bp");
+                Context.SetBreakpoints(@"__FILE__:__LINE__");
+                Context.PrepareEnd(@"__FILE__:__LINE__");
+                Context.WasEntryPointHit(@"__FILE__:__LINE__");
+                Context.Continue(@"__FILE__:__LINE__");
+            });
+
+            // Variables view show only first 10000 chars of string.
+            string longString = new string('a', 10000) + "bcd";
+            string shortString = "short";
+            int notString = 5;
+
+            Console.WriteLine("Strings initialized.");                  Label.Breakpoint("bp");
+
+            Label.Checkpoint("bp_test", "finish", (Object context) => {
+                Context Context = (Context)context;
+                Context.WasBreakpointHit(@"__FILE__:__LINE__", "bp");
+
+                string truncated = "\"" + new string('a', 10000) + "\"...";
+                string full = "\"" + new string('a', 10000) + "bcd\"";
+
+                // Long string truncated in variables view and hover only.
+                Assert.Equal(truncated, Context.GetLocalVariable(@"__FILE__:__LINE__", "longString").value, @"__FILE__:__LINE__");
+                Assert.Equal("\"short\"", Context.GetLocalVariable(@"__FILE__:__LINE__", "shortString").value, @"__FILE__:__LINE__");
+                Assert.Equal(truncated, Context.Evaluate(@"__FILE__:__LINE__", "longString", "hover").result, @"__FILE__:__LINE__");
+                Assert.Equal(full, Context.Evaluate(@"__FILE__:__LINE__", "longString", "repl").result, @"__FILE__:__LINE__");
+                Assert.Equal(full, Context.Evaluate(@"__FILE__:__LINE__", "longString", "watch").result, @"__FILE__:__LINE__");
+                Assert.Equal(truncated, Context.Evaluate(@"__FILE__:__LINE__", "longString", "hover").result, @"__FILE__:__LINE__");
+
+                // Rest of string could be read by parts.
+                Context.CheckReadString(@"__FILE__:__LINE__", "longString", 10000, 0, "bcd", 10003);
+                Context.CheckReadString(@"__FILE__:__LINE__", "longString", 9998, 3, "aab", 10003);
+                Context.CheckReadString(@"__FILE__:__LINE__", "longString", 10003, 10, "", 10003);
+                Context.CheckReadString(@"__FILE__:__LINE__", "shortString", 1, 2, "ho", 5);
+                Context.ErrorReadString(@"__FILE__:__LINE__", "notString");
+
+                Context.Continue(@"__FILE__:__LINE__");
+            });
+
+            Label.Checkpoint("finish", "", (Object context) => {
+                Context Context = (Context)context;
+                Context.WasExit(@"__FILE__:__LINE__");
+                Context.DebuggerExit(@"__FILE__:__LINE__");
+            });
+        }
+    }
+}
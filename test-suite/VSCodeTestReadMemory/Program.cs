@@ -0,0 +1,328 @@
+using System;
+using System.IO;
+using System.Collections.Generic;
+
+using NetcoreDbgTest;
+using NetcoreDbgTest.VSCode;
+using NetcoreDbgTest.Script;
+
+using Newtonsoft.Json;
+
+namespace NetcoreDbgTest.Script
+{
+    class Context
+    {
+        public void PrepareStart(string caller_trace)
+        {
+            InitializeRequest initializeRequest = new InitializeRequest();
+            initializeRequest.arguments.clientID = "vscode";
+            initializeRequest.arguments.clientName = "Visual Studio Code";
+            initializeRequest.arguments.adapterID = "coreclr";
+            initializeRequest.arguments.pathFormat = "path";
+            initializeRequest.arguments.linesStartAt1 = true;
+            initializeRequest.arguments.columnsStartAt1 = true;
+            initializeRequest.arguments.supportsVariableType = true;
+            initializeRequest.arguments.supportsVariablePaging = true;
+            initializeRequest.arguments.supportsRunInTerminalRequest = true;
+            initializeRequest.arguments.locale = "en-us";
+            Assert.True(VSCodeDebugger.Request(initializeRequest).Success, @"__FILE__:__LINE__"+"\n"+caller_trace);
+
+            LaunchRequest launchRequest = new LaunchRequest();
+            launchRequest.arguments.name = ".NET Core Launch (console) with pipeline";
+            launchRequest.arguments.type = "coreclr";
+            launchRequest.arguments.preLaunchTask = "build";
+            launchRequest.arguments.program = ControlInfo.TargetAssemblyPath;
+            launchRequest.arguments.cwd = "";
+            launchRequest.arguments.console = "internalConsole";
+            launchRequest.arguments.stopAtEntry = true;
+            launchRequest.arguments.internalConsoleOptions = "openOnSessionStart";
+            launchRequest.arguments.__sessionId = Guid.NewGuid().ToString();
+            Assert.True(VSCodeDebugger.Request(launchRequest).Success, @"__FILE__:__LINE__"+"\n"+caller_trace);
+        }
+
+        public void PrepareEnd(string caller_trace)
+        {
+            ConfigurationDoneRequest configurationDoneRequest = new ConfigurationDoneRequest();
+            Assert.True(VSCodeDebugger.Request(configurationDoneRequest).Success, @"__FILE__:__LINE__"+"\n"+caller_trace);
+        }
+
+        public void WasEntryPointHit(string caller_trace)
+        {
+            Func<string, bool> filter = (resJSON) => {
+                if (VSCodeDebugger.isResponseContainProperty(resJSON, "event", "stopped")
+                    && VSCodeDebugger.isResponseContainProperty(resJSON, "reason", "entry")) {
+                    threadId = Convert.ToInt32(VSCodeDebugger.GetResponsePropertyValue(resJSON, "threadId"));
+                    return true;
+                }
+                return false;
+            };
+
+            Assert.True(VSCodeDebugger.IsEventReceived(filter), @"__FILE__:__LINE__"+"\n"+caller_trace);
+        }
+
+        public void WasExit(string caller_trace)
+        {
+            bool wasExited = false;
+            int ?exitCode = null;
+            bool wasTerminated = false;
+
+            Func<string, bool> filter = (resJSON) => {
+                if (VSCodeDebugger.isResponseContainProperty(resJSON, "event", "exited")) {
+                    wasExited = true;
+                    ExitedEvent exitedEvent = JsonConvert.DeserializeObject<ExitedEvent>(resJSON);
+                    exitCode = exitedEvent.body.exitCode;
+                }
+                if (VSCodeDebugger.isResponseContainProperty(resJSON, "event", "terminated")) {
+                    wasTerminated = true;
+                }
+                if (wasExited && exitCode == 0 && wasTerminated)
+                    return true;
+
+                return false;
+            };
+
+            Assert.True(VSCodeDebugger.IsEventReceived(filter), @"__FILE__:__LINE__"+"\n"+caller_trace);
+        }
+
+        public void DebuggerExit(string caller_trace)
+        {
+            DisconnectRequest disconnectRequest = new DisconnectRequest();
+            disconnectRequest.arguments = new DisconnectArguments();
+            disconnectRequest.arguments.restart = false;
+            Assert.True(VSCodeDebugger.Request(disconnectRequest).Success, @"__FILE__:__LINE__"+"\n"+caller_trace);
+        }
+
+        public void AddBreakpoint(string caller_trace, string bpName)
+        {
+            Breakpoint bp = ControlInfo.Breakpoints[bpName];
+            Assert.Equal(BreakpointType.Line, bp.Type, @"__FILE__:__LINE__"+"\n"+caller_trace);
+            var lbp = (LineBreakpoint)bp;
+
+            BreakpointSourceName = lbp.FileName;
+            BreakpointList.Add(new SourceBreakpoint(lbp.NumLine, null));
+            BreakpointLines.Add(lbp.NumLine);
+        }
+
+        public void SetBreakpoints(string caller_trace)
+        {
+            SetBreakpointsRequest setBreakpointsRequest = new SetBreakpointsRequest();
+            setBreakpointsRequest.arguments.source.name = BreakpointSourceName;
+            // NOTE this code works only with one source file
+            setBreakpointsRequest.arguments.source.path = ControlInfo.SourceFilesPath;
+            setBreakpointsRequest.arguments.lines.AddRange(BreakpointLines);
+            setBreakpointsRequest.arguments.breakpoints.AddRange(BreakpointList);
+            setBreakpointsRequest.arguments.sourceModified = false;
+            Assert.True(VSCodeDebugger.Request(setBreakpointsRequest).Success, @"__FILE__:__LINE__"+"\n"+caller_trace);
+        }
+
+        public void WasBreakpointHit(string caller_trace, string bpName)
+        {
+            Func<string, bool> filter = (resJSON) => {
+                if (VSCodeDebugger.isResponseContainProperty(resJSON, "event", "stopped")
+                    && VSCodeDebugger.isResponseContainProperty(resJSON, "reason", "breakpoint")) {
+                    threadId = Convert.ToInt32(VSCodeDebugger.GetResponsePropertyValue(resJSON, "threadId"));
+                    return true;
+                }
+                return false;
+            };
+
+            Assert.True(VSCodeDebugger.IsEventReceived(filter), @"__FILE__:__LINE__"+"\n"+caller_trace);
+
+            StackTraceRequest stackTraceRequest = new StackTraceRequest();
+            stackTraceRequest.arguments.threadId = threadId;
+            stackTraceRequest.arguments.startFrame = 0;
+            stackTraceRequest.arguments.levels = 20;
+            var ret = VSCodeDebugger.Request(stackTraceRequest);
+            Assert.True(ret.Success, @"__FILE__:__LINE__"+"\n"+caller_trace);
+
+            Breakpoint breakpoint = ControlInfo.Breakpoints[bpName];
+            Assert.Equal(BreakpointType.Line, breakpoint.Type, @"__FILE__:__LINE__"+"\n"+caller_trace);
+            var lbp = (LineBreakpoint)breakpoint;
+
+            StackTraceResponse stackTraceResponse =
+                JsonConvert.DeserializeObject<StackTraceResponse>(ret.ResponseStr);
+
+            if (stackTraceResponse.body.stackFrames[0].line == lbp.NumLine
+                && stackTraceResponse.body.stackFrames[0].source.name == lbp.FileName
+                // NOTE this code works only with one source file
+                && stackTraceResponse.body.stackFrames[0].source.path == ControlInfo.SourceFilesPath)
+            {
+                frameId = stackTraceResponse.body.stackFrames[0].id;
+                return;
+            }
+
+            throw new ResultNotSuccessException(@"__FILE__:__LINE__"+"\n"+caller_trace);
+        }
+
+        public EvaluateResponseBody Evaluate(string caller_trace, string Expression)
+        {
+            EvaluateRequest evaluateRequest = new EvaluateRequest();
+            evaluateRequest.arguments.expression = Expression;
+            evaluateRequest.arguments.frameId = frameId;
+            var ret = VSCodeDebugger.Request(evaluateRequest);
+            Assert.True(ret.Success, @"__FILE__:__LINE__"+"\n"+caller_trace);
+
+            return JsonConvert.DeserializeObject<EvaluateResponse>(ret.ResponseStr).body;
+        }
+
+        // Check array elements, that read by bulk memory read for primitive arrays.
+        public void CheckArrayElements(string caller_trace, string Expression, string Type, int start, string[] Values)
+        {
+            var array = Evaluate(@"__FILE__:__LINE__"+"\n"+caller_trace, Expression);
+            Assert.True(array.variablesReference != 0, @"__FILE__:__LINE__"+"\n"+caller_trace);
+
+            VariablesRequest variablesRequest = new VariablesRequest();
+            variablesRequest.arguments.variablesReference = array.variablesReference;
+            variablesRequest.arguments.start = start;
+            variablesRequest.arguments.count = Values.Length;
+            var ret = VSCodeDebugger.Request(variablesRequest);
+            Assert.True(ret.Success, @"__FILE__:__LINE__"+"\n"+caller_trace);
+
+            VariablesResponse variablesResponse =
+                JsonConvert.DeserializeObject<VariablesResponse>(ret.ResponseStr);
+
+            Assert.Equal(Values.Length, variablesResponse.body.variables.Count, @"__FILE__:__LINE__"+"\n"+caller_trace);
+            for (int i = 0; i < Values.Length; i++)
+            {
+                var Variable = variablesResponse.body.variables[i];
+                Assert.Equal("[" + (start + i).ToString() + "]", Variable.name, @"__FILE__:__LINE__"+"\n"+caller_trace);
+                Assert.Equal(Type, Variable.type, @"__FILE__:__LINE__"+"\n"+caller_trace);
+                Assert.Equal(Values[i], Variable.value, @"__FILE__:__LINE__"+"\n"+caller_trace);
+            }
+        }
+
+        public string GetMemoryReference(string caller_trace, string Expression)
+        {
+            var result = Evaluate(@"__FILE__:__LINE__"+"\n"+caller_trace, Expression);
+            return result.memoryReference;
+        }
+
+        public ReadMemoryResponseBody ReadMemory(string caller_trace, string memoryReference, Int64 offset, int count)
+        {
+            ReadMemoryRequest readMemoryRequest = new ReadMemoryRequest();
+            readMemoryRequest.arguments.memoryReference = memoryReference;
+            readMemoryRequest.arguments.offset = offset;
+            readMemoryRequest.arguments.count = count;
+            var ret = VSCodeDebugger.Request(readMemoryRequest);
+            Assert.True(ret.Success, @"__FILE__:__LINE__"+"\n"+caller_trace);
+
+            return JsonConvert.DeserializeObject<ReadMemoryResponse>(ret.ResponseStr).body;
+        }
+
+        public void CheckReadMemory(string caller_trace, string memoryReference, Int64 offset, byte[] expected)
+        {
+            var body = ReadMemory(@"__FILE__:__LINE__"+"\n"+caller_trace, memoryReference, offset, expected.Length);
+            Assert.True(body.unreadableBytes == null, @"__FILE__:__LINE__"+"\n"+caller_trace);
+            Assert.Equal(Convert.ToBase64String(expected), body.data, @"__FILE__:__LINE__"+"\n"+caller_trace);
+        }
+
+        public void CheckReadMemoryLimit(string caller_trace, string memoryReference, int count)
+        {
+            var body = ReadMemory(@"__FILE__:__LINE__"+"\n"+caller_trace, memoryReference, 0, count);
+            int read = body.data == null ? 0 : Convert.FromBase64String(body.data).Length;
+            // Note, memory behind the limit is readable, so, it must not be reported as unreadable.
+            Assert.Equal(1024 * 1024, read, @"__FILE__:__LINE__"+"\n"+caller_trace);
+            Assert.True(body.unreadableBytes == null, @"__FILE__:__LINE__"+"\n"+caller_trace);
+        }
+
+        public void ErrorReadMemory(string caller_trace, string memoryReference)
+        {
+            ReadMemoryRequest readMemoryRequest = new ReadMemoryRequest();
+            readMemoryRequest.arguments.memoryReference = memoryReference;
+            readMemoryRequest.arguments.count = 4;
+            Assert.False(VSCodeDebugger.Request(readMemoryRequest).Success, @"__FILE__:__LINE__"+"\n"+caller_trace);
+        }
+
+        public void Continue(string caller_trace)
+        {
+            ContinueRequest continueRequest = new ContinueRequest();
+            continueRequest.arguments.threadId = threadId;
+            Assert.True(VSCodeDebugger.Request(continueRequest).Success, @"__FILE__:__LINE__"+"\n"+caller_trace);
+        }
+
+        public Context(ControlInfo controlInfo, NetcoreDbgTestCore.DebuggerClient debuggerClient)
+        {
+            ControlInfo = controlInfo;
+            VSCodeDebugger = new VSCodeDebugger(debuggerClient);
+        }
+
+        ControlInfo ControlInfo;
+        VSCodeDebugger VSCodeDebugger;
+        int threadId = -1;
+        Int64 frameId = -1;
+        // NOTE this code works only with one source file
+        string BreakpointSourceName;
+        List<SourceBreakpoint> BreakpointList = new List<SourceBreakpoint>();
+        List<int> BreakpointLines = new List<int>();
+    }
+}
+
+namespace VSCodeTestReadMemory
+{
+    class Program
+    {
+        static void Main(string[] args)
+        {
+            Label.Checkpoint("init", "bp_test", (Object context) => {
+                Context Context = (Context)context;
+                Context.PrepareStart(@"__FILE__:__LINE__");
+                Context.AddBreakpoint(@"__FILE__:__LINE__", "bp");
+                Context.SetBreakpoints(@"__FILE__:__LINE__");
+                Context.PrepareEnd(@"__FILE__:__LINE__");
+                Context.WasEntryPointHit(@"__FILE__:__LINE__");
+                Context.Continue(@"__FILE__:__LINE__");
+            });
+
+            int[] intArray = new int[] { 1, -2, 3, 0x01020304, int.MaxValue };
+            byte[] byteArray = new byte[] { 0, 1, 127, 128, 255 };
+            double[] doubleArray = new double[] { 1.5, -2.25, 0 };
+            char[] charArray = new char[] { 'a', 'b', 'c' };
+            byte[] hugeArray = new byte[3 * 1024 * 1024];
+            for (int i = 0; i < hugeArray.Length; i++)
+                hugeArray[i] = (byte)i;
+            string[] stringArray = new string[] { "a", "b" };
+
+            Console.WriteLine("Arrays initialized.");                   Label.Breakpoint("bp");
+
+            Label.Checkpoint("bp_test", "finish", (Object context) => {
+                Context Context = (Context)context;
+                Context.WasBreakpointHit(@"__FILE__:__LINE__", "bp");
+
+                // Elements of primitive arrays.
+                Context.CheckArrayElements(@"__FILE__:__LINE__", "intArray", "int", 0, new string[] { "1", "-2", "3", "16909060", "2147483647" });
+                Context.CheckArrayElements(@"__FILE__:__LINE__", "intArray", "int", 3, new string[] { "16909060", "2147483647" });
+                Context.CheckArrayElements(@"__FILE__:__LINE__", "byteArray", "byte", 0, new string[] { "0", "1", "127", "128", "255" });
+                Context.CheckArrayElements(@"__FILE__:__LINE__", "doubleArray", "double", 0, new string[] { "1.5", "-2.25", "0" });
+                Context.CheckArrayElements(@"__FILE__:__LINE__", "charArray", "char", 1, new string[] { "98 'b'", "99 'c'" });
+
+                // Memory reference provided for primitive arrays only.
+                string intArrayRef = Context.GetMemoryReference(@"__FILE__:__LINE__", "intArray");
+                string byteArrayRef = Context.GetMemoryReference(@"__FILE__:__LINE__", "byteArray");
+                string hugeArrayRef = Context.GetMemoryReference(@"__FILE__:__LINE__", "hugeArray");
+                Assert.True(intArrayRef != null, @"__FILE__:__LINE__");
+                Assert.True(byteArrayRef != null, @"__FILE__:__LINE__");
+                Assert.True(hugeArrayRef != null, @"__FILE__:__LINE__");
+                Assert.True(Context.GetMemoryReference(@"__FILE__:__LINE__", "stringArray") == null, @"__FILE__:__LINE__");
+
+                // Memory reference points to first array element.
+                Context.CheckReadMemory(@"__FILE__:__LINE__", byteArrayRef, 0, new byte[] { 0, 1, 127, 128, 255 });
+                Context.CheckReadMemory(@"__FILE__:__LINE__", byteArrayRef, 2, new byte[] { 127, 128 });
+                Context.CheckReadMemory(@"__FILE__:__LINE__", intArrayRef, 12, BitConverter.GetBytes(0x01020304));
+
+                // Huge read is limited, client should request rest by next read.
+                Context.CheckReadMemoryLimit(@"__FILE__:__LINE__", hugeArrayRef, 2 * 1024 * 1024);
+                Context.CheckReadMemory(@"__FILE__:__LINE__", hugeArrayRef, 1024 * 1024, new byte[] { 0, 1, 2 });
+
+                Context.ErrorReadMemory(@"__FILE__:__LINE__", "not_an_address");
+
+                Context.Continue(@"__FILE__:__LINE__");
+            });
+
+            Label.Checkpoint("finish", "", (Object context) => {
+                Context Context = (Context)context;
+                Context.WasExit(@"__FILE__:__LINE__");
+                Context.DebuggerExit(@"__FILE__:__LINE__");
+            });
+        }
+    }
+}
@@ -0,0 +1,352 @@
+using System;
+using System.IO;
+using System.Collections.Generic;
+
+using NetcoreDbgTest;
+using NetcoreDbgTest.VSCode;
+using NetcoreDbgTest.Script;
+
+using Newtonsoft.Json;
+
+namespace NetcoreDbgTest.Script
+{
+    class Context
+    {
+        public void PrepareStart(string caller_trace)
+        {
+            InitializeRequest initializeRequest = new InitializeRequest();
+            initializeRequest.arguments.clientID = "vscode";
+            initializeRequest.arguments.clientName = "Visual Studio Code";
+            initializeRequest.arguments.adapterID = "coreclr";
+            initializeRequest.arguments.pathFormat = "path";
+            initializeRequest.arguments.linesStartAt1 = true;
+            initializeRequest.arguments.columnsStartAt1 = true;
+            initializeRequest.arguments.supportsVariableType = true;
+            initializeRequest.arguments.supportsVariablePaging = true;
+            initializeRequest.arguments.supportsRunInTerminalRequest = true;
+            initializeRequest.arguments.locale = "en-us";
+            Assert.True(VSCodeDebugger.Request(initializeRequest).Success, @"__FILE__:__LINE__"+"\n"+caller_trace);
+
+            LaunchRequest launchRequest = new LaunchRequest();
+            launchRequest.arguments.name = ".NET Core Launch (console) with pipeline";
+            launchRequest.arguments.type = "coreclr";
+            launchRequest.arguments.preLaunchTask = "build";
+            launchRequest.arguments.program = ControlInfo.TargetAssemblyPath;
+            launchRequest.arguments.cwd = "";
+            launchRequest.arguments.console = "internalConsole";
+            launchRequest.arguments.stopAtEntry = true;
+            launchRequest.arguments.internalConsoleOptions = "openOnSessionStart";
+            launchRequest.arguments.__sessionId = Guid.NewGuid().ToString();
+            Assert.True(VSCodeDebugger.Request(launchRequest).Success, @"__FILE__:__LINE__"+"\n"+caller_trace);
+        }
+
+        public void PrepareEnd(string caller_trace)
+        {
+            ConfigurationDoneRequest configurationDoneRequest = new ConfigurationDoneRequest();
+            Assert.True(VSCodeDebugger.Request(configurationDoneRequest).Success, @"__FILE__:__LINE__"+"\n"+caller_trace);
+        }
+
+        public void WasEntryPointHit(string caller_trace)
+        {
+            Func<string, bool> filter = (resJSON) => {
+                if (VSCodeDebugger.isResponseContainProperty(resJSON, "event", "stopped")
+                    && VSCodeDebugger.isResponseContainProperty(resJSON, "reason", "entry")) {
+                    threadId = Convert.ToInt32(VSCodeDebugger.GetResponsePropertyValue(resJSON, "threadId"));
+                    return true;
+                }
+                return false;
+            };
+
+            Assert.True(VSCodeDebugger.IsEventReceived(filter), @"__FILE__:__LINE__"+"\n"+caller_trace);
+        }
+
+        public void WasExit(string caller_trace)
+        {
+            bool wasExited = false;
+            int ?exitCode = null;
+            bool wasTerminated = false;
+
+            Func<string, bool> filter = (resJSON) => {
+                if (VSCodeDebugger.isResponseContainProperty(resJSON, "event", "exited")) {
+                    wasExited = true;
+                    ExitedEvent exitedEvent = JsonConvert.DeserializeObject<ExitedEvent>(resJSON);
+                    exitCode = exitedEvent.body.exitCode;
+                }
+                if (VSCodeDebugger.isResponseContainProperty(resJSON, "event", "terminated")) {
+                    wasTerminated = true;
+                }
+                if (wasExited && exitCode == 0 && wasTerminated)
+                    return true;
+
+                return false;
+            };
+
+            Assert.True(VSCodeDebugger.IsEventReceived(filter), @"__FILE__:__LINE__"+"\n"+caller_trace);
+        }
+
+        public void DebuggerExit(string caller_trace)
+        {
+            DisconnectRequest disconnectRequest = new DisconnectRequest();
+            disconnectRequest.arguments = new DisconnectArguments();
+            disconnectRequest.arguments.restart = false;
+            Assert.True(VSCodeDebugger.Request(disconnectRequest).Success, @"__FILE__:__LINE__"+"\n"+caller_trace);
+        }
+
+        public void AddBreakpoint(string caller_trace, string bpName)
+        {
+            Breakpoint bp = ControlInfo.Breakpoints[bpName];
+            Assert.Equal(BreakpointType.Line, bp.Type, @"__FILE__:__LINE__"+"\n"+caller_trace);
+            var lbp = (LineBreakpoint)bp;
+
+            BreakpointSourceName = lbp.FileName;
+            BreakpointList.Add(new SourceBreakpoint(lbp.NumLine, null));
+            BreakpointLines.Add(lbp.NumLine);
+        }
+
+        public void SetBreakpoints(string caller_trace)
+        {
+            SetBreakpointsRequest setBreakpointsRequest = new SetBreakpointsRequest();
+            setBreakpointsRequest.arguments.source.name = BreakpointSourceName;
+            // NOTE this code works only with one source file
+            setBreakpointsRequest.arguments.source.path = ControlInfo.SourceFilesPath;
+            setBreakpointsRequest.arguments.lines.AddRange(BreakpointLines);
+            setBreakpointsRequest.arguments.breakpoints.AddRange(BreakpointList);
+            setBreakpointsRequest.arguments.sourceModified = false;
+            Assert.True(VSCodeDebugger.Request(setBreakpointsRequest).Success, @"__FILE__:__LINE__"+"\n"+caller_trace);
+        }
+
+        public void WasBreakpointHit(string caller_trace, string bpName)
+        {
+            Func<string, bool> filter = (resJSON) => {
+                if (VSCodeDebugger.isResponseContainProperty(resJSON, "event", "stopped")
+                    && VSCodeDebugger.isResponseContainProperty(resJSON, "reason", "breakpoint")) {
+                    threadId = Convert.ToInt32(VSCodeDebugger.GetResponsePropertyValue(resJSON, "threadId"));
+                    return true;
+                }
+                return false;
+            };
+
+            Assert.True(VSCodeDebugger.IsEventReceived(filter), @"__FILE__:__LINE__"+"\n"+caller_trace);
+
+            StackTraceRequest stackTraceRequest = new StackTraceRequest();
+            stackTraceRequest.arguments.threadId = threadId;
+            stackTraceRequest.arguments.startFrame = 0;
+            stackTraceRequest.arguments.levels = 20;
+            var ret = VSCodeDebugger.Request(stackTraceRequest);
+            Assert.True(ret.Success, @"__FILE__:__LINE__"+"\n"+caller_trace);
+
+            Breakpoint breakpoint = ControlInfo.Breakpoints[bpName];
+            Assert.Equal(BreakpointType.Line, breakpoint.Type, @"__FILE__:__LINE__"+"\n"+caller_trace);
+            var lbp = (LineBreakpoint)breakpoint;
+
+            StackTraceResponse stackTraceResponse =
+                JsonConvert.DeserializeObject<StackTraceResponse>(ret.ResponseStr);
+
+            if (stackTraceResponse.body.stackFrames[0].line == lbp.NumLine
+                && stackTraceResponse.body.stackFrames[0].source.name == lbp.FileName
+                // NOTE this code works only with one source file
+                && stackTraceResponse.body.stackFrames[0].source.path == ControlInfo.SourceFilesPath)
+            {
+                frameId = stackTraceResponse.body.stackFrames[0].id;
+                return;
+            }
+
+            throw new ResultNotSuccessException(@"__FILE__:__LINE__"+"\n"+caller_trace);
+        }
+
+        public void Pause(string caller_trace)
+        {
+            PauseRequest pauseRequest = new PauseRequest();
+            pauseRequest.arguments.threadId = threadId;
+            Assert.True(VSCodeDebugger.Request(pauseRequest).Success, @"__FILE__:__LINE__"+"\n"+caller_trace);
+        }
+
+        public void WasPaused(string caller_trace)
+        {
+            Func<string, bool> filter = (resJSON) => {
+                if (VSCodeDebugger.isResponseContainProperty(resJSON, "event", "stopped")
+                    && VSCodeDebugger.isResponseContainProperty(resJSON, "reason", "pause")) {
+                    threadId = Convert.ToInt32(VSCodeDebugger.GetResponsePropertyValue(resJSON, "threadId"));
+                    return true;
+                }
+                return false;
+            };
+
+            Assert.True(VSCodeDebugger.IsEventReceived(filter), @"__FILE__:__LINE__"+"\n"+caller_trace);
+        }
+
+        public void StartSampling(string caller_trace, int interval)
+        {
+            StartSamplingRequest startSamplingRequest = new StartSamplingRequest();
+            startSamplingRequest.arguments.interval = interval;
+            Assert.True(VSCodeDebugger.Request(startSamplingRequest).Success, @"__FILE__:__LINE__"+"\n"+caller_trace);
+        }
+
+        public StopSamplingResponseBody StopSampling(string caller_trace, string format)
+        {
+            StopSamplingRequest stopSamplingRequest = new StopSamplingRequest();
+            stopSamplingRequest.arguments.format = format;
+            var ret = VSCodeDebugger.Request(stopSamplingRequest);
+            Assert.True(ret.Success, @"__FILE__:__LINE__"+"\n"+caller_trace);
+
+            var body = JsonConvert.DeserializeObject<StopSamplingResponse>(ret.ResponseStr).body;
+            Assert.True(body.samples > 0, @"__FILE__:__LINE__"+"\n"+caller_trace);
+            Assert.True(body.maxPauseMs >= body.averagePauseMs, @"__FILE__:__LINE__"+"\n"+caller_trace);
+            return body;
+        }
+
+        public void ErrorStopSampling(string caller_trace)
+        {
+            StopSamplingRequest stopSamplingRequest = new StopSamplingRequest();
+            Assert.False(VSCodeDebugger.Request(stopSamplingRequest).Success, @"__FILE__:__LINE__"+"\n"+caller_trace);
+        }
+
+        // Collapsed stacks format: "root frame;...;leaf frame count" line for each unique stack.
+        public void CheckCollapsedProfile(string caller_trace, string profile, string rootFrame, string leafFrame)
+        {
+            bool found = false;
+            foreach (var line in profile.Split(new char[] { '\n' }, StringSplitOptions.RemoveEmptyEntries))
+            {
+                int countPos = line.LastIndexOf(' ');
+                Assert.True(countPos > 0, @"__FILE__:__LINE__"+"\n"+caller_trace);
+                Assert.True(Convert.ToInt32(line.Substring(countPos + 1)) > 0, @"__FILE__:__LINE__"+"\n"+caller_trace);
+
+                var frames = line.Substring(0, countPos).Split(';');
+                if (Array.FindIndex(frames, frame => frame.StartsWith(rootFrame)) >= 0 && frames[frames.Length - 1].StartsWith(leafFrame))
+                    found = true;
+            }
+            Assert.True(found, @"__FILE__:__LINE__"+"\n"+caller_trace);
+        }
+
+        public void CheckSpeedscopeProfile(string caller_trace, string profile, string frameName)
+        {
+            var json = Newtonsoft.Json.Linq.JObject.Parse(profile);
+            Assert.Equal("https://www.speedscope.app/file-format-schema.json", (string)json["$schema"], @"__FILE__:__LINE__"+"\n"+caller_trace);
+
+            var frames = (Newtonsoft.Json.Linq.JArray)json["shared"]["frames"];
+            int frameIndex = -1;
+            for (int i = 0; i < frames.Count; i++)
+            {
+                if (((string)frames[i]["name"]).StartsWith(frameName))
+                    frameIndex = i;
+            }
+            Assert.True(frameIndex >= 0, @"__FILE__:__LINE__"+"\n"+caller_trace);
+
+            var sampled = json["profiles"][0];
+            Assert.Equal("sampled", (string)sampled["type"], @"__FILE__:__LINE__"+"\n"+caller_trace);
+            var samples = (Newtonsoft.Json.Linq.JArray)sampled["samples"];
+            var weights = (Newtonsoft.Json.Linq.JArray)sampled["weights"];
+            Assert.True(samples.Count > 0, @"__FILE__:__LINE__"+"\n"+caller_trace);
+            Assert.Equal(samples.Count, weights.Count, @"__FILE__:__LINE__"+"\n"+caller_trace);
+
+            bool found = false;
+            long endValue = 0;
+            for (int i = 0; i < samples.Count; i++)
+            {
+                foreach (var index in (Newtonsoft.Json.Linq.JArray)samples[i])
+                {
+                    Assert.True((int)index < frames.Count, @"__FILE__:__LINE__"+"\n"+caller_trace);
+                    if ((int)index == frameIndex)
+                        found = true;
+                }
+                endValue += (long)weights[i];
+            }
+            Assert.True(found, @"__FILE__:__LINE__"+"\n"+caller_trace);
+            Assert.Equal(endValue, (long)sampled["endValue"], @"__FILE__:__LINE__"+"\n"+caller_trace);
+        }
+
+        public void Continue(string caller_trace)
+        {
+            ContinueRequest continueRequest = new ContinueRequest();
+            continueRequest.arguments.threadId = threadId;
+            Assert.True(VSCodeDebugger.Request(continueRequest).Success, @"__FILE__:__LINE__"+"\n"+caller_trace);
+        }
+
+        public Context(ControlInfo controlInfo, NetcoreDbgTestCore.DebuggerClient debuggerClient)
+        {
+            ControlInfo = controlInfo;
+            VSCodeDebugger = new VSCodeDebugger(debuggerClient);
+        }
+
+        ControlInfo ControlInfo;
+        VSCodeDebugger VSCodeDebugger;
+        int threadId = -1;
+        Int64 frameId = -1;
+        // NOTE this code works only with one source file
+        string BreakpointSourceName;
+        List<SourceBreakpoint> BreakpointList = new List<SourceBreakpoint>();
+        List<int> BreakpointLines = new List<int>();
+    }
+}
+
+namespace VSCodeTestSampling
+{
+    class Program
+    {
+        static long counter;
+
+        static void BusyLoop(int ms)
+        {
+            var stopwatch = System.Diagnostics.Stopwatch.StartNew();
+            while (stopwatch.ElapsedMilliseconds < ms)
+                counter++;
+        }
+
+        static void Main(string[] args)
+        {
+            Label.Checkpoint("init", "pause_test", (Object context) => {
+                Context Context = (Context)context;
+                Context.PrepareStart(@"__FILE__:__LINE__");
+                Context.AddBreakpoint(@"__FILE__:__LINE__", "bp1");
+                Context.AddBreakpoint(@"__FILE__:__LINE__", "bp2");
+                Context.SetBreakpoints(@"__FILE__:__LINE__");
+                Context.PrepareEnd(@"__FILE__:__LINE__");
+                Context.WasEntryPointHit(@"__FILE__:__LINE__");
+
+                Context.StartSampling(@"__FILE__:__LINE__", 1);
+                Context.Continue(@"__FILE__:__LINE__");
+                // Pause during sampling must not be lost.
+                Context.Pause(@"__FILE__:__LINE__");
+            });
+
+            BusyLoop(3000);
+
+            Label.Checkpoint("pause_test", "bp1_test", (Object context) => {
+                Context Context = (Context)context;
+                Context.WasPaused(@"__FILE__:__LINE__");
+                Context.Continue(@"__FILE__:__LINE__");
+            });
+
+            Console.WriteLine("BusyLoop done.");                        Label.Breakpoint("bp1");
+
+            Label.Checkpoint("bp1_test", "bp2_test", (Object context) => {
+                Context Context = (Context)context;
+                Context.WasBreakpointHit(@"__FILE__:__LINE__", "bp1");
+                var result = Context.StopSampling(@"__FILE__:__LINE__", "collapsed");
+                Context.CheckCollapsedProfile(@"__FILE__:__LINE__", result.profile, "VSCodeTestSampling.Program.Main(", "VSCodeTestSampling.Program.BusyLoop(");
+                Context.ErrorStopSampling(@"__FILE__:__LINE__");
+
+                Context.StartSampling(@"__FILE__:__LINE__", 10);
+                Context.Continue(@"__FILE__:__LINE__");
+            });
+
+            BusyLoop(1000);
+
+            Console.WriteLine("BusyLoop done.");                        Label.Breakpoint("bp2");
+
+            Label.Checkpoint("bp2_test", "finish", (Object context) => {
+                Context Context = (Context)context;
+                Context.WasBreakpointHit(@"__FILE__:__LINE__", "bp2");
+                var result = Context.StopSampling(@"__FILE__:__LINE__", "speedscope");
+                Context.CheckSpeedscopeProfile(@"__FILE__:__LINE__", result.profile, "VSCodeTestSampling.Program.BusyLoop(");
+                Context.Continue(@"__FILE__:__LINE__");
+            });
+
+            Label.Checkpoint("finish", "", (Object context) => {
+                Context Context = (Context)context;
+                Context.WasExit(@"__FILE__:__LINE__");
+                Context.DebuggerExit(@"__FILE__:__LINE__");
+            });
+        }
+    }
+}
@@ -0,0 +1,290 @@
+using System;
+using System.IO;
+using System.Collections.Generic;
+
+using NetcoreDbgTest;
+using NetcoreDbgTest.VSCode;
+using NetcoreDbgTest.Script;
+
+using Newtonsoft.Json;
+
+namespace NetcoreDbgTest.Script
+{
+    class Context
+    {
+        public void PrepareStart(string caller_trace)
+        {
+            InitializeRequest initializeRequest = new InitializeRequest();
+            initializeRequest.arguments.clientID = "vscode";
+            initializeRequest.arguments.clientName = "Visual Studio Code";
+            initializeRequest.arguments.adapterID = "coreclr";
+            initializeRequest.arguments.pathFormat = "path";
+            initializeRequest.arguments.linesStartAt1 = true;
+            initializeRequest.arguments.columnsStartAt1 = true;
+            initializeRequest.arguments.supportsVariableType = true;
+            initializeRequest.arguments.supportsVariablePaging = true;
+            initializeRequest.arguments.supportsRunInTerminalRequest = true;
+            initializeRequest.arguments.locale = "en-us";
+            Assert.True(VSCodeDebugger.Request(initializeRequest).Success, @"__FILE__:__LINE__"+"\n"+caller_trace);
+
+            LaunchRequest launchRequest = new LaunchRequest();
+            launchRequest.arguments.name = ".NET Core Launch (console) with pipeline";
+            launchRequest.arguments.type = "coreclr";
+            launchRequest.arguments.preLaunchTask = "build";
+            launchRequest.arguments.program = ControlInfo.TargetAssemblyPath;
+            launchRequest.arguments.cwd = "";
+            launchRequest.arguments.console = "internalConsole";
+            launchRequest.arguments.stopAtEntry = true;
+            launchRequest.arguments.internalConsoleOptions = "openOnSessionStart";
+            launchRequest.arguments.__sessionId = Guid.NewGuid().ToString();
+            Assert.True(VSCodeDebugger.Request(launchRequest).Success, @"__FILE__:__LINE__"+"\n"+caller_trace);
+        }
+
+        public void PrepareEnd(string caller_trace)
+        {
+            ConfigurationDoneRequest configurationDoneRequest = new ConfigurationDoneRequest();
+            Assert.True(VSCodeDebugger.Request(configurationDoneRequest).Success, @"__FILE__:__LINE__"+"\n"+caller_trace);
+        }
+
+        public void WasEntryPointHit(string caller_trace)
+        {
+            Func<string, bool> filter = (resJSON) => {
+                if (VSCodeDebugger.isResponseContainProperty(resJSON, "event", "stopped")
+                    && VSCodeDebugger.isResponseContainProperty(resJSON, "reason", "entry")) {
+                    threadId = Convert.ToInt32(VSCodeDebugger.GetResponsePropertyValue(resJSON, "threadId"));
+                    return true;
+                }
+                return false;
+            };
+
+            Assert.True(VSCodeDebugger.IsEventReceived(filter), @"__FILE__:__LINE__"+"\n"+caller_trace);
+        }
+
+        public void WasExit(string caller_trace)
+        {
+            bool wasExited = false;
+            int ?exitCode = null;
+            bool wasTerminated = false;
+
+            Func<string, bool> filter = (resJSON) => {
+                if (VSCodeDebugger.isResponseContainProperty(resJSON, "event", "exited")) {
+                    wasExited = true;
+                    ExitedEvent exitedEvent = JsonConvert.DeserializeObject<ExitedEvent>(resJSON);
+                    exitCode = exitedEvent.body.exitCode;
+                }
+                if (VSCodeDebugger.isResponseContainProperty(resJSON, "event", "terminated")) {
+                    wasTerminated = true;
+                }
+                if (wasExited && exitCode == 0 && wasTerminated)
+                    return true;
+
+                return false;
+            };
+
+            Assert.True(VSCodeDebugger.IsEventReceived(filter), @"__FILE__:__LINE__"+"\n"+caller_trace);
+        }
+
+        public void DebuggerExit(string caller_trace)
+        {
+            DisconnectRequest disconnectRequest = new DisconnectRequest();
+            disconnectRequest.arguments = new DisconnectArguments();
+            disconnectRequest.arguments.restart = false;
+            Assert.True(VSCodeDebugger.Request(disconnectRequest).Success, @"__FILE__:__LINE__"+"\n"+caller_trace);
+        }
+
+        public void AddBreakpoint(string caller_trace, string bpName)
+        {
+            Breakpoint bp = ControlInfo.Breakpoints[bpName];
+            Assert.Equal(BreakpointType.Line, bp.Type, @"__FILE__:__LINE__"+"\n"+caller_trace);
+            var lbp = (LineBreakpoint)bp;
+
+            BreakpointSourceName = lbp.FileName;
+            BreakpointList.Add(new SourceBreakpoint(lbp.NumLine, null));
+            BreakpointLines.Add(lbp.NumLine);
+        }
+
+        public void AddSnapshotBreakpoint(string caller_trace, string bpName, int frames, int depth)
+        {
+            AddBreakpoint(@"__FILE__:__LINE__"+"\n"+caller_trace, bpName);
+            var snapshot = new SnapshotOptions();
+            snapshot.frames = frames;
+            snapshot.depth = depth;
+            snapshot.maxTimeMs = 1000; // don't depend on test environment performance
+            BreakpointList[BreakpointList.Count - 1].snapshot = snapshot;
+        }
+
+        public void SetBreakpoints(string caller_trace)
+        {
+            SetBreakpointsRequest setBreakpointsRequest = new SetBreakpointsRequest();
+            setBreakpointsRequest.arguments.source.name = BreakpointSourceName;
+            // NOTE this code works only with one source file
+            setBreakpointsRequest.arguments.source.path = ControlInfo.SourceFilesPath;
+            setBreakpointsRequest.arguments.lines.AddRange(BreakpointLines);
+            setBreakpointsRequest.arguments.breakpoints.AddRange(BreakpointList);
+            setBreakpointsRequest.arguments.sourceModified = false;
+            Assert.True(VSCodeDebugger.Request(setBreakpointsRequest).Success, @"__FILE__:__LINE__"+"\n"+caller_trace);
+        }
+
+        public void WasBreakpointHit(string caller_trace, string bpName)
+        {
+            Func<string, bool> filter = (resJSON) => {
+                if (VSCodeDebugger.isResponseContainProperty(resJSON, "event", "snapshot")) {
+                    Snapshots.Add(Newtonsoft.Json.Linq.JObject.Parse(resJSON)["body"]);
+                    return false;
+                }
+                if (VSCodeDebugger.isResponseContainProperty(resJSON, "event", "stopped")
+                    && VSCodeDebugger.isResponseContainProperty(resJSON, "reason", "breakpoint")) {
+                    threadId = Convert.ToInt32(VSCodeDebugger.GetResponsePropertyValue(resJSON, "threadId"));
+                    return true;
+                }
+                return false;
+            };
+
+            Assert.True(VSCodeDebugger.IsEventReceived(filter), @"__FILE__:__LINE__"+"\n"+caller_trace);
+
+            StackTraceRequest stackTraceRequest = new StackTraceRequest();
+            stackTraceRequest.arguments.threadId = threadId;
+            stackTraceRequest.arguments.startFrame = 0;
+            stackTraceRequest.arguments.levels = 20;
+            var ret = VSCodeDebugger.Request(stackTraceRequest);
+            Assert.True(ret.Success, @"__FILE__:__LINE__"+"\n"+caller_trace);
+
+            Breakpoint breakpoint = ControlInfo.Breakpoints[bpName];
+            Assert.Equal(BreakpointType.Line, breakpoint.Type, @"__FILE__:__LINE__"+"\n"+caller_trace);
+            var lbp = (LineBreakpoint)breakpoint;
+
+            StackTraceResponse stackTraceResponse =
+                JsonConvert.DeserializeObject<StackTraceResponse>(ret.ResponseStr);
+
+            if (stackTraceResponse.body.stackFrames[0].line == lbp.NumLine
+                && stackTraceResponse.body.stackFrames[0].source.name == lbp.FileName
+                // NOTE this code works only with one source file
+                && stackTraceResponse.body.stackFrames[0].source.path == ControlInfo.SourceFilesPath)
+            {
+                frameId = stackTraceResponse.body.stackFrames[0].id;
+                return;
+            }
+
+            throw new ResultNotSuccessException(@"__FILE__:__LINE__"+"\n"+caller_trace);
+        }
+
+        public Newtonsoft.Json.Linq.JToken FindSnapshotVariable(string caller_trace, Newtonsoft.Json.Linq.JToken snapshotFrame, string name)
+        {
+            foreach (var variable in (Newtonsoft.Json.Linq.JArray)snapshotFrame["variables"]) {
+                if ((string)variable["name"] == name)
+                    return variable;
+            }
+
+            throw new ResultNotSuccessException(@"__FILE__:__LINE__"+"\n"+caller_trace);
+        }
+
+        // Snapshot breakpoint don't stop process, all hits are reported by "snapshot" events before next stop.
+        public void CheckSnapshots(string caller_trace, string bpName, int count)
+        {
+            Assert.Equal(count, Snapshots.Count, @"__FILE__:__LINE__"+"\n"+caller_trace);
+
+            var lbp = (LineBreakpoint)ControlInfo.Breakpoints[bpName];
+            for (int i = 0; i < count; i++)
+            {
+                var snapshot = Snapshots[i];
+                Assert.Equal(threadId, (int)snapshot["threadId"], @"__FILE__:__LINE__"+"\n"+caller_trace);
+                Assert.False((bool)snapshot["truncated"], @"__FILE__:__LINE__"+"\n"+caller_trace);
+
+                var frames = (Newtonsoft.Json.Linq.JArray)snapshot["frames"];
+                Assert.Equal(2, frames.Count, @"__FILE__:__LINE__"+"\n"+caller_trace);
+
+                // Frame ids are not provided, since process was not stopped.
+                var topFrame = frames[0]["frame"];
+                Assert.True(topFrame["id"] == null, @"__FILE__:__LINE__"+"\n"+caller_trace);
+                Assert.Equal(lbp.NumLine, (int)topFrame["line"], @"__FILE__:__LINE__"+"\n"+caller_trace);
+                Assert.True(((string)topFrame["name"]).StartsWith("VSCodeTestSnapshot.Program.Work("), @"__FILE__:__LINE__"+"\n"+caller_trace);
+                Assert.True(((string)frames[1]["frame"]["name"]).StartsWith("VSCodeTestSnapshot.Program.Main("), @"__FILE__:__LINE__"+"\n"+caller_trace);
+
+                // Locals and object fields (depth 1) are captured.
+                Assert.Equal(i.ToString(), (string)FindSnapshotVariable(@"__FILE__:__LINE__"+"\n"+caller_trace, frames[0], "i")["value"], @"__FILE__:__LINE__"+"\n"+caller_trace);
+                Assert.Equal((i * i).ToString(), (string)FindSnapshotVariable(@"__FILE__:__LINE__"+"\n"+caller_trace, frames[0], "square")["value"], @"__FILE__:__LINE__"+"\n"+caller_trace);
+                var field = FindSnapshotVariable(@"__FILE__:__LINE__"+"\n"+caller_trace, frames[0], "data.field");
+                Assert.Equal("42", (string)field["value"], @"__FILE__:__LINE__"+"\n"+caller_trace);
+                Assert.Equal("int", (string)field["type"], @"__FILE__:__LINE__"+"\n"+caller_trace);
+                Assert.Equal("\"abc\"", (string)FindSnapshotVariable(@"__FILE__:__LINE__"+"\n"+caller_trace, frames[0], "data.text")["value"], @"__FILE__:__LINE__"+"\n"+caller_trace);
+            }
+        }
+
+        public void Continue(string caller_trace)
+        {
+            ContinueRequest continueRequest = new ContinueRequest();
+            continueRequest.arguments.threadId = threadId;
+            Assert.True(VSCodeDebugger.Request(continueRequest).Success, @"__FILE__:__LINE__"+"\n"+caller_trace);
+        }
+
+        public Context(ControlInfo controlInfo, NetcoreDbgTestCore.DebuggerClient debuggerClient)
+        {
+            ControlInfo = controlInfo;
+            VSCodeDebugger = new VSCodeDebugger(debuggerClient);
+        }
+
+        ControlInfo ControlInfo;
+        VSCodeDebugger VSCodeDebugger;
+        int threadId = -1;
+        Int64 frameId = -1;
+        // NOTE this code works only with one source file
+        string BreakpointSourceName;
+        List<SourceBreakpoint> BreakpointList = new List<SourceBreakpoint>();
+        List<int> BreakpointLines = new List<int>();
+        List<Newtonsoft.Json.Linq.JToken> Snapshots = new List<Newtonsoft.Json.Linq.JToken>();
+    }
+}
+
+namespace VSCodeTestSnapshot
+{
+    class Data
+    {
+        public int field = 42;
+        public string text = "abc";
+    }
+
+    class Program
+    {
+        static int Work(int i, Data data)
+        {
+            int square = i * i;
+            int result = square + data.field;                           Label.Breakpoint("bp_snapshot");
+            return result;
+        }
+
+        static void Main(string[] args)
+        {
+            Label.Checkpoint("init", "bp_test", (Object context) => {
+                Context Context = (Context)context;
+                Context.PrepareStart(@"__FILE__:__LINE__");
+                Context.AddSnapshotBreakpoint(@"__FILE__:__LINE__", "bp_snapshot", 2, 1);
+                Context.AddBreakpoint(@"__FILE__:__LINE__", "bp");
+                Context.SetBreakpoints(@"__FILE__:__LINE__");
+                Context.PrepareEnd(@"__FILE__:__LINE__");
+                Context.WasEntryPointHit(@"__FILE__:__LINE__");
+                Context.Continue(@"__FILE__:__LINE__");
+            });
+
+            Data data = new Data();
+            int sum = 0;
+            for (int i = 0; i < 3; i++)
+                sum += Work(i, data);
+
+            Console.WriteLine(sum);                                     Label.Breakpoint("bp");
+
+            Label.Checkpoint("bp_test", "finish", (Object context) => {
+                Context Context = (Context)context;
+                // First stop after continue must be regular breakpoint, snapshot breakpoint don't stop process.
+                Context.WasBreakpointHit(@"__FILE__:__LINE__", "bp");
+                Context.CheckSnapshots(@"__FILE__:__LINE__", "bp_snapshot", 3);
+                Context.Continue(@"__FILE__:__LINE__");
+            });
+
+            Label.Checkpoint("finish", "", (Object context) => {
+                Context Context = (Context)context;
+                Context.WasExit(@"__FILE__:__LINE__");
+                Context.DebuggerExit(@"__FILE__:__LINE__");
+            });
+        }
+    }
+}
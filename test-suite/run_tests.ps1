@@ -66,6 +66,14 @@ $ALL_TEST_NAMES = @(
     "VSCodeTestGeneric"
     "VSCodeTestEvalArraysIndexers"
     "VSCodeTestBreakpointWithoutStop"
+    "VSCodeTestReadMemory"
+    "VSCodeTestCollections"
+    "VSCodeTestSampling"
+    "VSCodeTestSnapshot"
+    "VSCodeTestLongStrings"
+    "VSCodeTestLazyProperties"
+    "VSCodeTestChangedValues"
+    "VSCodeTestThreadsStackTrace"
 )
 
 # Skipped tests:
@@ -75,10 +75,19 @@ ALL_TEST_NAMES=(
     "VSCodeTestGeneric"
     "VSCodeTestEvalArraysIndexers"
     "VSCodeTestBreakpointWithoutStop"
+    "VSCodeTestReadMemory"
+    "VSCodeTestCollections"
+    "VSCodeTestSampling"
+    "VSCodeTestSnapshot"
+    "VSCodeTestLongStrings"
+    "VSCodeTestLazyProperties"
+    "VSCodeTestChangedValues"
+    "VSCodeTestThreadsStackTrace"
 )
 
 # Skipped tests:
 # VSCodeTest297killNCD --- is not automated enough. For manual run only.
+# VSCodeBenchStepping --- stepping latency benchmark. For manual run only.
 for i in "$@"
 do
 case $i in